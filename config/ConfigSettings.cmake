@@ -39,6 +39,7 @@ basis_get_fully_qualified_target_uid (BASH_UTILITIES_LIBRARY_CONFIG   "${BASIS_B
 
 basis_get_fully_qualified_target_uid (TEST_LIBRARY_CONFIG      "${BASIS_TEST_LIBRARY}")
 basis_get_fully_qualified_target_uid (TEST_MAIN_LIBRARY_CONFIG "${BASIS_TEST_MAIN_LIBRARY}")
+basis_get_fully_qualified_target_uid (BENCHMARK_LIBRARY_CONFIG "${BASIS_BENCHMARK_LIBRARY}")
 
 # the following set() statements are simply used to document the variables
 # note that this documentation is included in the Doxygen generated documentation
@@ -60,6 +61,8 @@ set (BASH_UTILITIES_LIBRARY_CONFIG   "${BASH_UTILITIES_LIBRARY_CONFIG}")
 set (TEST_LIBRARY_CONFIG "${TEST_LIBRARY_CONFIG}")
 ## @brief Name of C++ unit testing library with definition of main() function.
 set (TEST_MAIN_LIBRARY_CONFIG "${TEST_MAIN_LIBRARY_CONFIG}")
+## @brief Name of C++ benchmark library including default main() function.
+set (BENCHMARK_LIBRARY_CONFIG "${BENCHMARK_LIBRARY_CONFIG}")
 
 # ============================================================================
 # build tree configuration settings
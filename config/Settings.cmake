@@ -148,6 +148,7 @@ set (BASIS_PERL_UTILITIES_LIBRARY   "${NS}utilities_perl")
 set (BASIS_BASH_UTILITIES_LIBRARY   "${NS}utilities_bash")
 set (BASIS_TEST_LIBRARY             "${NS}testlib")
 set (BASIS_TEST_MAIN_LIBRARY        "${NS}testmain")
+set (BASIS_BENCHMARK_LIBRARY        "${NS}benchmarklib")
 
 # ============================================================================
 # configure public header files
@@ -28,6 +28,7 @@
 
 #include "ValueArg.h"
 #include "MultiArg.h"
+#include "ListArg.h"
 
 #include "tclap/Constraint.h"
 
@@ -104,6 +105,31 @@ typedef basis::MultiArg<int> MultiIntArg;
 /// Alias for MultiUInt32Arg.
 typedef basis::MultiArg<unsigned int> MultiUIntArg;
 
+// ---------------------------------------------------------------------------
+// list of values option
+
+// Note: Use full namespace on the left side to help Doxygen to create
+//       the proper references to the BASIS ListArg class.
+
+/// String argument (comma or whitespace separated list of values).
+typedef basis::ListArg<std::string> ListStringArg;
+/// Signed 32-bit integer argument (comma or whitespace separated list of values).
+typedef basis::ListArg<int> ListInt32Arg;
+/// Unsigned 32-bit integer argument (comma or whitespace separated list of values).
+typedef basis::ListArg<unsigned int> ListUInt32Arg;
+/// Signed 64-bit integer argument (comma or whitespace separated list of values).
+typedef basis::ListArg<long> ListInt64Arg;
+/// Unsigned 64-bit integer argument (comma or whitespace separated list of values).
+typedef basis::ListArg<unsigned long> ListUInt64Arg;
+/// Floating-point argument (comma or whitespace separated list of values).
+typedef basis::ListArg<float> ListFloatArg;
+/// Floating-point argument (double precision, comma or whitespace separated list of values).
+typedef basis::ListArg<double> ListDoubleArg;
+/// Alias for ListInt32Arg.
+typedef basis::ListArg<int> ListIntArg;
+/// Alias for ListUInt32Arg.
+typedef basis::ListArg<unsigned int> ListUIntArg;
+
 // ---------------------------------------------------------------------------
 // positional arguments
 
@@ -218,11 +218,54 @@ public:
     /**
      * @brief Parses the command line.
      *
+     * Unless disabled using setExpandResponseFiles(), each argument of the
+     * form \@file preceding a "--" argument is replaced by the arguments read
+     * from the named response file. The arguments in this file are separated
+     * by whitespace and quoted as described for basis::Subprocess::split().
+     * Response files may refer to other response files.
+     *
      * @param [in] args A vector of strings representing the args. 
      *                  args[0] is still the program name.
      */
     void parse(std::vector<std::string>& args);
 
+    /**
+     * @brief Enable/disable expansion of \@file arguments.
+     *
+     * @param [in] expand Whether to read arguments from response files.
+     */
+    void setExpandResponseFiles(bool expand) { _expandResponseFiles = expand; }
+
+    /**
+     * @brief Whether \@file arguments are expanded.
+     */
+    bool getExpandResponseFiles() const { return _expandResponseFiles; }
+
+    // -----------------------------------------------------------------------
+    // schema
+public:
+
+    /// Formats of machine-readable description of command-line interface.
+    enum SchemaFormat
+    {
+        SCHEMA_XML, ///< XML document.
+        SCHEMA_JSON ///< JSON object.
+    };
+
+    /**
+     * @brief Write machine-readable description of command-line interface.
+     *
+     * The description lists the program name, project, version, and the
+     * properties of each argument such as its name, flag, type description,
+     * and whether it is required. This is the output of the standard
+     * --helpxml and --helpjson arguments, but this function neither parses
+     * the command-line nor exits the program.
+     *
+     * @param [out] os     Output stream.
+     * @param [in]  format Output format.
+     */
+    void serialize(std::ostream& os, SchemaFormat format = SCHEMA_XML);
+
     // -----------------------------------------------------------------------
     // accessors
 public:
@@ -301,13 +344,14 @@ private:
     // member variables
 protected:
 
-    XorHandler               _xorHandler; ///< Customized XorHandler.
-    std::string              _name;       ///< Program name.
-    std::string              _project;    ///< Name of project.
-    std::vector<std::string> _examples;   ///< Program usage example.
-    std::string              _copyright;  ///< Program copyright.
-    std::string              _license;    ///< Program license.
-    std::string              _contact;    ///< Contact information.
+    XorHandler               _xorHandler;          ///< Customized XorHandler.
+    std::string              _name;                ///< Program name.
+    std::string              _project;             ///< Name of project.
+    std::vector<std::string> _examples;            ///< Program usage example.
+    std::string              _copyright;           ///< Program copyright.
+    std::string              _license;             ///< Program license.
+    std::string              _contact;             ///< Contact information.
+    bool                     _expandResponseFiles; ///< Whether to read \@file arguments.
 
 }; // class CmdLine
 
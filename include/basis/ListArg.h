@@ -0,0 +1,458 @@
+// ===========================================================================
+// Copyright (c) 2011-2012 University of Pennsylvania
+// Copyright (c) 2013-2016 Andreas Schuh
+// All rights reserved.
+//
+// See COPYING file for license information or visit
+// https://cmake-basis.github.io/download.html#license
+// ===========================================================================
+
+/**
+ * @file  basis/ListArg.h
+ * @brief MultiArg which reads a list of values from a single argument.
+ *
+ * Large arrays of values such as point coordinates are more conveniently
+ * and efficiently given as one comma or whitespace separated list, e.g.,
+ * "--points 1,2,3,4,5,6", than by repeating the option for each value.
+ */
+
+#pragma once
+#ifndef _BASIS_LISTARG_H
+#define _BASIS_LISTARG_H
+
+
+#include <algorithm> // max
+
+#include "MultiArg.h"
+
+
+namespace basis {
+
+
+/**
+ * @brief An argument whose values are given as a comma or whitespace
+ *        separated list.
+ *
+ * Each occurrence of this argument on the command-line consumes exactly one
+ * argument which is split into values at commas and whitespace characters.
+ * If the argument may be given more than once, the values of all occurrences
+ * are appended to one vector. The number of values per occurrence can
+ * optionally be fixed at construction time.
+ *
+ * The values are parsed directly into the contiguous storage returned by
+ * getValue(). Space for the given number of values is reserved upfront and
+ * for each list before its values are parsed. Use moveValue() to take
+ * ownership of the parsed values without copying them.
+ *
+ * @ingroup CxxCmdLine
+ */
+template <class T>
+class ListArg : public MultiArg<T>
+{
+    // -----------------------------------------------------------------------
+    // construction / destruction
+public:
+
+    /**
+     * @brief Constructor.
+     *
+     * @param [in] flag       The one character flag that identifies this
+     *                        argument on the command line.
+     * @param [in] name       A one word name for the argument.  Can be
+     *                        used as a long flag on the command line.
+     * @param [in] desc       A description of what the argument is for or does.
+     * @param [in] req        Whether the argument is required on the command-line.
+     * @param [in] typeDesc   A short, human readable description of the
+     *                        type that this object expects.  This is used in
+     *                        the generation of the USAGE statement. The goal
+     *                        is to be helpful to the end user of the program.
+     * @param [in] n          Number of values per argument occurrence or 0
+     *                        if the list may be of any length.
+     * @param [in] reserve    Expected total number of values.
+     * @param [in] once       Accept argument only once.
+     * @param [in] v          An optional visitor. You probably should not
+     *                        use this unless you have a very good reason.
+     */
+    ListArg(const std::string& flag,
+            const std::string& name,
+            const std::string& desc,
+            bool               req,
+            const std::string& typeDesc,
+            unsigned int       n       = 0,
+            size_t             reserve = 0,
+            bool               once    = false,
+            TCLAP::Visitor*    v       = NULL);
+
+    /**
+     * @brief Constructor.
+     *
+     * @param [in] flag       The one character flag that identifies this
+     *                        argument on the command line.
+     * @param [in] name       A one word name for the argument.  Can be
+     *                        used as a long flag on the command line.
+     * @param [in] desc       A description of what the argument is for or does.
+     * @param [in] req        Whether the argument is required on the command-line.
+     * @param [in] typeDesc   A short, human readable description of the
+     *                        type that this object expects.  This is used in
+     *                        the generation of the USAGE statement. The goal
+     *                        is to be helpful to the end user of the program.
+     * @param [in] parser     A CmdLine parser object to add this Arg to
+     * @param [in] n          Number of values per argument occurrence or 0
+     *                        if the list may be of any length.
+     * @param [in] reserve    Expected total number of values.
+     * @param [in] once       Accept argument only once.
+     * @param [in] v          An optional visitor. You probably should not
+     *                        use this unless you have a very good reason.
+     */
+    ListArg(const std::string&       flag,
+            const std::string&       name,
+            const std::string&       desc,
+            bool                     req,
+            const std::string&       typeDesc,
+            TCLAP::CmdLineInterface& parser,
+            unsigned int             n       = 0,
+            size_t                   reserve = 0,
+            bool                     once    = false,
+            TCLAP::Visitor*          v       = NULL);
+
+    /**
+     * @brief Constructor.
+     *
+     * @param [in] flag       The one character flag that identifies this
+     *                        argument on the command line.
+     * @param [in] name       A one word name for the argument.  Can be
+     *                        used as a long flag on the command line.
+     * @param [in] desc       A description of what the argument is for or does.
+     * @param [in] req        Whether the argument is required on the command-line.
+     * @param [in] constraint A pointer to a Constraint object used
+     *                        to constrain this Arg.
+     * @param [in] n          Number of values per argument occurrence or 0
+     *                        if the list may be of any length.
+     * @param [in] reserve    Expected total number of values.
+     * @param [in] once       Accept argument only once.
+     * @param [in] v          An optional visitor. You probably should not
+     *                        use this unless you have a very good reason.
+     */
+    ListArg(const std::string&    flag,
+            const std::string&    name,
+            const std::string&    desc,
+            bool                  req,
+            TCLAP::Constraint<T>* constraint,
+            unsigned int          n       = 0,
+            size_t                reserve = 0,
+            bool                  once    = false,
+            TCLAP::Visitor*       v       = NULL);
+
+    /**
+     * @brief Constructor.
+     *
+     * @param [in] flag       The one character flag that identifies this
+     *                        argument on the command line.
+     * @param [in] name       A one word name for the argument.  Can be
+     *                        used as a long flag on the command line.
+     * @param [in] desc       A description of what the argument is for or does.
+     * @param [in] req        Whether the argument is required on the command-line.
+     * @param [in] constraint A pointer to a Constraint object used
+     *                        to constrain this Arg.
+     * @param [in] parser     A CmdLine parser object to add this Arg to.
+     * @param [in] n          Number of values per argument occurrence or 0
+     *                        if the list may be of any length.
+     * @param [in] reserve    Expected total number of values.
+     * @param [in] once       Accept argument only once.
+     * @param [in] v          An optional visitor. You probably should not
+     *                        use this unless you have a very good reason.
+     */
+    ListArg(const std::string&       flag,
+            const std::string&       name,
+            const std::string&       desc,
+            bool                     req,
+            TCLAP::Constraint<T>*    constraint,
+            TCLAP::CmdLineInterface& parser,
+            unsigned int             n       = 0,
+            size_t                   reserve = 0,
+            bool                     once    = false,
+            TCLAP::Visitor*          v       = NULL);
+
+    // -----------------------------------------------------------------------
+    // parsing
+public:
+
+    /**
+     * @brief Handles the processing of the argument.
+     *
+     * @param [in, out] i    Pointer to the current argument in the list.
+     * @param [in, out] args Mutable list of strings. Passed from main().
+     */
+    virtual bool processArg(int* i, std::vector<std::string>& args);
+
+    /**
+     * @brief Clears the values and reserves space for the expected number
+     *        of values again.
+     */
+    virtual void reset();
+
+    // -----------------------------------------------------------------------
+    // values
+public:
+
+    /**
+     * @brief Move parsed values into the given vector.
+     *
+     * The previous contents of @p values are discarded. The values of
+     * this argument are empty afterwards.
+     *
+     * @param [out] values Vector which takes ownership of the values.
+     */
+    void moveValue(std::vector<T>& values);
+
+    // -----------------------------------------------------------------------
+    // helpers
+protected:
+
+    /**
+     * @brief Parse comma or whitespace separated list of values.
+     *
+     * @param [in] list List of values.
+     *
+     * @returns Number of values appended to the vector of values.
+     */
+    size_t _extractValues(const std::string& list);
+
+    /**
+     * @brief Whether a character separates two values of a list.
+     */
+    static bool _isSeparator(char c);
+
+    /**
+     * @brief Index of first non-whitespace character at or after @p pos.
+     */
+    static std::string::size_type _skipWhitespace(const std::string& list,
+                                                  std::string::size_type pos);
+
+    // -----------------------------------------------------------------------
+    // unsupported
+private:
+
+    ListArg<T>(const ListArg<T>&);            ///< Not implemented.
+    ListArg<T>& operator=(const ListArg<T>&); ///< Not implemented.
+
+    // -----------------------------------------------------------------------
+    // member variables
+protected:
+
+    size_t _reserve; ///< Expected total number of values.
+
+}; // class ListArg
+
+
+// ===========================================================================
+// template definitions
+// ===========================================================================
+
+// ---------------------------------------------------------------------------
+template <class T>
+ListArg<T>::ListArg(const std::string& flag,
+                    const std::string& name,
+                    const std::string& desc,
+                    bool req,
+                    const std::string& typeDesc,
+                    unsigned int n,
+                    size_t reserve,
+                    bool once,
+                    TCLAP::Visitor* v)
+:
+    MultiArg<T>(flag, name, desc, req, typeDesc, n, once, v),
+    _reserve(reserve)
+{
+    TCLAP::MultiArg<T>::_values.reserve(_reserve);
+}
+
+// ---------------------------------------------------------------------------
+template <class T>
+ListArg<T>::ListArg(const std::string& flag,
+                    const std::string& name,
+                    const std::string& desc,
+                    bool req,
+                    const std::string& typeDesc,
+                    TCLAP::CmdLineInterface& parser,
+                    unsigned int n,
+                    size_t reserve,
+                    bool once,
+                    TCLAP::Visitor* v)
+:
+    MultiArg<T>(flag, name, desc, req, typeDesc, parser, n, once, v),
+    _reserve(reserve)
+{
+    TCLAP::MultiArg<T>::_values.reserve(_reserve);
+}
+
+// ---------------------------------------------------------------------------
+template <class T>
+ListArg<T>::ListArg(const std::string& flag,
+                    const std::string& name,
+                    const std::string& desc,
+                    bool req,
+                    TCLAP::Constraint<T>* constraint,
+                    unsigned int n,
+                    size_t reserve,
+                    bool once,
+                    TCLAP::Visitor* v)
+:
+    MultiArg<T>(flag, name, desc, req, constraint, n, once, v),
+    _reserve(reserve)
+{
+    TCLAP::MultiArg<T>::_values.reserve(_reserve);
+}
+
+// ---------------------------------------------------------------------------
+template <class T>
+ListArg<T>::ListArg(const std::string& flag,
+                    const std::string& name,
+                    const std::string& desc,
+                    bool req,
+                    TCLAP::Constraint<T>* constraint,
+                    TCLAP::CmdLineInterface& parser,
+                    unsigned int n,
+                    size_t reserve,
+                    bool once,
+                    TCLAP::Visitor* v)
+:
+    MultiArg<T>(flag, name, desc, req, constraint, parser, n, once, v),
+    _reserve(reserve)
+{
+    TCLAP::MultiArg<T>::_values.reserve(_reserve);
+}
+
+// ---------------------------------------------------------------------------
+template <class T>
+bool ListArg<T>::processArg(int* i, std::vector<std::string>& args)
+{
+    if (TCLAP::MultiArg<T>::_ignoreable && TCLAP::Arg::ignoreRest()) {
+        return false;
+    }
+    if (TCLAP::MultiArg<T>::_hasBlanks(args[*i])) return false;
+    std::string value;
+    if (!TCLAP::MultiArg<T>::matchesFlag(args[*i], value)) return false;
+    if (TCLAP::Arg::delimiter() != ' ' && value == "") {
+        throw TCLAP::ArgParseException(
+                "Couldn't find delimiter for this argument!",
+                TCLAP::MultiArg<T>::toString());
+    }
+    if (TCLAP::MultiArg<T>::_alreadySet &&
+            !TCLAP::MultiArg<T>::_acceptsMultipleValues) {
+        throw TCLAP::CmdLineParseException("Argument already set!",
+                                           TCLAP::MultiArg<T>::toString());
+    }
+    size_t n;
+    if (value == "") {
+        (*i)++;
+        if (static_cast<unsigned int>(*i) >= args.size()) {
+            throw TCLAP::ArgParseException(
+                    "Missing a value for this argument!",
+                    TCLAP::MultiArg<T>::toString());
+        }
+        n = _extractValues(args[*i]);
+    } else {
+        n = _extractValues(value);
+    }
+    if (MultiArg<T>::_numberOfArguments > 0 && n != MultiArg<T>::_numberOfArguments) {
+        throw TCLAP::ArgParseException(
+                n < MultiArg<T>::_numberOfArguments ? "Too few values for this argument!"
+                                                    : "Too many values for this argument!",
+                TCLAP::MultiArg<T>::toString());
+    }
+    TCLAP::MultiArg<T>::_alreadySet = true;
+    TCLAP::MultiArg<T>::_allowMore  = false;
+    TCLAP::MultiArg<T>::_checkWithVisitor();
+    return true;
+}
+
+// ---------------------------------------------------------------------------
+template <class T>
+void ListArg<T>::reset()
+{
+    MultiArg<T>::reset();
+    TCLAP::MultiArg<T>::_values.reserve(_reserve);
+}
+
+// ---------------------------------------------------------------------------
+template <class T>
+void ListArg<T>::moveValue(std::vector<T>& values)
+{
+    values.clear();
+    values.swap(TCLAP::MultiArg<T>::_values);
+}
+
+// ---------------------------------------------------------------------------
+template <class T>
+size_t ListArg<T>::_extractValues(const std::string& list)
+{
+    std::vector<T>& values = TCLAP::MultiArg<T>::_values;
+    const std::string::size_type len = list.size();
+    // count values such that storage is grown at most once per list,
+    // growing it geometrically to keep repeated occurrences linear
+    size_t n = 0;
+    for (std::string::size_type pos = 0; pos < len; pos++) {
+        if (!_isSeparator(list[pos]) && (pos == 0 || _isSeparator(list[pos - 1]))) n++;
+    }
+    if (values.capacity() < values.size() + n) {
+        values.reserve(std::max(2 * values.capacity(), values.size() + n));
+    }
+    // parse values directly into storage
+    const size_t size = values.size();
+    std::string value;
+    std::string::size_type pos = _skipWhitespace(list, 0);
+    while (pos < len) {
+        std::string::size_type end = pos;
+        while (end < len && !_isSeparator(list[end])) end++;
+        if (end == pos) {
+            throw TCLAP::ArgParseException("Missing value in list '" + list + "'",
+                                           TCLAP::MultiArg<T>::toString());
+        }
+        value.assign(list, pos, end - pos);
+        values.push_back(T());
+        try {
+            TCLAP::ExtractValue(values.back(), value, typename TCLAP::ArgTraits<T>::ValueCategory());
+        } catch (TCLAP::ArgParseException& e) {
+            throw TCLAP::ArgParseException(e.error(), TCLAP::MultiArg<T>::toString());
+        }
+        if (TCLAP::MultiArg<T>::_constraint != NULL &&
+                !TCLAP::MultiArg<T>::_constraint->check(values.back())) {
+            throw TCLAP::CmdLineParseException("Value '" + value
+                    + "' does not meet constraint: "
+                    + TCLAP::MultiArg<T>::_constraint->description(),
+                    TCLAP::MultiArg<T>::toString());
+        }
+        // values are separated by whitespace and/or a single comma
+        pos = _skipWhitespace(list, end);
+        if (pos < len && list[pos] == ',') {
+            pos = _skipWhitespace(list, pos + 1);
+            if (pos == len) {
+                throw TCLAP::ArgParseException("Missing value in list '" + list + "'",
+                                               TCLAP::MultiArg<T>::toString());
+            }
+        }
+    }
+    return values.size() - size;
+}
+
+// ---------------------------------------------------------------------------
+template <class T>
+inline bool ListArg<T>::_isSeparator(char c)
+{
+    return c == ',' || c == ' ' || c == '\t' || c == '\n' || c == '\r';
+}
+
+// ---------------------------------------------------------------------------
+template <class T>
+inline std::string::size_type ListArg<T>::_skipWhitespace(const std::string& list,
+                                                          std::string::size_type pos)
+{
+    while (pos < list.size() && list[pos] != ',' && _isSeparator(list[pos])) pos++;
+    return pos;
+}
+
+} // namespace basis
+
+
+#endif // _BASIS_LISTARG_H
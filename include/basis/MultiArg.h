@@ -281,10 +281,8 @@ bool MultiArg<T>::processArg(int *i, std::vector<std::string>& args)
     }
     if (TCLAP::MultiArg<T>::_hasBlanks( args[*i] )) return false;
     // separate flag and value if delimiter is not ' '
-    std::string flag = args[*i];
-    std::string value = "";
-    TCLAP::MultiArg<T>::trimFlag(flag, value);
-    if (!TCLAP::MultiArg<T>::argMatches(flag)) return false;
+    std::string value;
+    if (!TCLAP::MultiArg<T>::matchesFlag(args[*i], value)) return false;
     // check if delimiter was found
     if (TCLAP::Arg::delimiter() != ' ' && value == "") {
         throw TCLAP::ArgParseException( 
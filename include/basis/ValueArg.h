@@ -274,12 +274,8 @@ bool ValueArg<T>::processArg(int* i, std::vector<std::string>& args)
     if (TCLAP::ValueArg<T>::_ignoreable && TCLAP::ValueArg<T>::ignoreRest()) return false;
     if (TCLAP::ValueArg<T>::_hasBlanks(args[*i])) return false;
 
-    std::string flag = args[*i];
-
-    std::string value = "";
-    TCLAP::ValueArg<T>::trimFlag(flag, value);
-
-    if (TCLAP::ValueArg<T>::argMatches(flag)) {
+    std::string value;
+    if (TCLAP::ValueArg<T>::matchesFlag(args[*i], value)) {
         if (!_allowOverwrite && TCLAP::ValueArg<T>::_alreadySet) {
             if (TCLAP::ValueArg<T>::_xorSet) {
                 throw TCLAP::CmdLineParseException("Mutually exclusive argument already set!",
@@ -0,0 +1,212 @@
+// ===========================================================================
+// Copyright (c) 2011-2012 University of Pennsylvania
+// Copyright (c) 2013-2016 Andreas Schuh
+// All rights reserved.
+//
+// See COPYING file for license information or visit
+// https://cmake-basis.github.io/download.html#license
+// ===========================================================================
+
+/**
+ * @file  benchmark.h
+ * @brief Main include file of C++ microbenchmark framework.
+ *
+ * This file should be included by implementations of benchmarks which are
+ * added using the basis_add_benchmark() CMake function. A benchmark is
+ * defined similar to a Google Test, where the body of the benchmark is
+ * the code of which the execution time is measured:
+ * @code
+ * #include <basis/benchmark.h>
+ *
+ * BENCHMARK(Path, normpath)
+ * {
+ *     basis::benchmark::keep(basis::os::path::normpath("/usr/./local/../bin"));
+ * }
+ *
+ * class LongPath : public basis::benchmark::Benchmark
+ * {
+ * protected:
+ *     virtual void SetUp() { path = ...; }
+ *     std::string path;
+ * };
+ *
+ * BENCHMARK_F(LongPath, normpath)
+ * {
+ *     basis::benchmark::keep(basis::os::path::normpath(path));
+ * }
+ * @endcode
+ *
+ * The body of a benchmark is executed repeatedly. The number of iterations
+ * of each timed repetition is chosen such that a repetition takes at least
+ * the minimum time set by --benchmark_min_time. After warm-up repetitions,
+ * the median and median absolute deviation (MAD) of the time per iteration
+ * of the timed repetitions are reported. If a baseline file written by a
+ * previous run with --benchmark_output is given, the benchmark fails when
+ * its median time exceeds the baseline median by more than the threshold
+ * ratio set by --benchmark_threshold.
+ *
+ * @ingroup CxxTesting
+ */
+
+#pragma once
+#ifndef _BASIS_BENCHMARK_H
+#define _BASIS_BENCHMARK_H
+
+
+#include <basis/config.h>
+
+#include <string>
+
+
+namespace basis { namespace benchmark {
+
+
+// ===========================================================================
+// benchmark fixture
+// ===========================================================================
+
+/**
+ * @brief Base class of benchmark fixtures.
+ *
+ * SetUp() is called once before the benchmark is run and TearDown() once
+ * after all repetitions of the benchmark are done. The body of the benchmark
+ * must therefore leave the fixture in a state which allows its repeated
+ * execution.
+ */
+class Benchmark
+{
+public:
+
+    /// Destructor.
+    virtual ~Benchmark() {}
+
+    /// Prepare fixture before the benchmark is run.
+    virtual void SetUp() {}
+
+    /// Clean up fixture after the benchmark was run.
+    virtual void TearDown() {}
+
+    /// Execute one iteration of the benchmark.
+    virtual void Run() = 0;
+};
+
+/// Type of function which creates a new instance of a benchmark.
+typedef Benchmark* (*BenchmarkFactory)();
+
+// ===========================================================================
+// statistics
+// ===========================================================================
+
+/**
+ * @brief Time per iteration of a benchmark in nanoseconds.
+ */
+struct Statistics
+{
+    std::string name;        ///< Full name of benchmark, i.e., "<fixture>.<name>".
+    double      median;      ///< Median time of timed repetitions.
+    double      mad;         ///< Median absolute deviation from median time.
+    double      min;         ///< Minimum time of timed repetitions.
+    double      max;         ///< Maximum time of timed repetitions.
+    int         repetitions; ///< Number of timed repetitions.
+    long        iterations;  ///< Number of iterations per repetition.
+};
+
+// ===========================================================================
+// functions
+// ===========================================================================
+
+/**
+ * @brief Register benchmark.
+ *
+ * This function is used by the BENCHMARK and BENCHMARK_F macros and
+ * need not be called directly.
+ *
+ * @param [in] fixture Name of benchmark fixture.
+ * @param [in] name    Name of benchmark.
+ * @param [in] factory Function which creates an instance of the benchmark.
+ *
+ * @returns Always true.
+ */
+bool register_benchmark(const char* fixture, const char* name, BenchmarkFactory factory);
+
+/**
+ * @brief Prevent the compiler from optimizing away the computation of a value.
+ *
+ * @param [in] value Result of benchmarked code.
+ */
+void keep_pointer(const volatile void* value);
+
+/**
+ * @brief Prevent the compiler from optimizing away the computation of a value.
+ *
+ * @param [in] value Result of benchmarked code.
+ */
+template <typename T>
+inline void keep(const T& value)
+{
+    keep_pointer(&value);
+}
+
+/**
+ * @brief Run registered benchmarks.
+ *
+ * This function is called by the default main() function of benchmarks.
+ * Custom implementations of main() should call it after their own setup.
+ *
+ * @param [in] argc Number of command-line arguments.
+ * @param [in] argv Command-line arguments.
+ *
+ * @returns Exit code of benchmark executable.
+ * @retval 0 If all benchmarks succeeded and none exceeded its baseline time.
+ */
+int run(int argc, char* argv[]);
+
+
+} } // namespace basis::benchmark
+
+
+// ===========================================================================
+// macros
+// ===========================================================================
+
+/// @brief Name of class which implements a benchmark.
+#define BASIS_BENCHMARK_CLASS_NAME_(fixture, name) fixture##_##name##_Benchmark
+
+/// @brief Define and register class which implements a benchmark.
+#define BASIS_BENCHMARK_(fixture, name, parent)                                  \
+    class BASIS_BENCHMARK_CLASS_NAME_(fixture, name) : public parent            \
+    {                                                                           \
+    public:                                                                     \
+        static ::basis::benchmark::Benchmark* Create()                          \
+        {                                                                       \
+            return new BASIS_BENCHMARK_CLASS_NAME_(fixture, name);              \
+        }                                                                       \
+    private:                                                                    \
+        virtual void Run();                                                     \
+        static const bool _registered;                                          \
+    };                                                                          \
+    const bool BASIS_BENCHMARK_CLASS_NAME_(fixture, name)::_registered =        \
+        ::basis::benchmark::register_benchmark(#fixture, #name,                 \
+                &BASIS_BENCHMARK_CLASS_NAME_(fixture, name)::Create);           \
+    void BASIS_BENCHMARK_CLASS_NAME_(fixture, name)::Run()
+
+/**
+ * @brief Define benchmark without fixture.
+ *
+ * @param [in] group Name of group of benchmarks.
+ * @param [in] name  Name of benchmark.
+ */
+#define BENCHMARK(group, name) \
+    BASIS_BENCHMARK_(group, name, ::basis::benchmark::Benchmark)
+
+/**
+ * @brief Define benchmark which uses a fixture.
+ *
+ * @param [in] fixture Name of fixture class derived from basis::benchmark::Benchmark.
+ * @param [in] name    Name of benchmark.
+ */
+#define BENCHMARK_F(fixture, name) \
+    BASIS_BENCHMARK_(fixture, name, fixture)
+
+
+#endif // _BASIS_BENCHMARK_H
@@ -36,6 +36,17 @@ namespace basis { namespace os {
  */
 std::string getcwd();
 
+/**
+ * @brief Change the (current) working directory.
+ *
+ * @param [in] path Path of the new working directory.
+ *
+ * @returns Whether the working directory was changed successfully.
+ *
+ * @sa getcwd()
+ */
+bool chdir(const std::string& path);
+
 /**
  * @brief Get canonical path of executable file.
  *
@@ -71,6 +71,8 @@ int get_terminal_columns();
  *                     Set to a value less or equal to disable automatic wrapping.
  * @param [in]  indent Indent of text on each line.
  * @param [in]  offset Additional indent of all lines except the first one.
+ *
+ * @note The output stream is not flushed.
  */
 std::ostream& print_wrapped(std::ostream&      os,
                             const std::string& text,
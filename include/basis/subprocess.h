@@ -21,6 +21,8 @@
 
 #include <vector>
 #include <string>
+#include <iosfwd>
+#include <cstddef> // size_t
 
 #if WINDOWS
 #  include <windows.h>
@@ -46,8 +48,6 @@ public:
     typedef std::vector<std::string> CommandLine;
     typedef std::vector<std::string> Environment;
 
-private:
-
     /// Type used for file handles of pipes between processes.
 #if WINDOWS
     typedef HANDLE PipeHandle;
@@ -55,6 +55,8 @@ private:
     typedef int    PipeHandle;
 #endif
 
+private:
+
     /// Information structure required by system to identify subprocess.
 #if WINDOWS
     typedef PROCESS_INFORMATION Information;
@@ -74,9 +76,11 @@ public:
      */
     enum RedirectMode
     {
-        RM_NONE,  ///< Do not redirect the input/output.
-        RM_PIPE,  ///< Use a pipe to redirect the input/output from/to the parent.
-        RM_STDOUT ///< Redirect stderr to stdout.
+        RM_NONE,   ///< Do not redirect the input/output.
+        RM_PIPE,   ///< Use a pipe to redirect the input/output from/to the parent.
+        RM_STDOUT, ///< Redirect stderr to stdout.
+        RM_FILE,   ///< Redirect the input/output from/to the file set before.
+        RM_DEVNULL ///< Redirect the input/output from/to the null device.
     };
 
     // -----------------------------------------------------------------------
@@ -107,15 +111,64 @@ public:
      */
     static CommandLine split(const std::string& cmd);
 
+    /**
+     * @brief Split double quoted string into arguments.
+     *
+     * This overload appends the arguments to an existing argument vector
+     * and can be used to split large memory buffers such as the contents of
+     * a memory-mapped file without copying them into a string first.
+     *
+     * @param [in]     cmd  Double quoted string. See split(const std::string&).
+     * @param [in]     n    Number of characters in @p cmd.
+     * @param [in,out] args Argument vector to which arguments are appended.
+     */
+    static void split(const char* cmd, size_t n, CommandLine& args);
+
     /**
      * @brief Convert argument vector to double quoted string.
      *
+     * Arguments are only double quoted if required. Backslashes and double
+     * quotes within double quoted arguments are escaped using a backslash.
+     * The resulting string is split by split() into the same arguments.
+     *
      * @param [in] args Argument vector.
      *
      * @returns Double quoted string.
      */
     static std::string tostring(const CommandLine& args);
 
+    // -----------------------------------------------------------------------
+    // redirection
+public:
+
+    /**
+     * @brief Set file from which stdin of subprocess is read in mode RM_FILE.
+     *
+     * @param [in] path Path of input file.
+     */
+    void stdin_file(const std::string& path);
+
+    /**
+     * @brief Set file to which stdout of subprocess is written in mode RM_FILE.
+     *
+     * The file is opened by popen() and the subprocess writes to it directly,
+     * i.e., the output is not passed through the parent process.
+     *
+     * @param [in] path   Path of output file.
+     * @param [in] append Whether to append the output to an existing file.
+     *                    Otherwise, the file is truncated.
+     */
+    void stdout_file(const std::string& path, bool append = false);
+
+    /**
+     * @brief Set file to which stderr of subprocess is written in mode RM_FILE.
+     *
+     * @param [in] path   Path of output file.
+     * @param [in] append Whether to append the output to an existing file.
+     *                    Otherwise, the file is truncated.
+     */
+    void stderr_file(const std::string& path, bool append = false);
+
     // -----------------------------------------------------------------------
     // process control
 public:
@@ -130,11 +183,12 @@ public:
      * @param [in] args   Command-line of subprocess. The first argument has to
      *                    be the name/path of the command to be executed.
      * @param [in] rm_in  Mode used for redirection of stdin of subprocess.
-     *                    Can be either RM_NONE or RM_PIPE.
+     *                    Can be either RM_NONE, RM_PIPE, RM_FILE, or RM_DEVNULL.
      * @param [in] rm_out Mode used for redirection of stdout of subprocess.
-     *                    Can be either RM_NONE or RM_PIPE.
+     *                    Can be either RM_NONE, RM_PIPE, RM_FILE, or RM_DEVNULL.
      * @param [in] rm_err Mode used for redirection of stderr of subprocess.
-     *                    Can be either RM_NONE, RM_PIPE, or RM_STDOUT.
+     *                    Can be either RM_NONE, RM_PIPE, RM_STDOUT, RM_FILE,
+     *                    or RM_DEVNULL.
      * @param [in] env    Environment for the subprocess. If NULL is given, the
      *                    environment of the parent process is used.
      *
@@ -161,11 +215,12 @@ public:
      *                    itself (required if backslash at end of double quoted
      *                    argument, e.g., "this argument \\").
      * @param [in] rm_in  Mode used for redirection of stdin of subprocess.
-     *                    Can be either RM_NONE or RM_PIPE.
+     *                    Can be either RM_NONE, RM_PIPE, RM_FILE, or RM_DEVNULL.
      * @param [in] rm_out Mode used for redirection of stdout of subprocess.
-     *                    Can be either RM_NONE or RM_PIPE.
+     *                    Can be either RM_NONE, RM_PIPE, RM_FILE, or RM_DEVNULL.
      * @param [in] rm_err Mode used for redirection of stderr of subprocess.
-     *                    Can be either RM_NONE, RM_PIPE, or RM_STDOUT.
+     *                    Can be either RM_NONE, RM_PIPE, RM_STDOUT, RM_FILE,
+     *                    or RM_DEVNULL.
      * @param [in] env    Environment for the subprocess. If NULL is given, the
      *                    environment of the parent process is used.
      */
@@ -312,6 +367,41 @@ public:
      */
     int read(void* buf, size_t nbuf, bool err = false);
 
+    /**
+     * @brief Forward all data from stdout or stderr of subprocess to a file.
+     *
+     * On Linux, the data is moved from the pipe to the given file handle
+     * using splice(2) without copying it through user space. On other systems,
+     * or if the kernel does not support splicing to the given file, the data
+     * is copied using a read/write loop. This method returns when the end of
+     * the output stream of the subprocess is reached.
+     *
+     * @param [in] to  Handle of open file, pipe, or socket to write data to.
+     * @param [in] err If true and the redirection mode of stderr is RM_PIPE,
+     *                 the data is read from stderr of the subprocess.
+     *                 Otherwise, the data is read from stdout.
+     *
+     * @returns Whether all data was forwarded successfully.
+     */
+    bool splice(PipeHandle to, bool err = false);
+
+    /**
+     * @brief Forward all data from stdout or stderr of subprocess and keep a copy.
+     *
+     * On Linux, if @p to is a pipe, the data is duplicated using tee(2) and
+     * the copy is moved to @p copy using splice(2) such that the data is never
+     * copied through user space. Otherwise, a read/write loop is used.
+     *
+     * @param [in] to   Handle of open file or pipe to write data to.
+     * @param [in] copy Handle of open file to write copy of data to.
+     * @param [in] err  If true and the redirection mode of stderr is RM_PIPE,
+     *                  the data is read from stderr of the subprocess.
+     *                  Otherwise, the data is read from stdout.
+     *
+     * @returns Whether all data was forwarded successfully.
+     */
+    bool tee(PipeHandle to, PipeHandle copy, bool err = false);
+
     // -----------------------------------------------------------------------
     // process execution
 public:
@@ -372,19 +462,487 @@ private:
      */
     void operator=(const Subprocess&);
 
+    // -----------------------------------------------------------------------
+    // pipelines
+private:
+
+    friend class Pipeline;
+    friend class SubprocessMonitor;
+
+    /**
+     * @brief Open new subprocess with given standard input/output handles.
+     *
+     * This method implements popen(). If a valid handle is given for
+     * @p hin or @p hout, the standard input or output of the subprocess,
+     * respectively, is connected to this handle instead and the corresponding
+     * redirection mode is ignored. The given handles are not closed.
+     */
+    bool spawn(const CommandLine& args,
+               const RedirectMode rm_in,
+               const RedirectMode rm_out,
+               const RedirectMode rm_err,
+               const Environment* env,
+               PipeHandle         hin,
+               PipeHandle         hout);
+
+    /**
+     * @brief Close pipe to stdin of subprocess.
+     */
+    void close_stdin();
+
     // -----------------------------------------------------------------------
     // members
 private:
 
-    Information _info;   ///< Subprocess information.
-    PipeHandle  _stdin;  ///< Used to write data to stdin of subprocess.
-    PipeHandle  _stdout; ///< Used to read data from stdout of subprocess.
-    PipeHandle  _stderr; ///< Used to read data from stderr of subprocess.
-    mutable int _status; ///< Status of subprocess.
+    Information _info;      ///< Subprocess information.
+    PipeHandle  _stdin;     ///< Used to write data to stdin of subprocess.
+    PipeHandle  _stdout;    ///< Used to read data from stdout of subprocess.
+    PipeHandle  _stderr;    ///< Used to read data from stderr of subprocess.
+    mutable int _status;    ///< Status of subprocess.
+    std::string _file[3];   ///< Files used for redirection mode RM_FILE.
+    bool        _append[3]; ///< Whether to append output to the files.
 
 }; // class Subprocess
 
 
+/**
+ * @class Pipeline
+ * @brief Chain of subprocesses whose standard input and output are connected.
+ *
+ * The standard output of each subprocess is connected directly to the
+ * standard input of the next subprocess in the pipeline. Hence, the data
+ * passed between the subprocesses is not copied through the parent process.
+ *
+ * Example:
+ * @code
+ * Pipeline p;
+ * p | "convert input.nii -" | "filter - -" | "writer - output.nii";
+ * if (p.popen() && p.wait()) status = p.returncode();
+ * @endcode
+ */
+class Pipeline
+{
+    // -----------------------------------------------------------------------
+    // types
+public:
+
+    typedef Subprocess::CommandLine  CommandLine;
+    typedef Subprocess::Environment  Environment;
+    typedef Subprocess::RedirectMode RedirectMode;
+
+    // -----------------------------------------------------------------------
+    // construction / destruction
+public:
+
+    /**
+     * @brief Default constructor.
+     */
+    Pipeline();
+
+    /**
+     * @brief Terminate running subprocesses and close all related handles.
+     */
+    ~Pipeline();
+
+    // -----------------------------------------------------------------------
+    // stages
+public:
+
+    /**
+     * @brief Append command to pipeline.
+     *
+     * @param [in] cmd Command-line of subprocess.
+     *
+     * @returns Reference to this pipeline.
+     */
+    Pipeline& push_back(const CommandLine& cmd);
+
+    /**
+     * @brief Append command given as double quoted string to pipeline.
+     *
+     * @param [in] cmd Command-line of subprocess. See Subprocess::split().
+     *
+     * @returns Reference to this pipeline.
+     */
+    Pipeline& push_back(const std::string& cmd)
+    {
+        return push_back(Subprocess::split(cmd));
+    }
+
+    /**
+     * @brief Append command to pipeline.
+     *
+     * @sa push_back()
+     */
+    Pipeline& operator |(const CommandLine& cmd)
+    {
+        return push_back(cmd);
+    }
+
+    /**
+     * @brief Append command given as double quoted string to pipeline.
+     *
+     * @sa push_back()
+     */
+    Pipeline& operator |(const std::string& cmd)
+    {
+        return push_back(cmd);
+    }
+
+    /**
+     * @returns Number of subprocesses in pipeline.
+     */
+    size_t size() const
+    {
+        return _procs.size();
+    }
+
+    /**
+     * @returns Subprocess of i-th stage of pipeline.
+     */
+    Subprocess& operator [](size_t i)
+    {
+        return *_procs[i];
+    }
+
+    /**
+     * @returns First subprocess of pipeline which reads the input.
+     */
+    Subprocess& front()
+    {
+        return *_procs.front();
+    }
+
+    /**
+     * @returns Last subprocess of pipeline which produces the output.
+     */
+    Subprocess& back()
+    {
+        return *_procs.back();
+    }
+
+    // -----------------------------------------------------------------------
+    // process control
+public:
+
+    /**
+     * @brief Open subprocesses of pipeline.
+     *
+     * This method creates all subprocesses and returns immediately. If any
+     * subprocess could not be created, the previously started subprocesses
+     * are killed again.
+     *
+     * @param [in] rm_in  Mode used for redirection of stdin of first subprocess.
+     *                    Can be either RM_NONE, RM_PIPE, RM_FILE, or RM_DEVNULL.
+     *                    The file is set using front().stdin_file().
+     * @param [in] rm_out Mode used for redirection of stdout of last subprocess.
+     *                    Can be either RM_NONE, RM_PIPE, RM_FILE, or RM_DEVNULL.
+     *                    The file is set using back().stdout_file().
+     * @param [in] rm_err Mode used for redirection of stderr of each subprocess.
+     *                    Can be either RM_NONE, RM_PIPE, RM_STDOUT, or RM_DEVNULL.
+     * @param [in] env    Environment for the subprocesses. If NULL is given,
+     *                    the environment of the parent process is used.
+     *
+     * @returns Whether all subprocesses were created successfully.
+     */
+    bool popen(const RedirectMode rm_in  = Subprocess::RM_NONE,
+               const RedirectMode rm_out = Subprocess::RM_NONE,
+               const RedirectMode rm_err = Subprocess::RM_NONE,
+               const Environment* env    = NULL);
+
+    /**
+     * @brief Check if all subprocesses terminated.
+     */
+    bool poll() const;
+
+    /**
+     * @brief Wait for all subprocesses to terminate.
+     */
+    bool wait();
+
+    /**
+     * @brief Terminate all subprocesses.
+     */
+    bool terminate();
+
+    /**
+     * @brief Kill all subprocesses.
+     */
+    bool kill();
+
+    /**
+     * @returns Exit code of last subprocess. Only valid if terminated.
+     */
+    int returncode() const;
+
+    // -----------------------------------------------------------------------
+    // inter-process communication
+public:
+
+    /**
+     * @brief Read output of pipeline and wait for subprocesses to terminate.
+     *
+     * This method closes the pipe to stdin of the first subprocess if one
+     * was created and reads all data from stdout of the last subprocess.
+     * The stderr pipes of all subprocesses are read at the same time, such
+     * that no subprocess blocks on a full pipe. The data read from stderr
+     * is discarded.
+     *
+     * @param [in] out Data read from stdout of last subprocess.
+     *
+     * @returns Whether the communication with the pipeline was successful.
+     */
+    bool communicate(std::ostream& out);
+
+    /**
+     * @brief Read output of pipeline and wait for subprocesses to terminate.
+     *
+     * This method closes the pipe to stdin of the first subprocess if one
+     * was created and reads all data from stdout of the last subprocess and
+     * from the stderr pipes of all subprocesses at the same time.
+     *
+     * @param [in] out Data read from stdout of last subprocess.
+     * @param [in] err Data read from stderr of any subprocess.
+     *
+     * @returns Whether the communication with the pipeline was successful.
+     */
+    bool communicate(std::ostream& out, std::ostream& err);
+
+    /**
+     * @brief Write data to stdin of first subprocess.
+     *
+     * @sa Subprocess::write()
+     */
+    int write(const void* buf, size_t nbuf)
+    {
+        return front().write(buf, nbuf);
+    }
+
+    /**
+     * @brief Read data from stdout of last subprocess.
+     *
+     * @sa Subprocess::read()
+     */
+    int read(void* buf, size_t nbuf)
+    {
+        return back().read(buf, nbuf);
+    }
+
+    // -----------------------------------------------------------------------
+    // helpers
+private:
+
+    /**
+     * @brief Read stdout of last and stderr of all subprocesses.
+     *
+     * All pipes are read by a single event loop. Reading only the stdout of
+     * the last subprocess would block a subprocess once its stderr pipe is
+     * full, and thereby also the subprocesses reading its output.
+     *
+     * @param [in] out Data read from stdout of last subprocess.
+     * @param [in] err Data read from stderr of any subprocess.
+     *                 If NULL, this data is discarded.
+     *
+     * @returns Whether all data was written successfully.
+     */
+    bool drain(std::ostream& out, std::ostream* err);
+
+    // -----------------------------------------------------------------------
+    // unsupported operations
+private:
+
+    /**
+     * @brief Copy constructor.
+     *
+     * @note Intentionally not implemented.
+     */
+    Pipeline(const Pipeline&);
+
+    /**
+     * @brief Assignment operator.
+     *
+     * @note Intentionally not implemented.
+     */
+    void operator=(const Pipeline&);
+
+    // -----------------------------------------------------------------------
+    // members
+private:
+
+    std::vector<CommandLine> _cmds;  ///< Command-lines of subprocesses.
+    std::vector<Subprocess*> _procs; ///< Subprocesses of pipeline stages.
+
+}; // class Pipeline
+
+
+/**
+ * @class SubprocessMonitor
+ * @brief Event loop which streams the output of many subprocesses to callbacks.
+ *
+ * A single thread can use this class to monitor the output of any number of
+ * subprocesses which were opened with RM_PIPE for stdout and/or stderr. The
+ * output is passed to the Handler registered for each subprocess either
+ * line by line or in chunks as soon as it becomes available.
+ *
+ * Example:
+ * @code
+ * class Progress : public SubprocessMonitor::Handler
+ * {
+ *     void output(Subprocess& p, const char* data, size_t n, bool err)
+ *     {
+ *         cout << p.pid() << ": " << string(data, n);
+ *     }
+ * };
+ *
+ * Progress handler;
+ * SubprocessMonitor monitor;
+ * monitor.add(p1, handler);
+ * monitor.add(p2, handler);
+ * monitor.run();
+ * @endcode
+ */
+class SubprocessMonitor
+{
+    // -----------------------------------------------------------------------
+    // types
+public:
+
+    /**
+     * @brief Interface of callbacks invoked by the monitor.
+     */
+    class Handler
+    {
+    public:
+
+        /// Destructor.
+        virtual ~Handler() {}
+
+        /**
+         * @brief Called when output of subprocess is available.
+         *
+         * @param [in] p    Subprocess which produced the output.
+         * @param [in] data Line of output including the trailing newline
+         *                  (if any) or chunk of output, respectively.
+         * @param [in] n    Number of bytes in @p data.
+         * @param [in] err  Whether the output was written to stderr.
+         */
+        virtual void output(Subprocess& p, const char* data, size_t n, bool err) = 0;
+
+        /**
+         * @brief Called when subprocess closed its output and terminated.
+         *
+         * @param [in] p Subprocess whose exit code is set.
+         */
+        virtual void finished(Subprocess& /*p*/) {}
+    };
+
+    /**
+     * @brief How output is passed to the handler.
+     */
+    enum Mode
+    {
+        LINES, ///< Invoke handler for each line of output.
+        CHUNKS ///< Invoke handler for each chunk of output as read from the pipe.
+    };
+
+    // -----------------------------------------------------------------------
+    // construction / destruction
+public:
+
+    /**
+     * @brief Default constructor.
+     */
+    SubprocessMonitor();
+
+    /**
+     * @brief Destructor.
+     *
+     * The subprocesses which are still monitored are not terminated.
+     */
+    ~SubprocessMonitor();
+
+    // -----------------------------------------------------------------------
+    // event loop
+public:
+
+    /**
+     * @brief Monitor output of subprocess.
+     *
+     * @param [in] p       Subprocess opened with RM_PIPE for stdout and/or stderr.
+     *                     The subprocess must not be destroyed while monitored.
+     * @param [in] handler Callbacks invoked for this subprocess.
+     * @param [in] mode    Whether output is passed on line by line or in chunks.
+     */
+    void add(Subprocess& p, Handler& handler, Mode mode = LINES);
+
+    /**
+     * @returns Number of subprocesses which are still monitored.
+     */
+    size_t size() const
+    {
+        return _entries.size();
+    }
+
+    /**
+     * @brief Wait for output of any subprocess and invoke the handlers.
+     *
+     * Subprocesses which closed all their output pipes are waited for and
+     * removed from the monitor after Handler::finished() was called.
+     *
+     * @param [in] timeout Maximum time in milliseconds to wait for output.
+     *                     A negative value means to wait indefinitely.
+     *
+     * @returns Whether any subprocesses are still monitored.
+     */
+    bool run_once(int timeout = -1);
+
+    /**
+     * @brief Run event loop until all subprocesses finished.
+     */
+    void run();
+
+    // -----------------------------------------------------------------------
+    // unsupported operations
+private:
+
+    /**
+     * @brief Copy constructor.
+     *
+     * @note Intentionally not implemented.
+     */
+    SubprocessMonitor(const SubprocessMonitor&);
+
+    /**
+     * @brief Assignment operator.
+     *
+     * @note Intentionally not implemented.
+     */
+    void operator=(const SubprocessMonitor&);
+
+    // -----------------------------------------------------------------------
+    // members
+private:
+
+    /// Monitored subprocess.
+    struct Entry
+    {
+        Subprocess* process; ///< Subprocess.
+        Handler*    handler; ///< Callbacks.
+        Mode        mode;    ///< Output mode.
+        std::string line[2]; ///< Incomplete last line of stdout and stderr.
+    };
+
+    /// Read available output from stdout or stderr of subprocess.
+    bool dispatch(Entry& entry, bool err);
+
+    /// Remove finished subprocess.
+    void finish(size_t i);
+
+    std::vector<Entry*> _entries; ///< Monitored subprocesses.
+
+}; // class SubprocessMonitor
+
+
 } // namespace basis
 
 
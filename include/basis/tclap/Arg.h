@@ -34,6 +34,11 @@
 #include <iostream>
 #include <iomanip>
 #include <cstdio>
+#include <cstdlib>
+#include <cerrno>
+#include <clocale>
+#include <limits>
+#include <locale>
 
 #if defined(HAVE_SSTREAM)
 #include <sstream>
@@ -358,6 +363,16 @@ class Arg
 		 */
 		virtual void trimFlag( std::string& flag, std::string& value ) const;
 
+		/**
+		 * Checks whether the given token names this argument, optionally
+		 * followed by the delimiter and a value. Equivalent to trimFlag()
+		 * followed by argMatches(), but the token is only copied if it
+		 * matches and contains a value.
+		 * \param s - The token to be checked.
+		 * \param value - Where the value following the delimiter is stored.
+		 */
+		bool matchesFlag( const std::string& s, std::string& value ) const;
+
 		/**
 		 * Checks whether a given string has blank chars, indicating that
 		 * it is a combined SwitchArg.  If so, return true, otherwise return
@@ -407,17 +422,133 @@ typedef std::vector<Arg*>::iterator ArgVectorIterator;
  */
 typedef std::list<Visitor*>::iterator VisitorListIterator;
 
+/*
+ * Parses a decimal integer consisting of an optional sign followed by
+ * digits only. Returns false if strVal is not of this form or its value
+ * is out of range, in which case ExtractValue falls back to operator>>.
+ */
+template<typename T> bool
+ExtractIntegerValue(T &destVal, const std::string& strVal)
+{
+    const char* s = strVal.c_str();
+    const char* e = s + strVal.length();
+    bool neg = false;
+    if ( s != e && ( *s == '+' || *s == '-' ) )
+        neg = ( *s++ == '-' );
+    if ( s == e || ( neg && !std::numeric_limits<T>::is_signed ) )
+        return false;
+#ifdef TCLAP_SETBASE_ZERO
+    if ( *s == '0' && e - s > 1 )
+        return false;
+#endif
+    // accumulate towards the sign such that the minimum value is in range
+    const T limit = neg ? std::numeric_limits<T>::min()
+                        : std::numeric_limits<T>::max();
+    T value = 0;
+    for ( ; s != e; s++ ) {
+        if ( *s < '0' || *s > '9' )
+            return false;
+        const T digit = static_cast<T>(*s - '0');
+        if ( neg ) {
+            if ( value < ( limit + digit ) / 10 )
+                return false;
+            value = static_cast<T>(value * 10 - digit);
+        } else {
+            if ( value > ( limit - digit ) / 10 )
+                return false;
+            value = static_cast<T>(value * 10 + digit);
+        }
+    }
+    destVal = value;
+    return true;
+}
+
+/*
+ * Parses a decimal floating-point number without exponent or with a
+ * decimal exponent, i.e., the format accepted by operator>>. Other
+ * strings, including "inf", "nan", and hexadecimal numbers which
+ * strtod() would accept, as well as values out of range are rejected.
+ */
+template<typename T> bool
+ExtractFloatValue(T &destVal, const std::string& strVal)
+{
+    const char* s = strVal.c_str();
+    const char* e = s + strVal.length();
+    const char* p = s;
+    if ( p != e && ( *p == '+' || *p == '-' ) ) p++;
+    const char* d = p;
+    while ( p != e && '0' <= *p && *p <= '9' ) p++;
+    std::ptrdiff_t ndigits = p - d;
+    if ( p != e && *p == '.' ) {
+        d = ++p;
+        while ( p != e && '0' <= *p && *p <= '9' ) p++;
+        ndigits += p - d;
+    }
+    if ( ndigits == 0 )
+        return false;
+    if ( p != e && ( *p == 'e' || *p == 'E' ) ) {
+        p++;
+        if ( p != e && ( *p == '+' || *p == '-' ) ) p++;
+        d = p;
+        while ( p != e && '0' <= *p && *p <= '9' ) p++;
+        if ( p == d )
+            return false;
+    }
+    if ( p != e )
+        return false;
+    // strtod() depends on the decimal point of the C locale
+    const char* point = std::localeconv()->decimal_point;
+    if ( point[0] != '.' || point[1] != '\0' )
+        return false;
+    errno = 0;
+    char* end = NULL;
+    const T value = ( sizeof(T) == sizeof(float) )
+                  ? static_cast<T>(strtof(s, &end))
+                  : static_cast<T>(strtod(s, &end));
+    if ( end != e || errno == ERANGE )
+        return false;
+    destVal = value;
+    return true;
+}
+
+/*
+ * Fast path of ExtractValue for arithmetic types. Returns false if the
+ * value has to be parsed by operator>> instead.
+ */
+template<typename T> inline bool
+ExtractNumericValue(T&, const std::string&) { return false; }
+
+inline bool ExtractNumericValue(short &v, const std::string& s)          { return ExtractIntegerValue(v, s); }
+inline bool ExtractNumericValue(int &v, const std::string& s)            { return ExtractIntegerValue(v, s); }
+inline bool ExtractNumericValue(long &v, const std::string& s)           { return ExtractIntegerValue(v, s); }
+inline bool ExtractNumericValue(unsigned short &v, const std::string& s) { return ExtractIntegerValue(v, s); }
+inline bool ExtractNumericValue(unsigned int &v, const std::string& s)   { return ExtractIntegerValue(v, s); }
+inline bool ExtractNumericValue(unsigned long &v, const std::string& s)  { return ExtractIntegerValue(v, s); }
+#ifdef HAVE_LONG_LONG
+inline bool ExtractNumericValue(long long &v, const std::string& s)          { return ExtractIntegerValue(v, s); }
+inline bool ExtractNumericValue(unsigned long long &v, const std::string& s) { return ExtractIntegerValue(v, s); }
+#endif
+inline bool ExtractNumericValue(float &v, const std::string& s)  { return ExtractFloatValue(v, s); }
+inline bool ExtractNumericValue(double &v, const std::string& s) { return ExtractFloatValue(v, s); }
+
 /*
  * Extract a value of type T from it's string representation contained
  * in strVal. The ValueLike parameter used to select the correct
  * specialization of ExtractValue depending on the value traits of T.
  * ValueLike traits use operator>> to assign the value from strVal.
+ * Numbers are parsed directly unless they are malformed, in which case
+ * operator>> is used as well to report the same errors as before.
+ * Values are always read using the classic "C" locale.
  */
 template<typename T> void
 ExtractValue(T &destVal, const std::string& strVal, ValueLike vl)
 {
     static_cast<void>(vl); // Avoid warning about unused vl
+    if ( ExtractNumericValue(destVal, strVal) )
+        return;
+
     std::istringstream is(strVal);
+    is.imbue(std::locale::classic());
 
     int valuesRead = 0;
     while ( is.good() ) {
@@ -589,15 +720,50 @@ inline void Arg::setRequireLabel( const std::string& s)
 	_requireLabel = s;
 }
 
+/**
+ * Compares the first n characters of s to prefix + id without
+ * concatenating the strings.
+ */
+inline bool _argMatchesPrefixed( const std::string& s,
+                                 std::string::size_type n,
+                                 const char* prefix,
+                                 const std::string& id )
+{
+	const std::string::size_type len = std::char_traits<char>::length(prefix);
+	return n == len + id.length() &&
+	       s.compare(0, len, prefix) == 0 &&
+	       s.compare(len, id.length(), id) == 0;
+}
+
 inline bool Arg::argMatches( const std::string& argFlag ) const
 {
-	if ( ( argFlag == Arg::flagStartString() + _flag && _flag != "" ) ||
-	       argFlag == Arg::nameStartString() + _name )
+	if ( ( _flag != "" && _argMatchesPrefixed(argFlag, argFlag.length(),
+	                                          TCLAP_FLAGSTARTSTRING, _flag) ) ||
+	     _argMatchesPrefixed(argFlag, argFlag.length(),
+	                         TCLAP_NAMESTARTSTRING, _name) )
 		return true;
 	else
 		return false;
 }
 
+inline bool Arg::matchesFlag( const std::string& s, std::string& value ) const
+{
+	// same as trimFlag(), only the first delimiter after the start is used
+	std::string::size_type n = s.find( Arg::delimiter() );
+	if ( n == std::string::npos || n < 2 )
+		n = s.length();
+
+	if ( !( ( _flag != "" && _argMatchesPrefixed(s, n, TCLAP_FLAGSTARTSTRING, _flag) ) ||
+	        _argMatchesPrefixed(s, n, TCLAP_NAMESTARTSTRING, _name) ) )
+		return false;
+
+	if ( n < s.length() )
+		value.assign( s, n + 1, std::string::npos );
+	else
+		value.clear();
+	return true;
+}
+
 inline std::string Arg::toString() const
 {
 	std::string s = "";
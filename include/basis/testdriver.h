@@ -86,25 +86,6 @@ using namespace basis;
 /// @brief Maximum dimension of images used for testing.
 const unsigned int BASIS_MAX_TEST_IMAGE_DIMENSION = 6;
 
-// ---------------------------------------------------------------------------
-// environment
-MultiStringArg add_before_libpath(
-        "", "add-before-libpath",
-        "Add a path to the library path environment. This option takes"
-        " care of choosing the right environment variable for your system.",
-        false, "<dir>");
-
-MultiStringArg add_before_env(
-        "", "add-before-env",
-        "Add an environment variable named <name> with the given value."
-        " The seperator used is the default one on the system.",
-        false, "<name> <value>", 2);
-
-MultiStringArg add_before_env_with_sep(
-        "", "add-before-env-with-sep",
-        "Add an environment variable named <name> with the given value.",
-        false, "<name> <value> <sep>", 3);
-
 // ---------------------------------------------------------------------------
 // regression testing
 
@@ -128,9 +109,6 @@ struct RegressionTest {
     TestMethod   method;
 };
 
-/// @brief Container storing added regression tests.
-vector<RegressionTest> regression_tests;
-
 /// @brief Visitor used to handle --diff option.
 class BinaryDiffVisitor : public TCLAP::Visitor
 {
@@ -158,144 +136,254 @@ public:
     void visit();
 };
 
-CompareVisitor    compare_visitor;
-BinaryDiffVisitor diff_visitor;
-LineDiffVisitor   diff_lines_visitor;
-
-MultiStringArg diff(
-        "", "diff",
-        "Compare the <test> file to the <baseline> file byte by byte."
-        " Can by used to compare any files including text files."
-        " For images, the --compare option should be used instead.",
-        false, "<test> <baseline>", 2, false, &diff_visitor);
-
-MultiStringArg diff_lines(
-        "", "diff-lines",
-        "Compare the <test> file to the <baseline> file line by line."
-        " Can by used to compare text files. The current --max-number-of-differences"
-        " setting determines the number of lines which may differ between the files."
-        " For binary files, consider the --diff option instead.",
-        false, "<test> <baseline>", 2, false, &diff_lines_visitor);
-
-MultiStringArg compare(
-        "", "compare",
-        "Compare the <test> image to the <baseline> image using the"
-        " current tolerances. If the test image should be compared to"
-        " to more than one baseline image, specify the file name of"
-        " the main baseline image and name the other baseline images"
-        " similarly with only a numerical suffix appended to the"
-        " basename of the image file path using a dot (.) as separator."
-        " For example, name your baseline images baseline.nii,"
-        " baseline.1.nii, baseline.2.nii,..., and specify baseline.nii"
-        " second argument value.",
-        false, "<test> <baseline>", 2, false, &compare_visitor);
-
-DoubleArg intensity_tolerance(
-        "", "intensity-tolerance",
-        "The accepted maximum difference between image intensities"
-        " to use for the following regression tests."
-        // default should be printed automatically
-        " (default: 2.0)",
-        false, 2.0, "<float>", true);
-
-UIntArg max_number_of_differences(
-        "", "max-number-of-differences",
-        "When comparing images specified with the following --compare option(s),"
-        " allow the given number of image elements to differ.",
-        false, 0, "<n>", true);
-
-UIntArg tolerance_radius(
-        "", "tolerance-radius",
-        "At most one image element in the neighborhood specified by the"
-        " given radius has to fulfill the criteria of the following"
-        " regression tests",
-        false, 0, "<int>", true);
-
-SwitchArg orientation_insensitive(
-        "", "orientation-insensitive",
-        "Allow the test and baseline images to have different orientation."
-        " When this option is given, the orientation of both images is made"
-        " identical before they are compared. It is suitable if the test"
-        " and baseline images are simply stored with different orientation,"
-        " but with proper orientation information in the file header.");
-
 // ---------------------------------------------------------------------------
-// test execution
-StringArg redirect_output(
-        "", "redirect-output",
-        "Redirects the test output to the specified file.",
-        false, "", "<file>");
-
-UIntArg max_number_of_threads(
-        "", "max-number-of-threads",
-        "Use at most <n> threads. Set explicitly to n=1 to disable"
-        " multi-threading. Note that the test itself still may use"
-        " more threads, but the regression tests will not.",
-        false, 0, "<n>");
-
-SwitchArg full_output(
-        "", "full-output",
-        "Causes the full output of the test to be passed to CDash.",
-        false);
-
-MultiSwitchArg verbose(
-        "v", "verbose",
-        "Increase verbosity of output messages.",
-        false);
+// option table
+
+/**
+ * @brief Static description of a test driver option.
+ *
+ * The options of the test driver are described by a constant table of these
+ * plain structures which is initialized at compile time. The argument objects
+ * are only created by testdriversetup(), such that a test driver does not
+ * construct any strings or arguments before main() is entered.
+ */
+struct TestDriverOption
+{
+    const char* flag;        ///< Short option name.
+    const char* name;        ///< Long option name.
+    const char* description; ///< Help text.
+    const char* typedesc;    ///< Type description of option value(s).
+};
+
+/// @brief Indices of test driver options in testdriver_options.
+enum TestDriverOptionIndex
+{
+    // environment
+    OPT_ADD_BEFORE_LIBPATH,
+    OPT_ADD_BEFORE_ENV,
+    OPT_ADD_BEFORE_ENV_WITH_SEP,
+    // regression testing
+    OPT_DIFF,
+    OPT_DIFF_LINES,
+    OPT_COMPARE,
+    OPT_INTENSITY_TOLERANCE,
+    OPT_MAX_NUMBER_OF_DIFFERENCES,
+    OPT_TOLERANCE_RADIUS,
+    OPT_ORIENTATION_INSENSITIVE,
+    // test execution
+    OPT_REDIRECT_OUTPUT,
+    OPT_MAX_NUMBER_OF_THREADS,
+    OPT_FULL_OUTPUT,
+    OPT_VERBOSE,
+    // test / test command
+    OPT_CLEAN_CWD_BEFORE_TEST,
+    OPT_CLEAN_CWD_AFTER_TEST,
+    OPT_TESTCMD,
+    #ifdef BASIS_STANDALONE_TESTDRIVER
+    OPT_NOPROCESS,
+    #else
+    OPT_BATCH,
+    OPT_BATCH_FILE,
+    #endif
+    NUM_TESTDRIVER_OPTIONS
+};
+
+/// @brief Description of test driver options indexed by TestDriverOptionIndex.
+const TestDriverOption testdriver_options[NUM_TESTDRIVER_OPTIONS] = {
+    // -----------------------------------------------------------------------
+    // environment
+    { "", "add-before-libpath",
+      "Add a path to the library path environment. This option takes"
+      " care of choosing the right environment variable for your system.",
+      "<dir>" },
+    { "", "add-before-env",
+      "Add an environment variable named <name> with the given value."
+      " The seperator used is the default one on the system.",
+      "<name> <value>" },
+    { "", "add-before-env-with-sep",
+      "Add an environment variable named <name> with the given value.",
+      "<name> <value> <sep>" },
+    // -----------------------------------------------------------------------
+    // regression testing
+    { "", "diff",
+      "Compare the <test> file to the <baseline> file byte by byte."
+      " Can by used to compare any files including text files."
+      " For images, the --compare option should be used instead.",
+      "<test> <baseline>" },
+    { "", "diff-lines",
+      "Compare the <test> file to the <baseline> file line by line."
+      " Can by used to compare text files. The current --max-number-of-differences"
+      " setting determines the number of lines which may differ between the files."
+      " For binary files, consider the --diff option instead.",
+      "<test> <baseline>" },
+    { "", "compare",
+      "Compare the <test> image to the <baseline> image using the"
+      " current tolerances. If the test image should be compared to"
+      " to more than one baseline image, specify the file name of"
+      " the main baseline image and name the other baseline images"
+      " similarly with only a numerical suffix appended to the"
+      " basename of the image file path using a dot (.) as separator."
+      " For example, name your baseline images baseline.nii,"
+      " baseline.1.nii, baseline.2.nii,..., and specify baseline.nii"
+      " second argument value.",
+      "<test> <baseline>" },
+    { "", "intensity-tolerance",
+      "The accepted maximum difference between image intensities"
+      " to use for the following regression tests."
+      // default should be printed automatically
+      " (default: 2.0)",
+      "<float>" },
+    { "", "max-number-of-differences",
+      "When comparing images specified with the following --compare option(s),"
+      " allow the given number of image elements to differ.",
+      "<n>" },
+    { "", "tolerance-radius",
+      "At most one image element in the neighborhood specified by the"
+      " given radius has to fulfill the criteria of the following"
+      " regression tests",
+      "<int>" },
+    { "", "orientation-insensitive",
+      "Allow the test and baseline images to have different orientation."
+      " When this option is given, the orientation of both images is made"
+      " identical before they are compared. It is suitable if the test"
+      " and baseline images are simply stored with different orientation,"
+      " but with proper orientation information in the file header.",
+      "" },
+    // -----------------------------------------------------------------------
+    // test execution
+    { "", "redirect-output",
+      "Redirects the test output to the specified file.",
+      "<file>" },
+    { "", "max-number-of-threads",
+      "Use at most <n> threads. Set explicitly to n=1 to disable"
+      " multi-threading. Note that the test itself still may use"
+      " more threads, but the regression tests will not.",
+      "<n>" },
+    { "", "full-output",
+      "Causes the full output of the test to be passed to CDash.",
+      "" },
+    { "v", "verbose",
+      "Increase verbosity of output messages.",
+      "" },
+    // -----------------------------------------------------------------------
+    // test / test command
+    { "", "clean-cwd-before",
+      "Request the removal of all files and directories from the current"
+      " working directory before the execution of the test. This option is"
+      " in particular useful if the test writes any results to the current"
+      " working directory.",
+      "" },
+    { "", "clean-cwd-after",
+      "Request the removal of all files and directories from the current"
+      " working directory after the successful execution of the test."
+      " This option is in particular useful if the test writes any results"
+      " to the current working directory.",
+      "" },
+    #ifdef BASIS_STANDALONE_TESTDRIVER
+    { "", "testcmd",
+      "The external test command and its command-line arguments."
+      " This command is executed by the test driver after altering the"
+      " environment as subprocess. After the subprocess finished, the"
+      " requested regression tests are performed by the test driver."
+      " Note that if the -- option is not given before the test command,"
+      " labeled arguments following the test command will be considered"
+      " to be options of the test driver if known by the test driver.",
+      "[--] <test command> <arg>..." },
+    { "", "noprocess",
+      "Do not run any test subprocess but only perform the regression tests.",
+      "" }
+    #else // defined(BASIS_STANDALONE_TESTDRIVER)
+    { "", "testcmd",
+      "The name of the test to run and optional arguments."
+      " Displays a list of available tests if this argument is omitted"
+      " and waits for the user to input the number of the test to run."
+      " Exist with error if an invalid test was specified."
+      " Note that if the -- option is not given before the test name,"
+      " labeled arguments following the test name will be considered"
+      " to be options of the test driver if known by the test driver."
+      " Otherwise, if the option is unknown to the test driver or the"
+      " -- option has been given before the test name, the remaining"
+      " arguments are passed on to the test.",
+      "" },
+    { "", "batch",
+      "Run the named tests one after another within the test driver process"
+      " instead of a single test. In this mode, all arguments following the"
+      " test driver options are names of tests, which are run without arguments."
+      " Each test is executed in a subdirectory of the current working directory"
+      " named after the test, and the result of each test is reported."
+      " Regression tests and output redirection are not supported in this mode.",
+      "" },
+    { "", "batch-file",
+      "Run the tests listed in the given file in batch mode (see --batch)."
+      " Each line of the file names a test which is followed by the"
+      " whitespace separated arguments of the test. Empty lines and lines"
+      " starting with a hash (#) are ignored.",
+      "<file>" }
+    #endif // defined(BASIS_STANDALONE_TESTDRIVER)
+};
 
 // ---------------------------------------------------------------------------
-// test / test command
-SwitchArg clean_cwd_before_test(
-        "", "clean-cwd-before",
-        "Request the removal of all files and directories from the current"
-        " working directory before the execution of the test. This option is"
-        " in particular useful if the test writes any results to the current"
-        " working directory.",
-        false);
-
-SwitchArg clean_cwd_after_test(
-        "", "clean-cwd-after",
-        "Request the removal of all files and directories from the current"
-        " working directory after the successful execution of the test."
-        " This option is in particular useful if the test writes any results"
-        " to the current working directory.",
-        false);
-
-#ifdef BASIS_STANDALONE_TESTDRIVER
-
-PositionalArgs testcmd(
-        "testcmd",
-        "The external test command and its command-line arguments."
-        " This command is executed by the test driver after altering the"
-        " environment as subprocess. After the subprocess finished, the"
-        " requested regression tests are performed by the test driver."
-        " Note that if the -- option is not given before the test command,"
-        " labeled arguments following the test command will be considered"
-        " to be options of the test driver if known by the test driver.",
-        true, "[--] <test command> <arg>...");
-
-SwitchArg noprocess(
-        "", "noprocess",
-        "Do not run any test subprocess but only perform the regression tests.",
-        true);
-
-#else // defined(BASIS_STANDALONE_TESTDRIVER)
-
-PositionalArgs testcmd(
-        "testcmd",
-        "The name of the test to run and optional arguments."
-        " Displays a list of available tests if this argument is omitted"
-        " and waits for the user to input the number of the test to run."
-        " Exist with error if an invalid test was specified."
-        " Note that if the -- option is not given before the test name,"
-        " labeled arguments following the test name will be considered"
-        " to be options of the test driver if known by the test driver."
-        " Otherwise, if the option is unknown to the test driver or the"
-        " -- option has been given before the test name, the remaining"
-        " arguments are passed on to the test.",
-        false, "", "[--] [<test name> [<arg>...]]");
-
-#endif // defined(BASIS_STANDALONE_TESTDRIVER)
+// argument objects
+
+/**
+ * @brief Command-line arguments of the test driver.
+ *
+ * An instance of this structure is created from the testdriver_options table
+ * upon the first call of testdriversetup() and made available through the
+ * global testdriver_args pointer.
+ */
+struct TestDriverArgs
+{
+    // regression tests
+    vector<RegressionTest> regression_tests; ///< Added regression tests.
+    CompareVisitor         compare_visitor;
+    BinaryDiffVisitor      diff_visitor;
+    LineDiffVisitor        diff_lines_visitor;
+
+    // environment
+    MultiStringArg add_before_libpath;
+    MultiStringArg add_before_env;
+    MultiStringArg add_before_env_with_sep;
+
+    // regression testing
+    MultiStringArg diff;
+    MultiStringArg diff_lines;
+    MultiStringArg compare;
+    DoubleArg      intensity_tolerance;
+    UIntArg        max_number_of_differences;
+    UIntArg        tolerance_radius;
+    SwitchArg      orientation_insensitive;
+
+    // test execution
+    StringArg      redirect_output;
+    UIntArg        max_number_of_threads;
+    SwitchArg      full_output;
+    MultiSwitchArg verbose;
+
+    // test / test command
+    SwitchArg      clean_cwd_before_test;
+    SwitchArg      clean_cwd_after_test;
+    PositionalArgs testcmd;
+    #ifdef BASIS_STANDALONE_TESTDRIVER
+    SwitchArg      noprocess;
+    #else
+    SwitchArg      batch;
+    StringArg      batch_file;
+
+    /// @brief Name and arguments of tests to run in batch mode.
+    vector<vector<string> > batch_tests;
+    #endif
+
+    /// @brief Create argument objects from testdriver_options.
+    TestDriverArgs();
+
+private:
+    TestDriverArgs(const TestDriverArgs&);            ///< Not implemented.
+    TestDriverArgs& operator=(const TestDriverArgs&); ///< Not implemented.
+};
+
+/// @brief Arguments of test driver or @c NULL before testdriversetup() was called.
+TestDriverArgs* testdriver_args = NULL;
 
 // ===========================================================================
 // initialization
@@ -304,12 +392,42 @@ PositionalArgs testcmd(
 /**
  * @brief Parse command-line arguments and initialize test driver.
  *
+ * Creates the argument objects of the test driver, i.e., testdriver_args,
+ * when called the first time.
  *
  * @param [in] argc Number of arguments.
  * @param [in] argv Command-line arguments.
  */
 void testdriversetup(int* argc, char** argv[]);
 
+/**
+ * @brief Get wall clock time in seconds from a monotonic clock.
+ *
+ * Only the difference of two values returned by this function is meaningful.
+ */
+double testdriverclock();
+
+#ifndef BASIS_STANDALONE_TESTDRIVER
+
+/**
+ * @brief Run tests of batch mode within the test driver process.
+ *
+ * This function is called by the code of testdriver-before-test.inc with the
+ * table of test functions generated by create_test_sourcelist() when the
+ * test driver was invoked with the --batch or --batch-file option.
+ * Each test is run in its own subdirectory of the current working directory
+ * and its result is reported in the same form as CTest reports test results.
+ *
+ * @param [in] tests Table of tests terminated by an entry whose name is @c NULL.
+ *                   The table entries must have the members @c name and @c func.
+ *
+ * @returns Zero if all tests passed and one otherwise.
+ */
+template <class TestEntry>
+int testdriverbatch(const TestEntry* tests);
+
+#endif // !defined(BASIS_STANDALONE_TESTDRIVER)
+
 // ===========================================================================
 // low-level file comparison
 // ===========================================================================
@@ -18,15 +18,24 @@
 
 
 #include <iterator>
+#include <iomanip>
+#include <sstream>
+#include <cctype>   // tolower()
 
 #if WINDOWS
 #  include <Winsock2.h> // gethostname()
+#  include <windows.h>  // QueryPerformanceCounter()
 #  ifdef max
 #    undef max
 #  endif
 #  pragma comment(lib, "Ws2_32.lib")
 #else
 #  include <unistd.h>   // gethostname()
+#  if MACOS
+#    include <mach/mach_time.h> // mach_absolute_time()
+#  else
+#    include <time.h>           // clock_gettime()
+#  endif
 #endif
 
 #ifdef ITK_VERSION
@@ -38,9 +47,145 @@
 // initialization
 // ===========================================================================
 
+/// @brief Flag, name, and description of option with the given index.
+#define BASIS_TESTDRIVER_OPTION(i) \
+    testdriver_options[i].flag, testdriver_options[i].name, testdriver_options[i].description
+
+// ---------------------------------------------------------------------------
+TestDriverArgs::TestDriverArgs()
+:
+    // environment
+    add_before_libpath(
+        BASIS_TESTDRIVER_OPTION(OPT_ADD_BEFORE_LIBPATH), false,
+        testdriver_options[OPT_ADD_BEFORE_LIBPATH].typedesc),
+    add_before_env(
+        BASIS_TESTDRIVER_OPTION(OPT_ADD_BEFORE_ENV), false,
+        testdriver_options[OPT_ADD_BEFORE_ENV].typedesc, 2),
+    add_before_env_with_sep(
+        BASIS_TESTDRIVER_OPTION(OPT_ADD_BEFORE_ENV_WITH_SEP), false,
+        testdriver_options[OPT_ADD_BEFORE_ENV_WITH_SEP].typedesc, 3),
+    // regression testing
+    diff(
+        BASIS_TESTDRIVER_OPTION(OPT_DIFF), false,
+        testdriver_options[OPT_DIFF].typedesc, 2, false, &diff_visitor),
+    diff_lines(
+        BASIS_TESTDRIVER_OPTION(OPT_DIFF_LINES), false,
+        testdriver_options[OPT_DIFF_LINES].typedesc, 2, false, &diff_lines_visitor),
+    compare(
+        BASIS_TESTDRIVER_OPTION(OPT_COMPARE), false,
+        testdriver_options[OPT_COMPARE].typedesc, 2, false, &compare_visitor),
+    intensity_tolerance(
+        BASIS_TESTDRIVER_OPTION(OPT_INTENSITY_TOLERANCE), false, 2.0,
+        testdriver_options[OPT_INTENSITY_TOLERANCE].typedesc, true),
+    max_number_of_differences(
+        BASIS_TESTDRIVER_OPTION(OPT_MAX_NUMBER_OF_DIFFERENCES), false, 0,
+        testdriver_options[OPT_MAX_NUMBER_OF_DIFFERENCES].typedesc, true),
+    tolerance_radius(
+        BASIS_TESTDRIVER_OPTION(OPT_TOLERANCE_RADIUS), false, 0,
+        testdriver_options[OPT_TOLERANCE_RADIUS].typedesc, true),
+    orientation_insensitive(
+        BASIS_TESTDRIVER_OPTION(OPT_ORIENTATION_INSENSITIVE)),
+    // test execution
+    redirect_output(
+        BASIS_TESTDRIVER_OPTION(OPT_REDIRECT_OUTPUT), false, "",
+        testdriver_options[OPT_REDIRECT_OUTPUT].typedesc),
+    max_number_of_threads(
+        BASIS_TESTDRIVER_OPTION(OPT_MAX_NUMBER_OF_THREADS), false, 0,
+        testdriver_options[OPT_MAX_NUMBER_OF_THREADS].typedesc),
+    full_output(
+        BASIS_TESTDRIVER_OPTION(OPT_FULL_OUTPUT), false),
+    verbose(
+        BASIS_TESTDRIVER_OPTION(OPT_VERBOSE), false),
+    // test / test command
+    clean_cwd_before_test(
+        BASIS_TESTDRIVER_OPTION(OPT_CLEAN_CWD_BEFORE_TEST), false),
+    clean_cwd_after_test(
+        BASIS_TESTDRIVER_OPTION(OPT_CLEAN_CWD_AFTER_TEST), false),
+    #ifdef BASIS_STANDALONE_TESTDRIVER
+    testcmd(
+        testdriver_options[OPT_TESTCMD].name,
+        testdriver_options[OPT_TESTCMD].description, true,
+        testdriver_options[OPT_TESTCMD].typedesc),
+    noprocess(
+        BASIS_TESTDRIVER_OPTION(OPT_NOPROCESS), true)
+    #else
+    testcmd(
+        testdriver_options[OPT_TESTCMD].name,
+        testdriver_options[OPT_TESTCMD].description, false,
+        testdriver_options[OPT_TESTCMD].typedesc, true),
+    batch(
+        BASIS_TESTDRIVER_OPTION(OPT_BATCH), false),
+    batch_file(
+        BASIS_TESTDRIVER_OPTION(OPT_BATCH_FILE), false, "",
+        testdriver_options[OPT_BATCH_FILE].typedesc)
+    #endif
+{
+}
+
+#undef BASIS_TESTDRIVER_OPTION
+
+#ifndef BASIS_STANDALONE_TESTDRIVER
+
+// ---------------------------------------------------------------------------
+/// @brief Collect tests to run in batch mode and check options.
+static void testdriverbatchsetup(TestDriverArgs& args)
+{
+    if (!args.regression_tests.empty() || args.redirect_output.isSet()) {
+        BASIS_THROW(CmdLineException, "Options --compare, --diff, --diff-lines,"
+                                      " and --redirect-output cannot be used in batch mode!");
+    }
+    for (size_t i = 0; i < args.testcmd.getValue().size(); i++) {
+        args.batch_tests.push_back(vector<string>(1, args.testcmd.getValue()[i]));
+    }
+    if (args.batch_file.isSet()) {
+        ifstream ifs(args.batch_file.getValue().c_str());
+        if (!ifs) {
+            BASIS_THROW(CmdLineException, "Failed to open batch file " << args.batch_file.getValue() << "!");
+        }
+        string line;
+        while (getline(ifs, line)) {
+            istringstream iss(line);
+            vector<string> test;
+            string         arg;
+            while (iss >> arg) test.push_back(arg);
+            if (!test.empty() && test[0][0] != '#') args.batch_tests.push_back(test);
+        }
+    }
+    if (args.batch_tests.empty()) {
+        BASIS_THROW(CmdLineException, "No tests specified for batch mode!");
+    }
+}
+
+#endif // !defined(BASIS_STANDALONE_TESTDRIVER)
+
+// ---------------------------------------------------------------------------
+double testdriverclock()
+{
+#if WINDOWS
+    static LARGE_INTEGER frequency = {{0, 0}};
+    if (frequency.QuadPart == 0) QueryPerformanceFrequency(&frequency);
+    LARGE_INTEGER count;
+    QueryPerformanceCounter(&count);
+    return static_cast<double>(count.QuadPart) / static_cast<double>(frequency.QuadPart);
+#elif MACOS
+    static mach_timebase_info_data_t timebase = {0, 0};
+    if (timebase.denom == 0) mach_timebase_info(&timebase);
+    return 1e-9 * static_cast<double>(mach_absolute_time()) * timebase.numer / timebase.denom;
+#else
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return static_cast<double>(ts.tv_sec) + 1e-9 * static_cast<double>(ts.tv_nsec);
+#endif
+}
+
 // ---------------------------------------------------------------------------
 void testdriversetup(int* argc, char** argv[])
 {
+    const double start = testdriverclock();
+
+    static TestDriverArgs args;
+    testdriver_args = &args;
+
     try {
         string name;
         #ifdef TESTDRIVER_NAME
@@ -71,26 +216,28 @@ void testdriversetup(int* argc, char** argv[])
                 // version information
                 RELEASE, "2011, 2012 University of Pennsylvania");
 
-        cmd.add(add_before_libpath);
-        cmd.add(add_before_env);
-        cmd.add(clean_cwd_before_test);
-        cmd.add(clean_cwd_after_test);
-        cmd.add(diff);
-        cmd.add(diff_lines);
-        cmd.add(compare);
-        cmd.add(max_number_of_differences);
-        cmd.add(intensity_tolerance);
-        cmd.add(tolerance_radius);
-        cmd.add(orientation_insensitive);
-        cmd.add(redirect_output);
-        cmd.add(max_number_of_threads);
-        cmd.add(full_output);
-        cmd.add(verbose);
+        cmd.add(args.add_before_libpath);
+        cmd.add(args.add_before_env);
+        cmd.add(args.clean_cwd_before_test);
+        cmd.add(args.clean_cwd_after_test);
+        cmd.add(args.diff);
+        cmd.add(args.diff_lines);
+        cmd.add(args.compare);
+        cmd.add(args.max_number_of_differences);
+        cmd.add(args.intensity_tolerance);
+        cmd.add(args.tolerance_radius);
+        cmd.add(args.orientation_insensitive);
+        cmd.add(args.redirect_output);
+        cmd.add(args.max_number_of_threads);
+        cmd.add(args.full_output);
+        cmd.add(args.verbose);
 
         #ifdef BASIS_STANDALONE_TESTDRIVER
-        cmd.xorAdd(noprocess, testcmd);
+        cmd.xorAdd(args.noprocess, args.testcmd);
         #else
-        cmd.add(testcmd);
+        cmd.add(args.batch);
+        cmd.add(args.batch_file);
+        cmd.add(args.testcmd);
         #endif
 
         // -------------------------------------------------------------------
@@ -99,16 +246,27 @@ void testdriversetup(int* argc, char** argv[])
 
         // -------------------------------------------------------------------
         // rearrange argc and argv of main()
-        if (testcmd.isSet()) {
-            for (unsigned int i = 0; i < testcmd.getValue().size(); i++) {
+        #ifndef BASIS_STANDALONE_TESTDRIVER
+        if (args.batch.getValue() || args.batch_file.isSet()) {
+            testdriverbatchsetup(args);
+            // let main() of test driver dispatch to the first test such that
+            // testdriver-before-test.inc is executed which runs all tests
+            *argc = 2;
+            (*argv)[1] = const_cast<char*>(args.batch_tests.front().front().c_str());
+            (*argv)[2] = NULL;
+        } else
+        #endif
+        if (args.testcmd.isSet()) {
+            const vector<string>& testargs = args.testcmd.getValue();
+            for (unsigned int i = 0; i < testargs.size(); i++) {
                 for (int j = 1; j < (*argc); j++) {
-                    if (testcmd.getValue()[i] == (*argv)[j]) {
+                    if (testargs[i] == (*argv)[j]) {
                         (*argv)[i + 1] = (*argv)[j];
                         break;
                     }
                 }
             }
-            *argc = static_cast<int>(testcmd.getValue().size()) + 1;
+            *argc = static_cast<int>(testargs.size()) + 1;
             (*argv)[*argc] = NULL;
         } else {
             *argc = 1;
@@ -129,7 +287,7 @@ void testdriversetup(int* argc, char** argv[])
     }
 
     // -----------------------------------------------------------------------
-    // add host name as Dart/CDash measurement
+    // add host name, working directory, and setup time as Dart/CDash measurements
     char hostname[256] = "unknown";
     #if WINDOWS
         WSADATA wsaData;
@@ -141,19 +299,24 @@ void testdriversetup(int* argc, char** argv[])
     #endif
     hostname[255] = '\0';
 
-    cout << "<DartMeasurement name=\"Host Name\" type=\"string\">";
-    cout << hostname;
-    cout <<  "</DartMeasurement>" << endl;
-
-    cout << "<DartMeasurement name=\"Working Directory\" type=\"string\">";
-    cout << os::getcwd();
-    cout <<  "</DartMeasurement>" << endl;
+    // elapsed time of the setup in milliseconds, mainly the argument parsing
+    const double setup_time = 1000.0 * (testdriverclock() - start);
 
+    ostringstream measurements;
+    measurements << "<DartMeasurement name=\"Host Name\" type=\"string\">"
+                 << hostname << "</DartMeasurement>\n"
+                 << "<DartMeasurement name=\"Working Directory\" type=\"string\">"
+                 << os::getcwd() << "</DartMeasurement>\n";
     #ifdef ITK_VERSION
-    cout << "<DartMeasurement name=\"ITK Version\" type=\"string\">";
-    cout << ITK_VERSION;
-    cout <<  "</DartMeasurement>" << endl;
+    measurements << "<DartMeasurement name=\"ITK Version\" type=\"string\">"
+                 << ITK_VERSION << "</DartMeasurement>\n";
     #endif
+    measurements << "<DartMeasurement name=\"Test Driver Setup Time\" type=\"numeric/double\">"
+                 << setup_time << "</DartMeasurement>\n";
+    // write all measurements at once
+    const string output = measurements.str();
+    cout.write(output.data(), static_cast<streamsize>(output.size()));
+    cout.flush();
 
     // -----------------------------------------------------------------------
     // register ITK IO factories
@@ -162,6 +325,105 @@ void testdriversetup(int* argc, char** argv[])
     #endif
 }
 
+// ===========================================================================
+// batch mode
+// ===========================================================================
+
+#ifndef BASIS_STANDALONE_TESTDRIVER
+
+// ---------------------------------------------------------------------------
+/// @brief Compare test names ignoring case as done by main() of the test driver.
+inline bool testdriver_name_equal(const char* a, const char* b)
+{
+    while (*a && tolower(*a) == tolower(*b)) a++, b++;
+    return tolower(*a) == tolower(*b);
+}
+
+// ---------------------------------------------------------------------------
+template <class TestEntry>
+int testdriverbatch(const TestEntry* tests)
+{
+    const vector<vector<string> >& batch = testdriver_args->batch_tests;
+    const string                   cwd   = os::getcwd();
+    const int                      n     = static_cast<int>(batch.size());
+    vector<string>                 failed;
+
+    for (int i = 0; i < n; i++) {
+        const string& name = batch[i][0];
+        int           j    = 0;
+        while (tests[j].name && !testdriver_name_equal(tests[j].name, name.c_str())) j++;
+
+        cout << "      Start " << setw(2) << (i + 1) << ": " << name << endl;
+
+        int          result = 0;
+        const char*  status = "Passed";
+        const string wd     = os::path::join(cwd, name);
+        const double start  = testdriverclock();
+
+        if (tests[j].name == NULL) {
+            status = "Not Run";
+            result = -1;
+            cerr << "Unknown test name: " << name << endl;
+        } else if ((!os::path::isdir(wd) && !os::mkdir(wd)) ||
+                   (testdriver_args->clean_cwd_before_test.getValue() && !os::emptydir(wd)) ||
+                   !os::chdir(wd)) {
+            status = "Not Run";
+            result = -1;
+            cerr << "Failed to set up working directory " << wd << " of test " << name << endl;
+        } else {
+            vector<char*> argv(batch[i].size() + 1, NULL);
+            for (size_t k = 0; k < batch[i].size(); k++) {
+                argv[k] = const_cast<char*>(batch[i][k].c_str());
+            }
+            // labeled arguments of the previous test may have been ignored
+            TCLAP::Arg::stopIgnoring();
+            try {
+                result = (*tests[j].func)(static_cast<int>(batch[i].size()), &argv[0]);
+            } catch (const exception& e) {
+                cerr << "Test driver caught an exception:\n" << e.what() << endl;
+                result = -1;
+            } catch (...) {
+                cerr << "Test driver caught an unknown exception!!!" << endl;
+                result = -1;
+            }
+            os::chdir(cwd);
+            if (result != 0) {
+                status = "Failed";
+            } else if (testdriver_args->clean_cwd_after_test.getValue()) {
+                os::emptydir(wd);
+            }
+        }
+        const double t = testdriverclock() - start;
+        if (result != 0) failed.push_back(name);
+
+        // report result as done by CTest
+        ostringstream line;
+        line << setw(2) << (i + 1) << '/' << n << " Test #" << (i + 1) << ": " << name << ' ';
+        const int dots = 40 - static_cast<int>(line.str().size());
+        if (dots > 0) line << string(dots, '.');
+        line << "   " << status;
+        if (result != 0 && tests[j].name) line << " (" << result << ')';
+        cout << line.str() << "    "
+             << fixed << setprecision(2) << t << " sec" << endl;
+        cout << "<DartMeasurement name=\"" << name << " Status\" type=\"text/string\">"
+             << status << "</DartMeasurement>" << endl;
+    }
+
+    // summary
+    const int npassed = n - static_cast<int>(failed.size());
+    cout << "\n" << (npassed * 100 / n) << "% tests passed, " << failed.size()
+         << " tests failed out of " << n << endl;
+    if (!failed.empty()) {
+        cout << "\nThe following tests FAILED:" << endl;
+        for (size_t i = 0; i < failed.size(); i++) {
+            cout << '\t' << failed[i] << endl;
+        }
+    }
+    return failed.empty() ? 0 : 1;
+}
+
+#endif // !defined(BASIS_STANDALONE_TESTDRIVER)
+
 // ===========================================================================
 // low-level file comparison
 // ===========================================================================
@@ -169,20 +431,22 @@ void testdriversetup(int* argc, char** argv[])
 // ---------------------------------------------------------------------------
 void BinaryDiffVisitor::visit()
 {
-    assert(diff.getValue().size() != 0);
-    assert((diff.getValue().size() % 2) == 0);
+    const vector<string>& files = testdriver_args->diff.getValue();
+
+    assert(files.size() != 0);
+    assert((files.size() % 2) == 0);
 
     RegressionTest regression_test;
 
-    regression_test.test_file                 = diff.getValue()[diff.getValue().size() - 2];
-    regression_test.baseline_file             = diff.getValue()[diff.getValue().size() - 1];
+    regression_test.test_file                 = files[files.size() - 2];
+    regression_test.baseline_file             = files[files.size() - 1];
     regression_test.intensity_tolerance       = 0.0f;
     regression_test.max_number_of_differences = 0;
     regression_test.tolerance_radius          = 0;
     regression_test.orientation_insensitive   = false;
     regression_test.method                    = BINARY_DIFF;
 
-    regression_tests.push_back(regression_test);
+    testdriver_args->regression_tests.push_back(regression_test);
 }
 
 // ---------------------------------------------------------------------------
@@ -210,20 +474,22 @@ int binary_diff(const char* testfile, const char* baseline)
 // ---------------------------------------------------------------------------
 void LineDiffVisitor::visit()
 {
-    assert(diff_lines.getValue().size() != 0);
-    assert((diff_lines.getValue().size() % 2) == 0);
+    const vector<string>& files = testdriver_args->diff_lines.getValue();
+
+    assert(files.size() != 0);
+    assert((files.size() % 2) == 0);
 
     RegressionTest regression_test;
 
-    regression_test.test_file                 = diff_lines.getValue()[diff_lines.getValue().size() - 2];
-    regression_test.baseline_file             = diff_lines.getValue()[diff_lines.getValue().size() - 1];
+    regression_test.test_file                 = files[files.size() - 2];
+    regression_test.baseline_file             = files[files.size() - 1];
     regression_test.intensity_tolerance       = 0.0f;
-    regression_test.max_number_of_differences = max_number_of_differences.getValue();
+    regression_test.max_number_of_differences = testdriver_args->max_number_of_differences.getValue();
     regression_test.tolerance_radius          = 0;
     regression_test.orientation_insensitive   = false;
     regression_test.method                    = DIFF_LINES;
 
-    regression_tests.push_back(regression_test);
+    testdriver_args->regression_tests.push_back(regression_test);
 }
 
 // ---------------------------------------------------------------------------
@@ -252,20 +518,22 @@ int text_diff_lines(const char* testfile, const char* baseline, unsigned int max
 // ---------------------------------------------------------------------------
 void CompareVisitor::visit()
 {
-    assert(compare.getValue().size() != 0);
-    assert((compare.getValue().size() % 2) == 0);
+    const vector<string>& files = testdriver_args->compare.getValue();
+
+    assert(files.size() != 0);
+    assert((files.size() % 2) == 0);
 
     RegressionTest regression_test;
 
-    regression_test.test_file                 = compare.getValue()[compare.getValue().size() - 2];
-    regression_test.baseline_file             = compare.getValue()[compare.getValue().size() - 1];
-    regression_test.intensity_tolerance       = intensity_tolerance.getValue();
-    regression_test.max_number_of_differences = max_number_of_differences.getValue();
-    regression_test.tolerance_radius          = tolerance_radius.getValue();
-    regression_test.orientation_insensitive   = orientation_insensitive.getValue();
+    regression_test.test_file                 = files[files.size() - 2];
+    regression_test.baseline_file             = files[files.size() - 1];
+    regression_test.intensity_tolerance       = testdriver_args->intensity_tolerance.getValue();
+    regression_test.max_number_of_differences = testdriver_args->max_number_of_differences.getValue();
+    regression_test.tolerance_radius          = testdriver_args->tolerance_radius.getValue();
+    regression_test.orientation_insensitive   = testdriver_args->orientation_insensitive.getValue();
     regression_test.method                    = COMPARE_IMAGES;
 
-    regression_tests.push_back(regression_test);
+    testdriver_args->regression_tests.push_back(regression_test);
 }
 
 // ---------------------------------------------------------------------------
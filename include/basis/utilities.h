@@ -334,6 +334,7 @@ std::vector<std::string> qsplit(const std::string& args);
  *                         verbosity of executed command.
  * @param [in]  simulate   Whether to simulate command execution only.
  * @param [in]  targets    Structure providing information about executable targets.
+ * @param [in]  response_file Whether the executable reads \@file arguments.
  *
  * @returns Exit code of command or -1 if subprocess creation failed.
  *
@@ -347,7 +348,8 @@ int execute(const std::string&           cmd,
             bool                         allow_fail = false,
             int                          verbose    = 0,
             bool                         simulate   = false,
-            const IExecutableTargetInfo* targets    = NULL);
+            const IExecutableTargetInfo* targets    = NULL,
+            bool                         response_file = false);
 
 /**
  * @brief Execute command as subprocess.
@@ -358,6 +360,12 @@ int execute(const std::string&           cmd,
  * argument is a know build target name. Otherwise, the command-line is used
  * unmodified.
  *
+ * If @p response_file is true and the command-line exceeds the maximum length
+ * supported by the system, the remaining arguments are written to a temporary
+ * response file which is passed to the executable as single \@file argument
+ * instead. Enable this option only for executables which parse their
+ * command-line using basis::CmdLine::parse().
+ *
  * @param [in]  args       Command-line given as argument vector. The first
  *                         argument has to be either a build target name or the
  *                         name/path of the command to execute. Note that as a
@@ -374,6 +382,7 @@ int execute(const std::string&           cmd,
  *                         verbosity of executed command.
  * @param [in]  simulate   Whether to simulate command execution only.
  * @param [in]  targets    Structure providing information about executable targets.
+ * @param [in]  response_file Whether the executable reads \@file arguments.
  *
  * @returns Exit code of command or -1 if subprocess creation failed.
  *
@@ -387,7 +396,8 @@ int execute(std::vector<std::string>        args,
             bool                            allow_fail = false,
             int                             verbose    = 0,
             bool                            simulate   = false,
-            const IExecutableTargetInfo*    targets    = NULL);
+            const IExecutableTargetInfo*    targets    = NULL,
+            bool                            response_file = false);
 
 
 } } // end of namespaces
@@ -566,6 +566,14 @@ mark_as_advanced (BUILD_BASIS_UTILITIES_FOR_CXX
 # commands are not given.
 set (BASIS_EXPORT_DEFAULT TRUE)
 
+## @brief Default format of command-line interface descriptions of C++ executables.
+#
+# If set to either @c XML or @c JSON, basis_add_executable() writes a description
+# of the command-line arguments of each C++ executable to a file next to the
+# executable unless the @c CMDLINE_SCHEMA option is given explicitly. Executables
+# must use basis::CmdLine for this. By default, no such files are generated.
+set (BASIS_CMDLINE_SCHEMA)
+
 ## @brief Suffix used for target exports file "<Package><ExportSuffix>.cmake"
 set (BASIS_EXPORT_SUFFIX "Exports")
 
@@ -596,6 +604,49 @@ mark_as_advanced (BASIS_REVISION_INFO)
 option (BASIS_COMPILE_SCRIPTS "Enable compilation of scripts if supported by the language." OFF)
 mark_as_advanced (BASIS_COMPILE_SCRIPTS)
 
+## @brief Maximum number of modules of a script library built by one build command.
+#
+# The modules of a script library are configured in batches of at most this
+# many modules, each in a single CMake process. Different batches can be
+# built in parallel by the build tool. A value of 1 adds a separate build
+# command for each module.
+#
+# @sa basis_build_script_library()
+set (BASIS_SCRIPT_BATCH_SIZE 50 CACHE STRING "Maximum number of modules of a script library built by one build command.")
+mark_as_advanced (BASIS_SCRIPT_BATCH_SIZE)
+
+## @brief Enable unity builds of C++ targets by default.
+#
+# If enabled, the source files of C++ executables and libraries added by
+# basis_add_executable() and basis_add_library() are compiled in batches of
+# @c BASIS_UNITY_BUILD_BATCH_SIZE files unless the @c NO_UNITY_BUILD option
+# is given. Requires CMake 3.16 or later.
+#
+# @sa basis_add_executable_target(), basis_add_library_target()
+option (BASIS_UNITY_BUILD "Enable unity builds of C++ targets by default (requires CMake 3.16)." OFF)
+mark_as_advanced (BASIS_UNITY_BUILD)
+
+## @brief Default maximum number of C++ source files compiled as one unity source.
+#
+# A value of 0 combines all source files of a target into one unity source.
+set (BASIS_UNITY_BUILD_BATCH_SIZE 8 CACHE STRING "Default maximum number of C++ source files compiled as one unity source.")
+mark_as_advanced (BASIS_UNITY_BUILD_BATCH_SIZE)
+
+## @brief Precompile the BASIS unit testing header for C++ unit tests.
+#
+# If enabled, basis_add_test() precompiles the basis/test.h header, which
+# includes the Google Test and Mock headers, once per project and reuses it
+# for each C++ unit test unless the @c PRECOMPILE_HEADERS or
+# @c NO_PRECOMPILE_HEADERS option is given. Requires CMake 3.16 or later.
+#
+# @sa basis_add_test()
+option (BASIS_PRECOMPILE_TEST_HEADERS "Precompile basis/test.h header for C++ unit tests (requires CMake 3.16)." OFF)
+mark_as_advanced (BASIS_PRECOMPILE_TEST_HEADERS)
+
+if (CMAKE_VERSION VERSION_LESS 3.16 AND (BASIS_UNITY_BUILD OR BASIS_PRECOMPILE_TEST_HEADERS))
+  message (WARNING "Options BASIS_UNITY_BUILD and BASIS_PRECOMPILE_TEST_HEADERS require CMake 3.16 or later and are ignored.")
+endif ()
+
 
 ## @brief Enable the installation of scripted modules in site specific default directories.
 #
@@ -833,6 +884,23 @@ mark_as_advanced (BASIS_VERBOSE)
 option (BASIS_DEBUG "Request BASIS functions to help debugging." OFF)
 mark_as_advanced (BASIS_DEBUG)
 
+## @brief Request profile of BASIS functions called during the configure step.
+#
+# The profile is written to BasisConfigureProfile.json in the Chrome trace
+# event format and summarized in BasisConfigureProfile.txt. Requires CMake 3.13
+# or newer. The time of execute_process() calls is only recorded with CMake 3.18
+# or newer and timestamps have a resolution of one second before CMake 3.23.
+option (BASIS_PROFILE_CONFIGURE "Request profile of BASIS functions called during the configure step." OFF)
+mark_as_advanced (BASIS_PROFILE_CONFIGURE)
+
+## @brief Directory of files caching the results of probing external tools.
+#
+# The versions of interpreters and MATLAB are determined only once for each
+# executable until it is modified. A super-build passes this directory on to
+# its sub-projects. Set to an empty string to disable the cache.
+set (BASIS_PROBE_CACHE_DIR "${CMAKE_BINARY_DIR}/CMakeFiles/BasisProbeCache" CACHE PATH "Directory of files caching the results of probing external tools.")
+mark_as_advanced (BASIS_PROBE_CACHE_DIR)
+
 ## @brief Request configuration of software build only, skipping steps related to packaging and installation.
 option (BASIS_BUILD_ONLY "Request configuration of software build only, skipping steps related to packaging and installation." OFF)
 mark_as_advanced (BASIS_BUILD_ONLY)
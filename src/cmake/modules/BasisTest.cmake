@@ -276,6 +276,22 @@ endfunction ()
 # ----------------------------------------------------------------------------
 ## @brief Create and add a test driver executable.
 #
+# Besides running a single test, the test driver can run several of its tests
+# one after another within the same process, which avoids the repeated setup
+# of the test driver. Each test is run in a subdirectory of the working
+# directory named after the test. Example:
+# @code
+# basis_add_test_driver (mydriver test1.cxx test2.cxx test3.cxx)
+# basis_add_test (mytests COMMAND mydriver --batch test1 test2 test3)
+# @endcode
+# Alternatively, the names and arguments of the tests can be listed in a
+# file, one test per line, which is given to the driver using --batch-file.
+#
+# The options @c PRECOMPILE_HEADERS, @c [NO_]UNITY_BUILD and
+# @c UNITY_BUILD_BATCH_SIZE are passed on to basis_add_executable().
+# Note that a unity build requires that the tests do not define functions
+# or variables with internal linkage of the same name.
+#
 # @param [in] TESTDRIVER_NAME Name of the test driver.
 # @param [in] ARGN            List of source files implementing tests.
 #
@@ -284,9 +300,9 @@ function (basis_add_test_driver TESTDRIVER_NAME)
   # parse arguments
   CMAKE_PARSE_ARGUMENTS (
     ARGN
-      ""
-      "EXTRA_INCLUDE;FUNCTION"
-      ""
+      "UNITY_BUILD;NO_UNITY_BUILD"
+      "EXTRA_INCLUDE;FUNCTION;UNITY_BUILD_BATCH_SIZE"
+      "PRECOMPILE_HEADERS"
     ${ARGN}
   )
   if (ARGN_EXTRA_INCLUDE OR ARGN_FUNCTION)
@@ -296,7 +312,7 @@ function (basis_add_test_driver TESTDRIVER_NAME)
   endif ()
   # choose test driver implementation depending on which packages are available
   set (TESTDRIVER_INCLUDE      "basis/testdriver.h")
-  set (TESTDRIVER_LINK_DEPENDS basis.basis)
+  set (TESTDRIVER_LINK_DEPENDS basis)
   if (ITK_FOUND)
     basis_include_directories (BEFORE ${ITK_INCLUDE_DIRS})
     list (APPEND TESTDRIVER_LINK_DEPENDS ${ITK_LIBRARIES})
@@ -318,7 +334,20 @@ function (basis_add_test_driver TESTDRIVER_NAME)
       FUNCTION      testdriversetup
   )
   # add test driver executable
-  basis_add_executable (${TESTDRIVER_NAME} ${TESTDRIVER_SOURCES})
+  set (OPTS)
+  if (ARGN_PRECOMPILE_HEADERS)
+    list (APPEND OPTS PRECOMPILE_HEADERS ${ARGN_PRECOMPILE_HEADERS})
+  endif ()
+  if (ARGN_UNITY_BUILD)
+    list (APPEND OPTS UNITY_BUILD)
+  endif ()
+  if (ARGN_NO_UNITY_BUILD)
+    list (APPEND OPTS NO_UNITY_BUILD)
+  endif ()
+  if (NOT "${ARGN_UNITY_BUILD_BATCH_SIZE}" STREQUAL "")
+    list (APPEND OPTS UNITY_BUILD_BATCH_SIZE ${ARGN_UNITY_BUILD_BATCH_SIZE})
+  endif ()
+  basis_add_executable (${TESTDRIVER_NAME} ${TESTDRIVER_SOURCES} ${OPTS})
   basis_target_link_libraries (${TESTDRIVER_NAME} ${TESTDRIVER_LINK_DEPENDS})
   if (ITK_FOUND)
     basis_set_target_properties (
@@ -339,6 +368,35 @@ function (basis_add_test_driver TESTDRIVER_NAME)
   endif ()
 endfunction ()
 
+# ----------------------------------------------------------------------------
+## @brief Add target which precompiles the header of C++ unit tests.
+#
+# Used by basis_add_test() when @c BASIS_PRECOMPILE_TEST_HEADERS is enabled.
+# The object library is added by the first call. It precompiles the header
+# <tt>basis/test.h</tt> once, and the unit tests reuse its precompiled header
+# instead of each building their own. The library is linked to
+# @c BASIS_TEST_LIBRARY such that its source file is compiled with the same
+# definitions and include directories as the unit tests. Requires CMake 3.16.
+#
+# @param [out] TARGET_UID Name of output variable set to the UID of the target.
+function (_basis_add_test_pch_target TARGET_UID)
+  basis_make_target_uid (UID "precompiled_test_headers")
+  if (NOT TARGET "${UID}")
+    set (SOURCE "${PROJECT_BINARY_DIR}/CMakeFiles/precompiled_test_headers.cxx")
+    if (NOT EXISTS "${SOURCE}")
+      file (WRITE "${SOURCE}" "// precompiled header of unit tests added by basis_add_test()\n")
+    endif ()
+    add_library (${UID} OBJECT "${SOURCE}")
+    set_target_properties (${UID} PROPERTIES EXCLUDE_FROM_ALL TRUE)
+    basis_get_target_uid (TEST_LIBRARY_UID "${BASIS_TEST_LIBRARY}")
+    if (TARGET "${TEST_LIBRARY_UID}")
+      target_link_libraries (${UID} PRIVATE ${TEST_LIBRARY_UID})
+    endif ()
+    target_precompile_headers (${UID} PRIVATE "<basis/test.h>")
+  endif ()
+  set (${TARGET_UID} "${UID}" PARENT_SCOPE)
+endfunction ()
+
 # ----------------------------------------------------------------------------
 ## @brief Add test.
 #
@@ -448,6 +506,28 @@ endfunction ()
 #     <td>Do not strip extension if test name is derived from source file name.</td>
 #   </tr>
 #   <tr>
+#     @tp @b PRECOMPILE_HEADERS header1 [header2...] @endtp
+#     <td>Headers to precompile for the test executable built from C++ sources.
+#         If neither this nor the @p NO_PRECOMPILE_HEADERS option is given and
+#         @c BASIS_PRECOMPILE_TEST_HEADERS is enabled, C++ unit tests reuse the
+#         precompiled <tt>basis/test.h</tt> header of a helper target which
+#         is added by the first such test.</td>
+#   </tr>
+#   <tr>
+#     @tp @b NO_PRECOMPILE_HEADERS @endtp
+#     <td>Do not precompile <tt>basis/test.h</tt> for this unit test.</td>
+#   </tr>
+#   <tr>
+#     @tp @b [NO_]UNITY_BUILD @endtp
+#     <td>Whether to compile the C++ sources of the test executable in batches.
+#         (default: @c BASIS_UNITY_BUILD)</td>
+#   </tr>
+#   <tr>
+#     @tp @b UNITY_BUILD_BATCH_SIZE n @endtp
+#     <td>Maximum number of C++ source files compiled as one unity source.
+#         (default: @c BASIS_UNITY_BUILD_BATCH_SIZE)</td>
+#   </tr>
+#   <tr>
 #     @tp @b ARGN @endtp
 #     <td>All other arguments are passed on to basis_add_executable() if
 #         an executable target for the test is added.</td>
@@ -474,9 +554,9 @@ function (basis_add_test TEST_NAME)
   # parse arguments
   CMAKE_PARSE_ARGUMENTS (
     ARGN
-    "UNITTEST;NO_DEFAULT_MAIN;WITH_EXT;CLEAN_WORKING_DIRECTORY_BEFORE_TEST;CLEAN_WORKING_DIRECTORY_AFTER_TEST"
-    "WORKING_DIRECTORY"
-    "CONFIGURATIONS;SOURCES;LINK_DEPENDS;COMMAND;ARGS"
+    "UNITTEST;NO_DEFAULT_MAIN;WITH_EXT;NO_PRECOMPILE_HEADERS;UNITY_BUILD;NO_UNITY_BUILD;CLEAN_WORKING_DIRECTORY_BEFORE_TEST;CLEAN_WORKING_DIRECTORY_AFTER_TEST"
+    "WORKING_DIRECTORY;UNITY_BUILD_BATCH_SIZE"
+    "CONFIGURATIONS;SOURCES;LINK_DEPENDS;COMMAND;ARGS;PRECOMPILE_HEADERS"
     ${ARGN}
   )
 
@@ -521,6 +601,7 @@ function (basis_add_test TEST_NAME)
   # --------------------------------------------------------------------------
   # build test executable
   set (LANGUAGE)
+  set (PCH_UID)
   if (ARGN_SOURCES)
     if (ARGN_UNITTEST)
       basis_get_source_language (LANGUAGE ${ARGN_SOURCES})
@@ -545,6 +626,10 @@ function (basis_add_test TEST_NAME)
                                  " before using the basis_add_test command.")
           endif ()
         endif ()
+        if (BASIS_PRECOMPILE_TEST_HEADERS AND NOT ARGN_PRECOMPILE_HEADERS AND NOT ARGN_NO_PRECOMPILE_HEADERS
+            AND NOT CMAKE_VERSION VERSION_LESS 3.16)
+          _basis_add_test_pch_target (PCH_UID)
+        endif ()
         if (BASIS_TEST_LIBRARY)
           list (APPEND ARGN_LINK_DEPENDS "${BASIS_TEST_LIBRARY}")
         else ()
@@ -557,10 +642,26 @@ function (basis_add_test TEST_NAME)
       endif ()
     endif ()
 
+    if (ARGN_PRECOMPILE_HEADERS)
+      list (APPEND ARGN_UNPARSED_ARGUMENTS PRECOMPILE_HEADERS ${ARGN_PRECOMPILE_HEADERS})
+    endif ()
+    if (ARGN_UNITY_BUILD)
+      list (APPEND ARGN_UNPARSED_ARGUMENTS UNITY_BUILD)
+    endif ()
+    if (ARGN_NO_UNITY_BUILD)
+      list (APPEND ARGN_UNPARSED_ARGUMENTS NO_UNITY_BUILD)
+    endif ()
+    if (NOT "${ARGN_UNITY_BUILD_BATCH_SIZE}" STREQUAL "")
+      list (APPEND ARGN_UNPARSED_ARGUMENTS UNITY_BUILD_BATCH_SIZE ${ARGN_UNITY_BUILD_BATCH_SIZE})
+    endif ()
     basis_add_executable (${TEST_NAME} ${ARGN_SOURCES} ${ARGN_UNPARSED_ARGUMENTS})
     if (ARGN_LINK_DEPENDS)
       basis_target_link_libraries (${TEST_NAME} ${ARGN_LINK_DEPENDS})
     endif ()
+    if (PCH_UID)
+      basis_get_target_uid (TEST_TARGET_UID "${TEST_NAME}")
+      target_precompile_headers (${TEST_TARGET_UID} REUSE_FROM ${PCH_UID})
+    endif ()
 
     if (ARGN_COMMAND)
       basis_set_target_properties (${TEST_NAME} PROPERTIES OUTPUT_NAME ${CMD})
@@ -635,6 +736,124 @@ function (basis_add_test TEST_NAME)
   message (STATUS "Adding test ${TEST_UID}... - done")
 endfunction ()
 
+# ----------------------------------------------------------------------------
+## @brief Add microbenchmark.
+#
+# This command builds an executable from the given sources which implement
+# benchmarks using the macros of the @c basis/benchmark.h header file, and
+# adds a test which runs these benchmarks. The executable is linked to the
+# BASIS benchmark library which includes a default implementation of the
+# main() function. The results of the benchmarks are written to the JSON file
+# @c TESTING_OUTPUT_DIR / @p BENCHMARK_NAME .json. A copy of this file can be
+# added to the source tree and used as baseline of subsequent runs, in which
+# case the test fails if the median time of a benchmark exceeds its baseline
+# by more than the given threshold ratio. Benchmark tests are run serially
+# and labeled @c Benchmark such that they can be selected or excluded using
+# the -L and -LE options of ctest. Example:
+# @code
+# basis_add_benchmark (bench_path.cxx LINK_DEPENDS basis BASELINE bench_path.json)
+# @endcode
+#
+# @param [in] BENCHMARK_NAME Name of the benchmark test. If a source file is
+#                            given as first argument, the test name is derived
+#                            from the name of this source file and the source
+#                            file is added to the list of sources.
+# @param [in] ARGN           The following parameters are parsed:
+# @par
+# <table border="0">
+#   <tr>
+#     @tp @b SOURCES file1 [file2 ...] @endtp
+#     <td>Source files implementing the benchmarks.</td>
+#   </tr>
+#   <tr>
+#     @tp @b LINK_DEPENDS file1|target1 [file2|target2 ...] @endtp
+#     <td>Link dependencies of benchmark executable.</td>
+#   </tr>
+#   <tr>
+#     @tp @b BASELINE file @endtp
+#     <td>JSON file with results of a previous run. A relative path is
+#         relative to the current source directory. A missing file is
+#         ignored, i.e., results are not compared in this case.</td>
+#   </tr>
+#   <tr>
+#     @tp @b THRESHOLD ratio @endtp
+#     <td>Maximum ratio of median time to baseline median time. (default: 1.5)</td>
+#   </tr>
+#   <tr>
+#     @tp @b REPETITIONS n @endtp
+#     <td>Number of timed repetitions of each benchmark. (default: 10)</td>
+#   </tr>
+#   <tr>
+#     @tp @b WARMUP n @endtp
+#     <td>Number of warm-up repetitions of each benchmark. (default: 1)</td>
+#   </tr>
+#   <tr>
+#     @tp @b MIN_TIME ms @endtp
+#     <td>Minimum time of each repetition in milliseconds. (default: 10)</td>
+#   </tr>
+#   <tr>
+#     @tp @b ARGS arg1 [arg2 ...] @endtp
+#     <td>Additional arguments of the benchmark executable.</td>
+#   </tr>
+#   <tr>
+#     @tp @b ARGN @endtp
+#     <td>All other arguments are passed on to basis_add_test().</td>
+#   </tr>
+# </table>
+#
+# @returns Adds build target for benchmark executable and a CTest test which runs it.
+#
+# @sa basis_add_test()
+#
+# @ingroup CMakeAPI
+function (basis_add_benchmark BENCHMARK_NAME)
+  CMAKE_PARSE_ARGUMENTS (
+    ARGN
+      "WITH_EXT"
+      "BASELINE;THRESHOLD;REPETITIONS;WARMUP;MIN_TIME"
+      "SOURCES;LINK_DEPENDS;ARGS"
+    ${ARGN}
+  )
+  if (NOT BASIS_BENCHMARK_LIBRARY)
+    message (FATAL_ERROR "Benchmark ${BENCHMARK_NAME} added, but BASIS_BENCHMARK_LIBRARY not set."
+                         " This library is part of the CMake BASIS installation.")
+  endif ()
+  # benchmark name
+  if (NOT ARGN_SOURCES)
+    get_filename_component (ARGN_SOURCES "${BENCHMARK_NAME}" ABSOLUTE)
+    if (ARGN_WITH_EXT)
+      basis_get_source_target_name (BENCHMARK_NAME "${BENCHMARK_NAME}" NAME)
+      list (APPEND ARGN_UNPARSED_ARGUMENTS WITH_EXT)
+    else ()
+      basis_get_source_target_name (BENCHMARK_NAME "${BENCHMARK_NAME}" NAME_WE)
+    endif ()
+  endif ()
+  # arguments of benchmark executable
+  set (ARGS "--benchmark_output=${TESTING_OUTPUT_DIR}/${BENCHMARK_NAME}.json")
+  if (ARGN_BASELINE)
+    if (NOT IS_ABSOLUTE "${ARGN_BASELINE}")
+      set (ARGN_BASELINE "${CMAKE_CURRENT_SOURCE_DIR}/${ARGN_BASELINE}")
+    endif ()
+    list (APPEND ARGS "--benchmark_baseline=${ARGN_BASELINE}")
+  endif ()
+  foreach (OPT THRESHOLD REPETITIONS WARMUP MIN_TIME)
+    if (ARGN_${OPT})
+      string (TOLOWER "${OPT}" FLAG)
+      list (APPEND ARGS "--benchmark_${FLAG}=${ARGN_${OPT}}")
+    endif ()
+  endforeach ()
+  list (APPEND ARGS ${ARGN_ARGS})
+  # add benchmark executable and test
+  basis_add_test (
+    ${BENCHMARK_NAME}
+      SOURCES      ${ARGN_SOURCES}
+      LINK_DEPENDS ${ARGN_LINK_DEPENDS} ${BASIS_BENCHMARK_LIBRARY}
+      ARGS         ${ARGS}
+      ${ARGN_UNPARSED_ARGUMENTS}
+  )
+  basis_set_tests_properties (${BENCHMARK_NAME} PROPERTIES RUN_SERIAL TRUE LABELS Benchmark)
+endfunction ()
+
 # ----------------------------------------------------------------------------
 ## @brief Add tests of default options for given executable.
 #
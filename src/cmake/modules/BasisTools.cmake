@@ -41,6 +41,7 @@ include ("${CMAKE_CURRENT_LIST_DIR}/TopologicalSort.cmake")
 
 # ----------------------------------------------------------------------------
 # BASIS modules
+include ("${CMAKE_CURRENT_LIST_DIR}/ProfileTools.cmake") # first to profile execute_process()
 include ("${CMAKE_CURRENT_LIST_DIR}/CommonTools.cmake")
 include ("${CMAKE_CURRENT_LIST_DIR}/DocTools.cmake")
 include ("${CMAKE_CURRENT_LIST_DIR}/InterpTools.cmake")
@@ -1379,20 +1379,21 @@ endfunction ()
 # @returns See @c [out] parameters.
 function (basis_version_numbers VERSION MAJOR MINOR PATCH)
   if (VERSION MATCHES "([0-9]+)(\\.[0-9]+)?(\\.[0-9]+)?(rc[1-9][0-9]*|[a-z]+)?")
+    # string(REGEX) resets the CMAKE_MATCH_<n> variables
+    set (MATCH_2 "${CMAKE_MATCH_2}")
+    set (MATCH_3 "${CMAKE_MATCH_3}")
     if (CMAKE_MATCH_1)
       set (VERSION_MAJOR ${CMAKE_MATCH_1})
     else ()
       set (VERSION_MAJOR 0)
     endif ()
-    if (CMAKE_MATCH_2)
-      set (VERSION_MINOR ${CMAKE_MATCH_2})
-      string (REGEX REPLACE "^\\." "" VERSION_MINOR "${VERSION_MINOR}")
+    if (MATCH_2)
+      string (REGEX REPLACE "^\\." "" VERSION_MINOR "${MATCH_2}")
     else ()
       set (VERSION_MINOR 0)
     endif ()
-    if (CMAKE_MATCH_3)
-      set (VERSION_PATCH ${CMAKE_MATCH_3})
-      string (REGEX REPLACE "^\\." "" VERSION_PATCH "${VERSION_PATCH}")
+    if (MATCH_3)
+      string (REGEX REPLACE "^\\." "" VERSION_PATCH "${MATCH_3}")
     else ()
       set (VERSION_PATCH 0)
     endif ()
@@ -1406,6 +1407,78 @@ function (basis_version_numbers VERSION MAJOR MINOR PATCH)
   set ("${PATCH}" "${VERSION_PATCH}" PARENT_SCOPE)
 endfunction ()
 
+# ----------------------------------------------------------------------------
+## @brief Get path of file storing the cached result of probing an executable.
+#
+# The name of the file is derived from the name of the probe and the real path,
+# modification time, and size of the executable (the latter only with CMake
+# 3.14 or newer). Hence, the executable is probed again once it was modified.
+#
+# @param [out] FILE       Path of cache file or empty string if the results
+#                         of probes are not cached or the executable does
+#                         not exist.
+# @param [in]  PROBE      Name of probe, e.g., "python_version".
+# @param [in]  EXECUTABLE Path of probed executable.
+function (basis_get_probe_cache_file FILE PROBE EXECUTABLE)
+  set (${FILE} "" PARENT_SCOPE)
+  if (NOT BASIS_PROBE_CACHE_DIR OR NOT EXECUTABLE)
+    return ()
+  endif ()
+  get_filename_component (EXECUTABLE "${EXECUTABLE}" REALPATH)
+  if (NOT EXISTS "${EXECUTABLE}" OR IS_DIRECTORY "${EXECUTABLE}")
+    return ()
+  endif ()
+  file (TIMESTAMP "${EXECUTABLE}" MTIME "%Y-%m-%dT%H:%M:%S" UTC)
+  if (CMAKE_VERSION VERSION_LESS 3.14)
+    set (SIZE)
+  else ()
+    file (SIZE "${EXECUTABLE}" SIZE)
+  endif ()
+  string (MD5 KEY "${PROBE}|${EXECUTABLE}|${MTIME}|${SIZE}")
+  set (${FILE} "${BASIS_PROBE_CACHE_DIR}/${PROBE}-${KEY}.txt" PARENT_SCOPE)
+endfunction ()
+
+# ----------------------------------------------------------------------------
+## @brief Get cached result of probing an executable.
+#
+# Probing an external tool such as querying the version of an interpreter
+# or MATLAB can take a considerable amount of time. The results of such
+# probes are therefore stored in the directory @c BASIS_PROBE_CACHE_DIR,
+# which is shared by the sub-projects of a super-build.
+#
+# @param [out] VALUE      Cached result or empty string if the executable
+#                         has not been probed since it was last modified.
+# @param [in]  PROBE      Name of probe, e.g., "python_version".
+# @param [in]  EXECUTABLE Path of probed executable.
+#
+# @sa basis_set_probe_cache()
+function (basis_get_probe_cache VALUE PROBE EXECUTABLE)
+  basis_get_probe_cache_file (FILE "${PROBE}" "${EXECUTABLE}")
+  if (FILE AND EXISTS "${FILE}")
+    file (READ "${FILE}" CONTENT)
+  else ()
+    set (CONTENT)
+  endif ()
+  set (${VALUE} "${CONTENT}" PARENT_SCOPE)
+endfunction ()
+
+# ----------------------------------------------------------------------------
+## @brief Cache result of probing an executable.
+#
+# @param [in] PROBE      Name of probe, e.g., "python_version".
+# @param [in] EXECUTABLE Path of probed executable.
+# @param [in] VALUE      Result of probe. Empty results are not cached.
+#
+# @sa basis_get_probe_cache()
+function (basis_set_probe_cache PROBE EXECUTABLE VALUE)
+  if (NOT VALUE STREQUAL "")
+    basis_get_probe_cache_file (FILE "${PROBE}" "${EXECUTABLE}")
+    if (FILE)
+      file (WRITE "${FILE}" "${VALUE}")
+    endif ()
+  endif ()
+endfunction ()
+
 # ============================================================================
 # set
 # ============================================================================
@@ -1655,6 +1728,104 @@ function (basis_write_list FILENAME VARIABLE)
   file (APPEND "${FILENAME}" ")\n")
 endfunction ()
 
+# ----------------------------------------------------------------------------
+## @brief Configure files whose input or referenced variables were modified.
+#
+# Each input file is configured using configure_file() with the \@ONLY
+# option. The given manifest file records for each output file the input
+# file, its modification time, the names of the variables referenced by
+# it, i.e., <tt>\@VAR\@</tt> and <tt>\#cmakedefine VAR</tt>, and a hash
+# of the values of these variables. A file is only configured again when
+# its input file, its modification time, or the hash changed, or when the
+# output file does not exist. Output files recorded in the manifest which
+# are no longer in the list of output files are removed.
+#
+# The modification time of an input file is not recorded when it was
+# modified during the current second, because a later modification would
+# not change it. Files are always configured when CMake is older than 3.0,
+# because the input files of skipped files cannot be added to the
+# @c CMAKE_CONFIGURE_DEPENDS directory property.
+#
+# @param [in] MANIFEST Path of manifest file.
+# @param [in] ARGN     Input files following the @c INPUTS keyword and
+#                      corresponding output files following the @c OUTPUTS keyword.
+function (basis_configure_files MANIFEST)
+  CMAKE_PARSE_ARGUMENTS (ARGN "" "" "INPUTS;OUTPUTS" ${ARGN})
+  list (LENGTH ARGN_INPUTS  N)
+  list (LENGTH ARGN_OUTPUTS M)
+  if (NOT N EQUAL M)
+    message (FATAL_ERROR "basis_configure_files(): Number of INPUTS and OUTPUTS differs!")
+  endif ()
+  string (TIMESTAMP START)
+  # read previous manifest
+  set (CONFIGURED_FILES)
+  if (EXISTS "${MANIFEST}")
+    include ("${MANIFEST}")
+  endif ()
+  # configure modified files
+  set (_MANIFEST "# Automatically generated. Do not edit this file!\n")
+  set (I 0)
+  foreach (OUTPUT IN LISTS ARGN_OUTPUTS)
+    list (GET ARGN_INPUTS ${I} INPUT)
+    math (EXPR I "${I} + 1")
+    list (FIND CONFIGURED_FILES "${OUTPUT}" J)
+    set (MODIFIED TRUE)
+    if (NOT J EQUAL -1 AND EXISTS "${OUTPUT}" AND NOT CMAKE_VERSION VERSION_LESS 3.0)
+      file (TIMESTAMP "${INPUT}" TIME)
+      if ("^${INPUT}$" STREQUAL "^${CONFIGURED_FILE_${J}_INPUT}$" AND TIME AND "${TIME}" STREQUAL "${CONFIGURED_FILE_${J}_TIMESTAMP}")
+        set (VARIABLES "${CONFIGURED_FILE_${J}_VARIABLES}")
+        set (VALUES)
+        foreach (V IN LISTS VARIABLES)
+          set (VALUES "${VALUES}${V}=${${V}}\n")
+        endforeach ()
+        string (SHA1 HASH "${VALUES}")
+        if (HASH STREQUAL "${CONFIGURED_FILE_${J}_HASH}")
+          set (MODIFIED FALSE)
+        endif ()
+      endif ()
+    endif ()
+    if (MODIFIED)
+      file (TIMESTAMP "${INPUT}" TIME)
+      if (NOT TIME STRLESS START)
+        set (TIME)
+      endif ()
+      configure_file ("${INPUT}" "${OUTPUT}" @ONLY)
+      file (READ "${INPUT}" CONTENT)
+      string (REGEX MATCHALL "@[a-zA-Z0-9_.+-]+@|#cmakedefine(01)?[ \t]+[a-zA-Z0-9_]+" VARIABLES "${CONTENT}")
+      string (REGEX REPLACE "@|#cmakedefine(01)?[ \t]+" "" VARIABLES "${VARIABLES}")
+      if (VARIABLES)
+        list (REMOVE_DUPLICATES VARIABLES)
+      endif ()
+      set (VALUES)
+      foreach (V IN LISTS VARIABLES)
+        set (VALUES "${VALUES}${V}=${${V}}\n")
+      endforeach ()
+      string (SHA1 HASH "${VALUES}")
+    else ()
+      # re-configure upon modification of input file as done by configure_file()
+      set_property (DIRECTORY APPEND PROPERTY CMAKE_CONFIGURE_DEPENDS "${INPUT}")
+    endif ()
+    math (EXPR K "${I} - 1")
+    set (_MANIFEST "${_MANIFEST}set (CONFIGURED_FILE_${K}_INPUT     \"${INPUT}\")\n")
+    set (_MANIFEST "${_MANIFEST}set (CONFIGURED_FILE_${K}_TIMESTAMP \"${TIME}\")\n")
+    set (_MANIFEST "${_MANIFEST}set (CONFIGURED_FILE_${K}_VARIABLES \"${VARIABLES}\")\n")
+    set (_MANIFEST "${_MANIFEST}set (CONFIGURED_FILE_${K}_HASH      \"${HASH}\")\n")
+  endforeach ()
+  # remove output files which are no longer configured
+  foreach (OUTPUT IN LISTS CONFIGURED_FILES)
+    list (FIND ARGN_OUTPUTS "${OUTPUT}" J)
+    if (J EQUAL -1)
+      file (REMOVE "${OUTPUT}")
+    endif ()
+  endforeach ()
+  # write new manifest
+  set (_MANIFEST "${_MANIFEST}set (CONFIGURED_FILES\n")
+  foreach (OUTPUT IN LISTS ARGN_OUTPUTS)
+    set (_MANIFEST "${_MANIFEST}  \"${OUTPUT}\"\n")
+  endforeach ()
+  file (WRITE "${MANIFEST}" "${_MANIFEST})\n")
+endfunction ()
+
 # ----------------------------------------------------------------------------
 ## @brief Set a named property in a given scope.
 #
@@ -2667,6 +2838,119 @@ macro (basis_compile_python_modules_for_jython FLAG)
   endif ()
 endmacro ()
 
+# ----------------------------------------------------------------------------
+## @brief Evaluate globbing expressions.
+#
+# The pattern <tt>**</tt> in a glob expression is replaced by a single
+# <tt>*</tt> and the recursive version, i.e., <tt>file(GLOB_RECURSE)</tt>,
+# is used instead. Hidden files and files in .svn or .git directories are
+# excluded. Generator expressions and file paths are preserved.
+#
+# @param [out] SOURCES List of absolute source paths.
+# @param [in]  ARGN    Absolute file paths and/or globbing expressions.
+#
+# @sa basis_add_glob_target()
+function (basis_glob_source_files SOURCES)
+  set (FILES)
+  foreach (EXPRESSION IN LISTS ARGN)
+    if (EXPRESSION MATCHES "^\\$<") # preserve generator expressions
+      list (APPEND FILES "${EXPRESSION}")
+    elseif (EXPRESSION MATCHES "[*][*]")
+      string (REPLACE "**" "*" EXPRESSION "${EXPRESSION}")
+      file (GLOB_RECURSE _FILES "${EXPRESSION}")
+      list (APPEND FILES ${_FILES})
+    elseif (EXPRESSION MATCHES "[*?]|\\[[0-9]+-[0-9]+\\]")
+      file (GLOB _FILES "${EXPRESSION}")
+      list (APPEND FILES ${_FILES})
+    else ()
+      list (APPEND FILES "${EXPRESSION}")
+    endif ()
+  endforeach ()
+  if (FILES)
+    list (REMOVE_DUPLICATES FILES)
+  endif ()
+  set (_FILES)
+  foreach (FILE IN LISTS FILES)
+    if (FILE MATCHES "^\\$<")
+      list (APPEND _FILES "${FILE}")
+    else ()
+      get_filename_component (FILE_NAME "${FILE}" NAME)
+      if (NOT FILE MATCHES "(^|/).(svn|git)/" AND NOT FILE_NAME MATCHES "^\\.")
+        list (APPEND _FILES "${FILE}")
+      endif ()
+    endif ()
+  endforeach ()
+  set (${SOURCES} "${_FILES}" PARENT_SCOPE)
+endfunction ()
+
+# ----------------------------------------------------------------------------
+## @brief Get modification times of directories searched by globbing expressions.
+#
+# Adding, removing, or renaming a file changes the modification time of the
+# directory containing it. Hence, as long as the modification times of all
+# directories searched by the globbing expressions are unchanged, the result
+# of basis_glob_source_files() is unchanged as well. This function must be
+# called before the source files are globbed. The output lists are empty when
+# the directories cannot be determined, i.e., when a glob expression
+# searches subdirectories and CMake is older than 3.3, or when one of the
+# directories was modified during the current second, i.e., a later
+# modification would not change its timestamp.
+#
+# @param [out] DIRECTORIES List of searched directories.
+# @param [out] TIMESTAMPS  Modification times of these directories.
+# @param [in]  ARGN        Absolute file paths and/or globbing expressions.
+#
+# @sa basis_add_glob_target()
+function (basis_get_glob_timestamps DIRECTORIES TIMESTAMPS)
+  string (TIMESTAMP START)
+  set (DIRS)
+  set (RECURSED) # root directories whose subdirectories were already listed
+  foreach (EXPRESSION IN LISTS ARGN)
+    if (NOT EXPRESSION MATCHES "^\\$<" AND EXPRESSION MATCHES "[*?[]")
+      # directory preceding first wildcard
+      string (REGEX REPLACE "[*?[].*$" "" PREFIX "${EXPRESSION}")
+      string (REGEX REPLACE "/[^/]*$" "" ROOT "${PREFIX}")
+      if (NOT ROOT)
+        set (ROOT "/")
+      endif ()
+      list (APPEND DIRS "${ROOT}")
+      # subdirectories if wildcards not only in file name or recursive
+      string (LENGTH "${ROOT}" N)
+      string (SUBSTRING "${EXPRESSION}" ${N} -1 REST)
+      list (FIND RECURSED "${ROOT}" IDX)
+      if (IDX EQUAL -1 AND (REST MATCHES "^/[^/]*/" OR EXPRESSION MATCHES "[*][*]"))
+        list (APPEND RECURSED "${ROOT}")
+        if (CMAKE_VERSION VERSION_LESS 3.3)
+          set (${DIRECTORIES} "" PARENT_SCOPE)
+          set (${TIMESTAMPS}  "" PARENT_SCOPE)
+          return ()
+        endif ()
+        file (GLOB_RECURSE SUBDIRS LIST_DIRECTORIES true "${ROOT}/*")
+        foreach (SUBDIR IN LISTS SUBDIRS)
+          if (IS_DIRECTORY "${SUBDIR}")
+            list (APPEND DIRS "${SUBDIR}")
+          endif ()
+        endforeach ()
+      endif ()
+    endif ()
+  endforeach ()
+  set (TIMES)
+  if (DIRS)
+    list (REMOVE_DUPLICATES DIRS)
+    foreach (DIR IN LISTS DIRS)
+      file (TIMESTAMP "${DIR}" TIME)
+      if (NOT TIME OR NOT TIME STRLESS START)
+        set (DIRS)
+        set (TIMES)
+        break ()
+      endif ()
+      list (APPEND TIMES "${TIME}")
+    endforeach ()
+  endif ()
+  set (${DIRECTORIES} "${DIRS}"  PARENT_SCOPE)
+  set (${TIMESTAMPS}  "${TIMES}" PARENT_SCOPE)
+endfunction ()
+
 # ----------------------------------------------------------------------------
 ## @brief Glob source files.
 #
@@ -2681,15 +2965,19 @@ endmacro ()
 # in a glob expression, it is replaced by a single <tt>*</tt> and the
 # recursive version, i.e., <tt>file(GLOB_RECURSE)</tt>, is used instead.
 #
+# The globbed targets are recorded in the @c GLOB_TARGETS project property.
+# Before each build, the single custom target added by basis_add_glob_check()
+# re-globs the source files of all these targets and compares them to the
+# initial list of source files. Directories whose modification time did not
+# change since the last check are not searched again.
+#
 # @param [in]  TARGET_UID UID of build target which builds the globbed source files.
-#                         The custom target which re-globs the source files
-#                         before each build of this target is named after this
-#                         build target with two leading underscores (__).
 # @param [out] SOURCES    List of absolute source paths.
 # @param [in]  ARGN       Input file paths and/or globbing expressions.
 #
 # @sa basis_add_executable()
 # @sa basis_add_library()
+# @sa basis_add_glob_check()
 function (basis_add_glob_target TARGET_UID SOURCES)
   # prepare globbing expressions
   # make paths absolute and turn directories into recursive globbing expressions
@@ -2718,47 +3006,80 @@ function (basis_add_glob_target TARGET_UID SOURCES)
     set (BUILD_DIR    "${CMAKE_CURRENT_BINARY_DIR}/CMakeFiles/${TARGET_UID}.dir")
     set (SOURCES_FILE "${BUILD_DIR}/sources.txt")
     # get initial list of source files
-    execute_process (
-      COMMAND "${CMAKE_COMMAND}"
-                  "-DEXPRESSIONS:STRING=${EXPRESSIONS}"
-                  "-DINIT:BOOLEAN=TRUE"
-                  "-DSOURCES_FILE:FILEPATH=${SOURCES_FILE}"
-                  -P "${BASIS_MODULE_PATH}/glob.cmake"
-      RESULT_VARIABLE RETVAL
-    )
-    if (NOT RETVAL EQUAL 0 OR NOT EXISTS "${SOURCES_FILE}")
-      message (FATAL_ERROR "Target ${TARGET_UID}: Failed to glob source files!")
-    endif ()
+    basis_get_glob_timestamps (DIRECTORIES TIMESTAMPS ${EXPRESSIONS})
+    basis_glob_source_files (INITIAL_SOURCES ${EXPRESSIONS})
+    basis_write_list ("${SOURCES_FILE}" INITIAL_SOURCES ${INITIAL_SOURCES})
+    basis_write_glob_file ("${BUILD_DIR}/glob.txt" ${TARGET_UID} "${EXPRESSIONS}" "${DIRECTORIES}" "${TIMESTAMPS}")
     # note that including this file here, which is modified whenever a
     # source file is added or removed, triggers a re-configuration of the
     # build system which is required to re-execute this function.
     include ("${SOURCES_FILE}")
     set (${SOURCES} "${INITIAL_SOURCES}" PARENT_SCOPE)
-    # add custom target to re-glob files before each build
-    set (ERRORMSG "You have either added, removed, or renamed a source file which"
-                  " matches one of the globbing expressions specified for the"
-                  " list of source files from which to build the ${TARGET_UID} target."
-                  " Therefore, the build system must be re-configured. Either try to"
-                  " build again which should trigger CMake and re-configure the build"
-                  " system or run CMake manually.")
-    basis_list_to_string (ERRORMSG ${ERRORMSG})
-    add_custom_target (
-      __${TARGET_UID}
-      COMMAND "${CMAKE_COMMAND}"
-                  "-DEXPRESSIONS:STRING=${EXPRESSIONS}"
-                  "-DINIT:BOOLEAN=FALSE"
-                  "-DSOURCES_FILE:FILEPATH=${SOURCES_FILE}"
-                  "-DERRORMSG:STRING=${ERRORMSG}"
-                  -P "${BASIS_MODULE_PATH}/glob.cmake"
-      COMMENT "Checking if source files for target ${TARGET_UID} were added or removed"
-      VERBATIM
-    )
+    # register target with the re-glob check before each build
+    basis_set_project_property (APPEND PROPERTY GLOB_TARGETS "${TARGET_UID}")
+    basis_set_project_property (APPEND PROPERTY GLOB_FILES   "${BUILD_DIR}/glob.txt")
   # otherwise, just return the given absolute source file paths
   else ()
     set (${SOURCES} "${EXPRESSIONS}" PARENT_SCOPE)
   endif ()
 endfunction ()
 
+# ----------------------------------------------------------------------------
+## @brief Write file with globbing expressions of target and directory timestamps.
+#
+# This file is read by glob.cmake, which rewrites it with updated timestamps
+# after it re-globbed the source files without finding a difference.
+#
+# @param [in] GLOB_FILE   Path of output file.
+# @param [in] TARGET_UID  UID of build target which builds the globbed source files.
+# @param [in] EXPRESSIONS Globbing expressions.
+# @param [in] DIRECTORIES Directories as returned by basis_get_glob_timestamps().
+# @param [in] TIMESTAMPS  Timestamps as returned by basis_get_glob_timestamps().
+function (basis_write_glob_file GLOB_FILE TARGET_UID EXPRESSIONS DIRECTORIES TIMESTAMPS)
+  file (WRITE "${GLOB_FILE}" "# Automatically generated. Do not edit this file!
+set (GLOB_TARGET      \"${TARGET_UID}\")
+set (GLOB_EXPRESSIONS \"${EXPRESSIONS}\")
+set (GLOB_DIRECTORIES \"${DIRECTORIES}\")
+set (GLOB_TIMESTAMPS  \"${TIMESTAMPS}\")
+")
+endfunction ()
+
+# ----------------------------------------------------------------------------
+## @brief Add custom target which checks the source files of all globbed targets.
+#
+# A single custom target named @c __glob is added which runs glob.cmake once
+# before each build to check whether source files matching the globbing
+# expressions of any of the targets added by basis_add_glob_target() were
+# added or removed. If so, the build system is re-configured. The globbed
+# targets already depend on this custom target. This function is called by
+# basis_project_end() of the top-level project.
+#
+# @sa basis_add_glob_target()
+function (basis_add_glob_check)
+  basis_get_project_property (GLOB_FILES PROPERTY GLOB_FILES)
+  if (NOT GLOB_FILES)
+    return ()
+  endif ()
+  set (MANIFEST "${PROJECT_BINARY_DIR}/CMakeFiles/BasisGlobFiles.txt")
+  basis_write_list ("${MANIFEST}" GLOB_FILES ${GLOB_FILES})
+  set (ERRORMSG "You have either added, removed, or renamed a source file which"
+                " matches one of the globbing expressions specified for the"
+                " list of source files from which to build the targets listed above."
+                " Therefore, the build system must be re-configured. Either try to"
+                " build again which should trigger CMake and re-configure the build"
+                " system or run CMake manually.")
+  basis_list_to_string (ERRORMSG ${ERRORMSG})
+  add_custom_target (
+    __glob
+    COMMAND "${CMAKE_COMMAND}"
+                "-DMANIFEST:FILEPATH=${MANIFEST}"
+                "-DERRORMSG:STRING=${ERRORMSG}"
+                -P "${BASIS_MODULE_PATH}/glob.cmake"
+    COMMENT "Checking if source files of globbed targets were added or removed"
+    VERBATIM
+  )
+endfunction ()
+
 # ----------------------------------------------------------------------------
 ## @brief Detect programming language of given source code files.
 #
@@ -250,7 +250,9 @@ while (RETRY)
       # on Windows where the Windows 2003 Resource Kit is not installed
       # See http://malektips.com/dos0017.html
       find_program (PING ping)
-      if (WIN32)
+      if (NOT PING)
+        message (WARNING "Cannot delay retries as neither sleep nor ping command is available!")
+      elseif (WIN32)
         execute_process (
           COMMAND ${PING} 127.0.0.1 -n ${RETRY_DELAY} -w 1000
           TIMEOUT ${RETRY_DELAY}
@@ -264,8 +266,6 @@ while (RETRY)
           ERROR_QUIET OUTPUT_QUIET
         )
       endif ()
-    else ()
-      message (WARNING "Cannot delay retries as neither sleep nor ping command is available!")
     endif ()
   endif ()
 endwhile ()
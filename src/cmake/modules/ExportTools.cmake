@@ -260,6 +260,7 @@ endfunction ()
 # ----------------------------------------------------------------------------
 ## @brief Export all targets added by basis_add_* commands.
 function (basis_export_targets)
+  basis_profile_begin (basis_export_targets)
   # parse arguments
   CMAKE_PARSE_ARGUMENTS (ARGN "" "FILE;CUSTOM_FILE" "" ${ARGN})
 
@@ -367,6 +368,7 @@ function (basis_export_targets)
     endif ()
 
   endif ()
+  basis_profile_end (basis_export_targets)
 endfunction ()
 
 
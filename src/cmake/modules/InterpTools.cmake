@@ -34,7 +34,10 @@ endif ()
 #                    @c PYTHON_VERSION_MINOR, and @c PYTHON_VERSION_PATCH are
 #                    set in the scope of the caller.
 function (basis_get_python_version)
-  if (PYTHON_EXECUTABLE)
+  basis_get_probe_cache (VERSION_STRING python_version "${PYTHON_EXECUTABLE}")
+  if (VERSION_STRING)
+    basis_version_numbers ("${VERSION_STRING}" VERSION_MAJOR VERSION_MINOR VERSION_PATCH)
+  elseif (PYTHON_EXECUTABLE)
     execute_process(
       COMMAND "${PYTHON_EXECUTABLE}" -E -c "import sys; sys.stdout.write(';'.join([str(x) for x in sys.version_info[:3]]))"
       OUTPUT_VARIABLE VERSION
@@ -49,6 +52,7 @@ function (basis_get_python_version)
       if (VERSION_PATCH EQUAL 0)
         string (REGEX REPLACE "\\.0$" "" VERSION_STRING "${VERSION_STRING}")
       endif()
+      basis_set_probe_cache (python_version "${PYTHON_EXECUTABLE}" "${VERSION_STRING}")
     else ()
       # sys.version predates sys.version_info
       execute_process (
@@ -66,6 +70,7 @@ function (basis_get_python_version)
         else ()
           set (VERSION_PATCH "0")
         endif()
+        basis_set_probe_cache (python_version "${PYTHON_EXECUTABLE}" "${VERSION_STRING}")
       else ()
         # sys.version was first documented for Python 1.5
         set (VERSION_STRING "1.4")
@@ -99,7 +104,10 @@ endfunction ()
 #                    @c JYTHON_VERSION_MINOR, and @c JYTHON_VERSION_PATCH are
 #                    set in the scope of the caller.
 function (basis_get_jython_version)
-  if (JYTHON_EXECUTABLE)
+  basis_get_probe_cache (VERSION_STRING jython_version "${JYTHON_EXECUTABLE}")
+  if (VERSION_STRING)
+    basis_version_numbers ("${VERSION_STRING}" VERSION_MAJOR VERSION_MINOR VERSION_PATCH)
+  elseif (JYTHON_EXECUTABLE)
     execute_process(
       COMMAND "${JYTHON_EXECUTABLE}" -c "import sys; sys.stdout.write(';'.join([str(x) for x in sys.version_info[:3]]))"
       OUTPUT_VARIABLE VERSION
@@ -114,6 +122,7 @@ function (basis_get_jython_version)
       if (VERSION_PATCH EQUAL 0)
         string (REGEX REPLACE "\\.0$" "" VERSION_STRING "${VERSION_STRING}")
       endif()
+      basis_set_probe_cache (jython_version "${JYTHON_EXECUTABLE}" "${VERSION_STRING}")
     else ()
       # sys.version predates sys.version_info
       execute_process (
@@ -131,6 +140,7 @@ function (basis_get_jython_version)
         else ()
           set (VERSION_PATCH "0")
         endif()
+        basis_set_probe_cache (jython_version "${JYTHON_EXECUTABLE}" "${VERSION_STRING}")
       else ()
         set (VERSION_STRING "0.0")
         set (VERSION_MAJOR  "0")
@@ -163,16 +173,20 @@ endfunction ()
 #                    @c PERL_VERSION_MINOR, and @c PERL_VERSION_PATCH are
 #                    set in the scope of the caller.
 function (basis_get_perl_version)
-  if (PERL_EXECUTABLE)
+  basis_get_probe_cache (VERSION_STRING perl_version "${PERL_EXECUTABLE}")
+  if (PERL_EXECUTABLE AND NOT VERSION_STRING)
     execute_process (COMMAND "${PERL_EXECUTABLE}" --version OUTPUT_VARIABLE VERSION)
   else ()
     set (VERSION)
   endif ()
-  if (VERSION MATCHES "[( ]v([0-9]+)\\.([0-9]+)\\.([0-9]+)[ )]")
+  if (VERSION_STRING)
+    basis_version_numbers ("${VERSION_STRING}" VERSION_MAJOR VERSION_MINOR VERSION_PATCH)
+  elseif (VERSION MATCHES "[( ]v([0-9]+)\\.([0-9]+)\\.([0-9]+)[ )]")
     set (VERSION_MAJOR "${CMAKE_MATCH_1}")
     set (VERSION_MINOR "${CMAKE_MATCH_2}")
     set (VERSION_PATCH "${CMAKE_MATCH_3}")
     set (VERSION_STRING "${VERSION_MAJOR}.${VERSION_MINOR}.${VERSION_PATCH}")
+    basis_set_probe_cache (perl_version "${PERL_EXECUTABLE}" "${VERSION_STRING}")
   else ()
     set (VERSION_STRING "0.0")
     set (VERSION_MAJOR  "0")
@@ -198,16 +212,20 @@ endfunction ()
 #                    @c BASH_VERSION_MINOR, and @c BASH_VERSION_PATCH are
 #                    set in the scope of the caller.
 function (basis_get_bash_version)
-  if (BASH_EXECUTABLE)
+  basis_get_probe_cache (VERSION_STRING bash_version "${BASH_EXECUTABLE}")
+  if (BASH_EXECUTABLE AND NOT VERSION_STRING)
     execute_process (COMMAND "${BASH_EXECUTABLE}" --version OUTPUT_VARIABLE VERSION)
   else ()
     set (VERSION)
   endif ()
-  if (VERSION MATCHES "version ([0-9]+)\\.([0-9]+)\\.([0-9]+)")
+  if (VERSION_STRING)
+    basis_version_numbers ("${VERSION_STRING}" VERSION_MAJOR VERSION_MINOR VERSION_PATCH)
+  elseif (VERSION MATCHES "version ([0-9]+)\\.([0-9]+)\\.([0-9]+)")
     set (VERSION_MAJOR "${CMAKE_MATCH_1}")
     set (VERSION_MINOR "${CMAKE_MATCH_2}")
     set (VERSION_PATCH "${CMAKE_MATCH_3}")
     set (VERSION_STRING "${VERSION_MAJOR}.${VERSION_MINOR}.${VERSION_PATCH}")
+    basis_set_probe_cache (bash_version "${BASH_EXECUTABLE}" "${VERSION_STRING}")
   else ()
     set (VERSION_STRING "0.0")
     set (VERSION_MAJOR  "0")
@@ -152,10 +152,15 @@ function (basis_get_full_matlab_version VERSION)
       return ()
     endif ()
   endif ()
+  # get MATLAB version from probe cache shared with other (sub-)projects
+  basis_get_probe_cache (_MATLAB_VERSION matlab_version "${MATLAB_EXECUTABLE}")
+  if (_MATLAB_VERSION)
+    set (${VERSION} "${_MATLAB_VERSION}" PARENT_SCOPE)
+    return ()
+  endif ()
   set (WORKING_DIR "${CMAKE_BINARY_DIR}/CMakeFiles")
   set (OUTPUT_FILE "${WORKING_DIR}/MatlabVersion.txt")
   # read MATLAB version from existing output file
-  set (_MATLAB_VERSION)
   if (EXISTS "${OUTPUT_FILE}")
     file (READ "${OUTPUT_FILE}" LINES)
     string (REGEX REPLACE "\n"    ";" LINES "${LINES}")
@@ -243,6 +248,7 @@ quit force
     endif ()
   endif ()
   # return
+  basis_set_probe_cache (matlab_version "${MATLAB_EXECUTABLE}" "${_MATLAB_VERSION}")
   set (${VERSION} "${_MATLAB_VERSION}" PARENT_SCOPE)
 endfunction ()
 
@@ -0,0 +1,300 @@
+# ============================================================================
+# Copyright (c) 2011-2012 University of Pennsylvania
+# Copyright (c) 2013-2016 Andreas Schuh
+# All rights reserved.
+#
+# See COPYING file for license information or visit
+# https://cmake-basis.github.io/download.html#license
+# ============================================================================
+
+##############################################################################
+# @file  ProfileTools.cmake
+# @brief Functions to profile the configuration of a project.
+#
+# If the option @c BASIS_PROFILE_CONFIGURE is enabled, the main BASIS
+# functions record the times when they are entered and left. The
+# execute_process() command is then also replaced by a function which
+# records the execution time of each process. At the end of the
+# configuration of the top-level project, basis_profile_report() writes these
+# events to the file BasisConfigureProfile.json in the Chrome trace event
+# format, which can be viewed with chrome://tracing or https://ui.perfetto.dev,
+# and a summary of the total time spent in each function and the slowest calls
+# to the file BasisConfigureProfile.txt.
+#
+# @ingroup CMakeTools
+##############################################################################
+
+if (__BASIS_PROFILETOOLS_INCLUDED)
+  return ()
+else ()
+  set (__BASIS_PROFILETOOLS_INCLUDED TRUE)
+endif ()
+
+# 64-bit integer arithmetic is required to compute the durations
+if (BASIS_PROFILE_CONFIGURE AND CMAKE_VERSION VERSION_LESS 3.13)
+  message (WARNING "BASIS_PROFILE_CONFIGURE requires CMake 3.13 or newer. Profiling is disabled.")
+  set (BASIS_PROFILE_CONFIGURE OFF)
+endif ()
+
+
+## @addtogroup CMakeUtilities
+#  @{
+
+
+# ============================================================================
+# events
+# ============================================================================
+
+# ----------------------------------------------------------------------------
+## @brief Get current time in microseconds since the epoch.
+#
+# The resolution is one second with CMake versions older than 3.23.
+#
+# @param [out] TIME Name of output variable.
+function (basis_profile_time TIME)
+  if (CMAKE_VERSION VERSION_LESS 3.23)
+    string (TIMESTAMP T "%s000000" UTC)
+  else ()
+    string (TIMESTAMP T "%s%f" UTC)
+  endif ()
+  set (${TIME} "${T}" PARENT_SCOPE)
+endfunction ()
+
+# ----------------------------------------------------------------------------
+## @brief Record the begin of a profiled function call.
+#
+# Does nothing unless @c BASIS_PROFILE_CONFIGURE is enabled.
+#
+# @param [in] NAME Name of function.
+# @param [in] ARGN Optional details such as the name of the added target.
+function (basis_profile_begin NAME)
+  if (BASIS_PROFILE_CONFIGURE)
+    basis_profile_time (T)
+    string (REGEX REPLACE "[;|]" " " DETAIL "${ARGN}")
+    set_property (GLOBAL APPEND PROPERTY BASIS_PROFILE_EVENTS "B|${NAME}|${DETAIL}|${T}")
+  endif ()
+endfunction ()
+
+# ----------------------------------------------------------------------------
+## @brief Record the end of a profiled function call.
+#
+# Each call of basis_profile_begin() must be matched by a call of this
+# function with the same name.
+#
+# @param [in] NAME Name of function.
+# @param [in] ARGN Optional details which are used if none were given
+#                  to basis_profile_begin().
+function (basis_profile_end NAME)
+  if (BASIS_PROFILE_CONFIGURE)
+    basis_profile_time (T)
+    string (REGEX REPLACE "[;|]" " " DETAIL "${ARGN}")
+    set_property (GLOBAL APPEND PROPERTY BASIS_PROFILE_EVENTS "E|${NAME}|${DETAIL}|${T}")
+  endif ()
+endfunction ()
+
+# ----------------------------------------------------------------------------
+# record execution time of processes
+#
+# The arguments are forwarded as unquoted list. Hence, while profiling is
+# enabled, empty arguments are dropped, and arguments containing a semicolon
+# or unbalanced square brackets are not passed on unmodified. The command is
+# not replaced if it was already overridden by another module.
+if (BASIS_PROFILE_CONFIGURE)
+  get_property (_BASIS_PROFILE_EXECUTE_PROCESS GLOBAL PROPERTY BASIS_PROFILE_EXECUTE_PROCESS)
+  if (NOT _BASIS_PROFILE_EXECUTE_PROCESS)
+    set_property (GLOBAL PROPERTY BASIS_PROFILE_EXECUTE_PROCESS TRUE)
+    if (COMMAND _execute_process)
+      message (WARNING "execute_process() is already overridden. Execution times of processes are not profiled.")
+    else ()
+      function (execute_process)
+        set (_BASIS_PROFILE_VARS)
+        set (_BASIS_PROFILE_NAME)
+        set (_BASIS_PROFILE_PREV)
+        foreach (_BASIS_PROFILE_ARG IN LISTS ARGV)
+          if (_BASIS_PROFILE_PREV MATCHES "^(RESULT|RESULTS|OUTPUT|ERROR)_VARIABLE$")
+            list (APPEND _BASIS_PROFILE_VARS "${_BASIS_PROFILE_ARG}")
+          elseif (_BASIS_PROFILE_PREV MATCHES "^COMMAND$" AND NOT _BASIS_PROFILE_NAME)
+            get_filename_component (_BASIS_PROFILE_NAME "${_BASIS_PROFILE_ARG}" NAME)
+          endif ()
+          set (_BASIS_PROFILE_PREV "${_BASIS_PROFILE_ARG}")
+        endforeach ()
+        basis_profile_begin (execute_process "${_BASIS_PROFILE_NAME}")
+        _execute_process (${ARGV})
+        basis_profile_end (execute_process)
+        foreach (_BASIS_PROFILE_VAR IN LISTS _BASIS_PROFILE_VARS)
+          set (${_BASIS_PROFILE_VAR} "${${_BASIS_PROFILE_VAR}}" PARENT_SCOPE)
+        endforeach ()
+      endfunction ()
+    endif ()
+  endif ()
+endif ()
+
+# ============================================================================
+# report
+# ============================================================================
+
+# ----------------------------------------------------------------------------
+## @brief Left-pad string to given width.
+function (basis_profile_pad OUT WIDTH STR)
+  string (LENGTH "${STR}" N)
+  while (N LESS WIDTH)
+    set (STR " ${STR}")
+    math (EXPR N "${N} + 1")
+  endwhile ()
+  set (${OUT} "${STR}" PARENT_SCOPE)
+endfunction ()
+
+# ----------------------------------------------------------------------------
+## @brief Format duration given in microseconds as milliseconds.
+function (basis_profile_ms OUT US)
+  math (EXPR MS   "${US} / 1000")
+  math (EXPR FRAC "(${US} % 1000) / 100")
+  set (${OUT} "${MS}.${FRAC}" PARENT_SCOPE)
+endfunction ()
+
+# ----------------------------------------------------------------------------
+## @brief Write profile of recorded function calls.
+#
+# This function is called at the end of basis_project_impl() of the
+# top-level project. It writes the recorded calls to the file
+# BasisConfigureProfile.json in the Chrome trace event format and a summary
+# to the file BasisConfigureProfile.txt in the top-level build directory.
+# The summary is also printed.
+#
+# @param [in] ARGN Number of slowest calls listed in the summary. (default: 20)
+function (basis_profile_report)
+  if (NOT BASIS_PROFILE_CONFIGURE)
+    return ()
+  endif ()
+  if (ARGN)
+    set (TOP ${ARGN})
+  else ()
+    set (TOP 20)
+  endif ()
+  get_property (EVENTS GLOBAL PROPERTY BASIS_PROFILE_EVENTS)
+  set (STACK)     # indices of begin events of active calls
+  set (NAMES)     # names of profiled functions
+  set (CALLS)     # "<sort key>|<duration>|<name>|<detail>" of each completed call
+  set (JSON)
+  set (I 0)
+  foreach (EVENT IN LISTS EVENTS)
+    string (REGEX MATCH "^([BE])\\|([^|]*)\\|([^|]*)\\|([0-9]+)$" EVENT "${EVENT}")
+    set (TYPE   "${CMAKE_MATCH_1}")
+    set (NAME   "${CMAKE_MATCH_2}")
+    set (DETAIL "${CMAKE_MATCH_3}")
+    set (TIME   "${CMAKE_MATCH_4}")
+    if (TYPE MATCHES "^B$")
+      set (BEGIN_${I}_NAME   "${NAME}")
+      set (BEGIN_${I}_DETAIL "${DETAIL}")
+      set (BEGIN_${I}_TIME   "${TIME}")
+      list (APPEND STACK ${I})
+      math (EXPR I "${I} + 1")
+    else ()
+      list (LENGTH STACK N)
+      if (N EQUAL 0)
+        message (WARNING "basis_profile_report(): Call of basis_profile_end(${NAME}) without basis_profile_begin()")
+        break ()
+      endif ()
+      list (GET STACK -1 B)
+      list (REMOVE_AT STACK -1)
+      if (NOT BEGIN_${B}_NAME STREQUAL NAME)
+        message (WARNING "basis_profile_report(): Unmatched calls of basis_profile_begin(${BEGIN_${B}_NAME}) and basis_profile_end(${NAME})")
+      endif ()
+      if (NOT BEGIN_${B}_DETAIL STREQUAL "")
+        set (DETAIL "${BEGIN_${B}_DETAIL}")
+      endif ()
+      math (EXPR DURATION "${TIME} - ${BEGIN_${B}_TIME}")
+      # Chrome trace event
+      string (REPLACE "\\" "\\\\" JSON_DETAIL "${DETAIL}")
+      string (REPLACE "\"" "\\\"" JSON_DETAIL "${JSON_DETAIL}")
+      if (JSON)
+        set (JSON "${JSON},\n")
+      endif ()
+      set (JSON "${JSON}  {\"name\": \"${NAME}\", \"cat\": \"basis\", \"ph\": \"X\", \"pid\": 1, \"tid\": 1, \"ts\": ${BEGIN_${B}_TIME}, \"dur\": ${DURATION}, \"args\": {\"detail\": \"${JSON_DETAIL}\"}}")
+      # summary
+      list (FIND NAMES "${NAME}" IDX)
+      if (IDX EQUAL -1)
+        list (APPEND NAMES "${NAME}")
+        set (COUNT_${NAME} 0)
+        set (TOTAL_${NAME} 0)
+        set (MAX_${NAME}   0)
+      endif ()
+      math (EXPR COUNT_${NAME} "${COUNT_${NAME}} + 1")
+      # exclude nested (recursive) calls of the same function from its total
+      set (NESTED FALSE)
+      foreach (S IN LISTS STACK)
+        if (BEGIN_${S}_NAME STREQUAL NAME)
+          set (NESTED TRUE)
+        endif ()
+      endforeach ()
+      if (NOT NESTED)
+        math (EXPR TOTAL_${NAME} "${TOTAL_${NAME}} + ${DURATION}")
+      endif ()
+      if (DURATION GREATER MAX_${NAME})
+        set (MAX_${NAME} ${DURATION})
+      endif ()
+      basis_profile_pad (D 16 "${DURATION}")
+      string (REPLACE " " "0" D "${D}")
+      list (APPEND CALLS "${D}|${DURATION}|${NAME}|${DETAIL}")
+    endif ()
+  endforeach ()
+  list (LENGTH STACK N)
+  if (N GREATER 0)
+    message (WARNING "basis_profile_report(): Some calls of basis_profile_begin() are not matched by basis_profile_end()")
+  endif ()
+  # write trace
+  file (WRITE "${CMAKE_BINARY_DIR}/BasisConfigureProfile.json" "{\"traceEvents\": [\n${JSON}\n]}\n")
+  # summary of functions sorted by total time
+  set (SUMMARY "BASIS configure profile (inclusive times, see ${CMAKE_BINARY_DIR}/BasisConfigureProfile.json)\n\n")
+  set (SORTED)
+  foreach (NAME IN LISTS NAMES)
+    basis_profile_pad (T 16 "${TOTAL_${NAME}}")
+    string (REPLACE " " "0" T "${T}")
+    list (APPEND SORTED "${T}|${NAME}")
+  endforeach ()
+  if (SORTED)
+    list (SORT SORTED)
+    list (REVERSE SORTED)
+  endif ()
+  basis_profile_pad (H1 36 "function")
+  basis_profile_pad (H2 8  "calls")
+  basis_profile_pad (H3 14 "total [ms]")
+  basis_profile_pad (H4 12 "max [ms]")
+  set (SUMMARY "${SUMMARY}${H1}${H2}${H3}${H4}\n")
+  foreach (ENTRY IN LISTS SORTED)
+    string (REGEX REPLACE "^[0-9]+\\|" "" NAME "${ENTRY}")
+    basis_profile_ms (TOTAL "${TOTAL_${NAME}}")
+    basis_profile_ms (MAX   "${MAX_${NAME}}")
+    basis_profile_pad (C1 36 "${NAME}")
+    basis_profile_pad (C2 8  "${COUNT_${NAME}}")
+    basis_profile_pad (C3 14 "${TOTAL}")
+    basis_profile_pad (C4 12 "${MAX}")
+    set (SUMMARY "${SUMMARY}${C1}${C2}${C3}${C4}\n")
+  endforeach ()
+  # slowest calls
+  if (CALLS)
+    list (SORT CALLS)
+    list (REVERSE CALLS)
+  endif ()
+  set (SUMMARY "${SUMMARY}\nSlowest calls:\n\n")
+  set (N 0)
+  foreach (ENTRY IN LISTS CALLS)
+    if (NOT N LESS TOP)
+      break ()
+    endif ()
+    string (REGEX MATCH "^[0-9]+\\|([0-9]+)\\|([^|]*)\\|([^|]*)$" ENTRY "${ENTRY}")
+    set (DURATION "${CMAKE_MATCH_1}")
+    set (NAME     "${CMAKE_MATCH_2}")
+    set (DETAIL   "${CMAKE_MATCH_3}")
+    basis_profile_ms (MS "${DURATION}")
+    basis_profile_pad (MS 12 "${MS}")
+    set (SUMMARY "${SUMMARY}${MS} ms  ${NAME}(${DETAIL})\n")
+    math (EXPR N "${N} + 1")
+  endforeach ()
+  file (WRITE "${CMAKE_BINARY_DIR}/BasisConfigureProfile.txt" "${SUMMARY}")
+  message ("${SUMMARY}")
+endfunction ()
+
+
+## @}
+# end of Doxygen group
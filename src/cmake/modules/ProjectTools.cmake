@@ -1157,37 +1157,27 @@ macro (basis_project_modules)
   list (SORT PROJECT_MODULES_ENABLED)  # Deterministic order.
   list (SORT PROJECT_MODULES_DISABLED) # Deterministic order.
 
-  # order list to satisfy dependencies
+  # order list to satisfy dependencies and group modules by dependency level,
+  # where the modules of one level only depend on modules of lower levels
   include (${BASIS_MODULE_PATH}/TopologicalSort.cmake)
-  foreach (MODULE ${PROJECT_MODULES})
-    set (${MODULE}_USES
-      ${${MODULE}_DEPENDS}
-      ${${MODULE}_OPTIONAL_DEPENDS}
-      ${${MODULE}_TOOLS_DEPENDS}
-      ${${MODULE}_OPTIONAL_TOOLS_DEPENDS}
-      ${${MODULE}_TEST_DEPENDS}
-      ${${MODULE}_OPTIONAL_TEST_DEPENDS}
-    )
+  foreach (MODULE ${PROJECT_MODULES_ENABLED})
+    set (${MODULE}_USES)
+    foreach (D IN LISTS ${MODULE}_DEPENDS
+                        ${MODULE}_OPTIONAL_DEPENDS
+                        ${MODULE}_TOOLS_DEPENDS
+                        ${MODULE}_OPTIONAL_TOOLS_DEPENDS
+                        ${MODULE}_TEST_DEPENDS
+                        ${MODULE}_OPTIONAL_TEST_DEPENDS)
+      if (${D}_DECLARED AND ${D}_ENABLED)
+        list (APPEND ${MODULE}_USES ${D})
+      endif ()
+    endforeach ()
   endforeach ()
-  set (PROJECT_MODULES_SORTED "${PROJECT_MODULES}")
-  topological_sort (PROJECT_MODULES_SORTED "" "_USES")
-  foreach (MODULE ${PROJECT_MODULES})
+  topological_levels (PROJECT_MODULES_ENABLED "" "_USES" PROJECT_MODULES_LEVELS)
+  foreach (MODULE ${PROJECT_MODULES_ENABLED})
     unset (${MODULE}_USES)
   endforeach ()
 
-  # remove disabled modules and external dependencies
-  set (L)
-  foreach (MODULE IN LISTS PROJECT_MODULES_SORTED)
-    if (${MODULE}_DECLARED)
-      list (FIND PROJECT_MODULES_ENABLED "${MODULE}" IDX)
-      if (NOT IDX EQUAL -1)
-        list (APPEND L "${MODULE}")
-      endif ()
-    endif ()
-  endforeach ()
-  set (PROJECT_MODULES_ENABLED "${L}")
-  unset (L)
-
   # turn options ON for modules that are required by other modules
   foreach (MODULE ${PROJECT_MODULES})
     if (DEFINED MODULE_${MODULE} # there was an option for the user
@@ -1202,6 +1192,13 @@ macro (basis_project_modules)
   # report what will be built
   if (PROJECT_MODULES_ENABLED)
     message (STATUS "Enabled modules [${PROJECT_MODULES_ENABLED}].")
+    if (BASIS_VERBOSE)
+      set (L 0)
+      while (L LESS PROJECT_MODULES_LEVELS)
+        message (STATUS "  Level ${L} [${PROJECT_MODULES_LEVELS_${L}}]")
+        math (EXPR L "${L} + 1")
+      endwhile ()
+    endif ()
   endif ()
 
   # check that all enabled external modules do exist
@@ -1228,6 +1225,7 @@ macro (basis_project_modules)
   unset (PKG)
   unset (VER)
   unset (CMPS)
+  unset (L)
 
 endmacro ()
 
@@ -1320,13 +1318,24 @@ endfunction ()
 
 # ----------------------------------------------------------------------------
 ## @brief Configure public header files.
+#
+# The public header files with the .in suffix found in the
+# @c PROJECT_INCLUDE_DIRS are configured and written to the
+# @c BINARY_INCLUDE_DIR using basis_configure_files(). Hence, a header file
+# is only configured again when it or one of the variables it references was
+# modified. Other header files are used from the source tree. Whether header
+# files were added or removed is checked by the same build step as the source
+# files of globbed targets (see basis_add_glob_check()).
 function (basis_configure_public_headers)
+  basis_profile_begin (basis_configure_public_headers)
   # --------------------------------------------------------------------------
   # settings
+  basis_make_target_uid (CHECK_HEADERS_TARGET     headers_check)
+  basis_make_target_uid (CONFIGURE_HEADERS_TARGET headers)
+
+  # build directory with list of public header files and manifest of configured files
+  set (BUILD_DIR "${PROJECT_BINARY_DIR}/CMakeFiles/${CONFIGURE_HEADERS_TARGET}.dir")
 
-  # log file which lists the configured header files
-  set (CMAKE_FILE "${BINARY_INCLUDE_DIR}/${PROJECT_NAME}PublicHeaders.cmake")
-  
   # ----------------------------------------------------------------------------
   #  header files to configure excluding the .in suffix
   set (
@@ -1340,15 +1349,6 @@ function (basis_configure_public_headers)
       ".inc"
   )
 
-  # --------------------------------------------------------------------------
-  # clean up last run before the error because a file was added/removed
-  file (REMOVE "${CMAKE_FILE}.tmp")
-  file (REMOVE "${CMAKE_FILE}.updated")
-  if (EXISTS "${CMAKE_FILE}")
-    # required to be able to remove now obsolete files from the build tree
-    file (RENAME "${CMAKE_FILE}" "${CMAKE_FILE}.tmp")
-  endif ()
-
   # --------------------------------------------------------------------------
   # configure public header files
   message (STATUS "Configuring public header files...")
@@ -1357,133 +1357,52 @@ function (basis_configure_public_headers)
     message (FATAL_ERROR "Missing argument PROJECT_INCLUDE_DIRS!")
   endif ()
 
-  # configure all .in files with substitution
-  set (CONFIGURED_HEADERS)
+  set (EXPRESSIONS)
   foreach (INCLUDE_DIR IN LISTS PROJECT_INCLUDE_DIRS)
-    set (PATTERN)
     foreach (E IN LISTS EXTENSIONS)
-      list (APPEND PATTERN "${INCLUDE_DIR}/*${E}.in")
-    endforeach ()
-    file (GLOB_RECURSE FILES RELATIVE "${INCLUDE_DIR}" ${PATTERN})
-    foreach (HEADER IN LISTS FILES)
-      get_filename_component (SOURCE "${INCLUDE_DIR}/${HEADER}" ABSOLUTE)
-      string (REGEX REPLACE "\\.in$" "" HEADER "${HEADER}")
-      configure_file ("${SOURCE}" "${BINARY_INCLUDE_DIR}/${HEADER}" @ONLY)
-      list (APPEND CONFIGURED_HEADERS "${SOURCE}")
+      list (APPEND EXPRESSIONS "${INCLUDE_DIR}/**${E}" "${INCLUDE_DIR}/**${E}.in")
     endforeach ()
   endforeach ()
+  basis_get_glob_timestamps (DIRECTORIES TIMESTAMPS ${EXPRESSIONS})
+  basis_glob_source_files (PUBLIC_HEADERS ${EXPRESSIONS})
 
-  # regular headers are copied separately via 
-  # execute_process to avoid a full configure step
-  # However, all headers should be checked for changes. 
-
-  execute_process (
-    COMMAND "${CMAKE_COMMAND}" ${COMMON_ARGS}
-            -D "PROJECT_INCLUDE_DIRS=${PROJECT_INCLUDE_DIRS}"
-            -D "BINARY_INCLUDE_DIR=${BINARY_INCLUDE_DIR}"
-            -D "EXTENSIONS=${EXTENSIONS}"
-            -D "CMAKE_FILE=${CMAKE_FILE}"
-            -D "CONFIGURED_HEADERS=${CONFIGURED_HEADERS}"
-            -P "${BASIS_MODULE_PATH}/ConfigureIncludeFiles.cmake"
-    RESULT_VARIABLE RT
-  )
-
-  if (RT EQUAL 0)
-    execute_process (
-      COMMAND "${CMAKE_COMMAND}" -E touch "${CMAKE_FILE}.updated"
-    )
-  else ()
-    message (FATAL_ERROR "Failed to configure public header files!")
-  endif ()
-
-  if (NOT EXISTS "${CMAKE_FILE}")
-    message (FATAL_ERROR "File ${CMAKE_FILE} not generated as it should have been!")
-  endif ()
-
-  # remove header files from build tree which were copied there before but
-  # are part of a now disabled module or were simply removed from the source tree
-  if (EXISTS "${CMAKE_FILE}.tmp")
-    execute_process (
-      # Compare current list of headers to list of previously configured files.
-      # If the lists differ, this command removes files which have been removed
-      # from the directory tree with root PROJECT_INCLUDE_DIR also from the
-      # tree with root directory BINARY_INCLUDE_DIR.
-      COMMAND "${CMAKE_COMMAND}" ${COMMON_ARGS}
-              -D "PROJECT_INCLUDE_DIRS=${PROJECT_INCLUDE_DIRS}"
-              -D "BINARY_INCLUDE_DIR=${BINARY_INCLUDE_DIR}"
-              -D "CMAKE_FILE=${CMAKE_FILE}.tmp"
-              -D "REFERENCE_FILE=${CMAKE_FILE}"
-              -P "${BASIS_MODULE_PATH}/CheckPublicHeaders.cmake"
-      VERBATIM
-    )
-    file (REMOVE "${CMAKE_FILE}.tmp")
-    if (NOT RT EQUAL 0)
-      message (FATAL_ERROR "Failed to remove obsolete header files from build tree."
-                           " Remove the ${BINARY_INCLUDE_DIR} directory and re-run CMake.")
+  # configure all .in files with substitution
+  set (INPUTS)
+  set (OUTPUTS)
+  foreach (SOURCE IN LISTS PUBLIC_HEADERS)
+    if (SOURCE MATCHES "\\.in$")
+      foreach (INCLUDE_DIR IN LISTS PROJECT_INCLUDE_DIRS)
+        file (RELATIVE_PATH HEADER "${INCLUDE_DIR}" "${SOURCE}")
+        if (NOT HEADER MATCHES "^\\.\\./")
+          string (REGEX REPLACE "\\.in$" "" HEADER "${HEADER}")
+          list (APPEND INPUTS  "${SOURCE}")
+          list (APPEND OUTPUTS "${BINARY_INCLUDE_DIR}/${HEADER}")
+          break ()
+        endif ()
+      endforeach ()
     endif ()
-  endif ()
+  endforeach ()
+  basis_configure_files ("${BUILD_DIR}/manifest.cmake" INPUTS ${INPUTS} OUTPUTS ${OUTPUTS})
+
+  # write list of public header files and glob file read by glob.cmake
+  basis_write_list ("${BUILD_DIR}/sources.txt" INITIAL_SOURCES ${PUBLIC_HEADERS})
+  basis_write_glob_file ("${BUILD_DIR}/glob.txt" ${CONFIGURE_HEADERS_TARGET} "${EXPRESSIONS}" "${DIRECTORIES}" "${TIMESTAMPS}")
+  basis_set_project_property (APPEND PROPERTY GLOB_FILES "${BUILD_DIR}/glob.txt")
 
   message (STATUS "Configuring public header files... - done")
 
-  # We need a list of the configured files to add them as dependency of the
-  # custom build targets such that these get re-build whenever a file changed.
-  # Additionally, including this file here which is modified whenever a
-  # header file is added or removed triggeres a re-configuration of the
-  # build system which is required to re-execute this function and adjust
-  # these custom build targets.
-  include ("${CMAKE_FILE}")
+  # We need a list of the public header files to add them as sources of the
+  # custom build target. Additionally, including this file here which is
+  # modified by glob.cmake whenever a header file is added or removed triggers
+  # a re-configuration of the build system which is required to re-execute
+  # this function.
+  include ("${BUILD_DIR}/sources.txt")
+  set (PUBLIC_HEADERS "${INITIAL_SOURCES}")
 
   # --------------------------------------------------------------------------
-  # check if any header was added or removed (always out-of-date)
-
-  # error message displayed when a file was added or removed which requires
-  # a reconfiguration of the build system
-  set (ERRORMSG "You have either added, removed, or renamed a public header file"
-                " with a .in suffix in the file name. Therefore, the build system"
-                " needs to be re-configured. Either try to build again which will"
-                " trigger CMake and re-configure the build system or run CMake manually.")
-  basis_list_to_string (ERRORMSG ${ERRORMSG})
-
-  # custom command which globs the files in the project's include directory
-  set (COMMENT "Checking if public header files were added or removed")
-  if (PROJECT_IS_MODULE)
-    set (COMMENT "${COMMENT} to ${PROJECT_NAME} module")
-  endif ()
-  add_custom_command (
-    OUTPUT  "${CMAKE_FILE}.tmp"
-    COMMAND "${CMAKE_COMMAND}"
-            -D "PROJECT_INCLUDE_DIRS=${PROJECT_INCLUDE_DIRS}"
-            -D "BINARY_INCLUDE_DIR=${BINARY_INCLUDE_DIR}"
-            -D "EXTENSIONS=${EXTENSIONS}"
-            -D "CMAKE_FILE=${CMAKE_FILE}.tmp"
-            -D "PREVIEW=TRUE" # do not actually configure the files
-            -D "CONFIGURED_HEADERS=${CONFIGURED_HEADERS}"
-            -P "${BASIS_MODULE_PATH}/ConfigureIncludeFiles.cmake"
-    COMMENT "${COMMENT}"
-    VERBATIM
-  )
-
-  # custom target to detect whether a file was added or removed
-  basis_make_target_uid (CHECK_HEADERS_TARGET headers_check)
-  add_custom_target (
-    ${CHECK_HEADERS_TARGET} ALL
-    # trigger execution of custom command that generates the list
-    # of current files in the project's include directory
-    DEPENDS "${CMAKE_FILE}.tmp"
-    # Compare current list of headers to list of previously configured files.
-    # If the lists differ, the build of this target fails with the given error message.
-    COMMAND "${CMAKE_COMMAND}"
-            -D "PROJECT_INCLUDE_DIRS=${PROJECT_INCLUDE_DIRS}"
-            -D "BINARY_INCLUDE_DIR=${BINARY_INCLUDE_DIR}"
-            -D "CMAKE_FILE=${CMAKE_FILE}"
-            -D "REFERENCE_FILE=${CMAKE_FILE}.tmp"
-            -D "ERRORMSG=${ERRORMSG}"
-            -D "REMOVE_FILES_IF_DIFFERENT=TRUE" # triggers reconfigure on next build
-            -P "${BASIS_MODULE_PATH}/CheckPublicHeaders.cmake"
-    # remove temporary file again to force its regeneration
-    COMMAND "${CMAKE_COMMAND}" -E remove "${CMAKE_FILE}.tmp"
-    VERBATIM
-  )
+  # check if any header was added or removed before each build
+  add_custom_target (${CHECK_HEADERS_TARGET} ALL)
+  add_dependencies (${CHECK_HEADERS_TARGET} __glob)
   if (PROJECT_IS_MODULE)
     if (NOT TARGET headers_check)
       add_custom_target (headers_check ALL)
@@ -1492,32 +1411,10 @@ function (basis_configure_public_headers)
   endif ()
 
   # --------------------------------------------------------------------------
-  # add build command to re-configure public header files
+  # add target which lists the public header files
   if (PUBLIC_HEADERS)
-    set (COMMENT "Configuring public header files")
-    if (PROJECT_IS_MODULE)
-      set (COMMENT "${COMMENT} of ${PROJECT_NAME} module")
-    endif ()
-    add_custom_command (
-      OUTPUT  "${CMAKE_FILE}.updated" # do not use same file as included
-                                      # before otherwise CMake will re-configure
-                                      # the build system next time
-      COMMAND "${CMAKE_COMMAND}"
-              -D "PROJECT_INCLUDE_DIRS=${PROJECT_INCLUDE_DIRS}"
-              -D "BINARY_INCLUDE_DIR=${BINARY_INCLUDE_DIR}"
-              -D "EXTENSIONS=${EXTENSIONS}"
-              -P "${BASIS_MODULE_PATH}/ConfigureIncludeFiles.cmake"
-      COMMAND "${CMAKE_COMMAND}" -E touch "${CMAKE_FILE}.updated"
-      DEPENDS ${PUBLIC_HEADERS}
-      COMMENT "${COMMENT}"
-      VERBATIM
-    )
-    basis_make_target_uid (CONFIGURE_HEADERS_TARGET headers)
-    add_custom_target (
-      ${CONFIGURE_HEADERS_TARGET} ALL
-      DEPENDS ${CHECK_HEADERS_TARGET} "${CMAKE_FILE}.updated"
-      SOURCES ${PUBLIC_HEADERS}
-    )
+    add_custom_target (${CONFIGURE_HEADERS_TARGET} ALL SOURCES ${PUBLIC_HEADERS})
+    add_dependencies (${CONFIGURE_HEADERS_TARGET} ${CHECK_HEADERS_TARGET})
     if (PROJECT_IS_MODULE)
       if (NOT TARGET headers)
         add_custom_target (headers ALL)
@@ -1525,6 +1422,7 @@ function (basis_configure_public_headers)
       add_dependencies (headers ${CONFIGURE_HEADERS_TARGET})
     endif ()
   endif ()
+  basis_profile_end (basis_configure_public_headers)
 endfunction ()
 
 # ----------------------------------------------------------------------------
@@ -1726,28 +1624,8 @@ endmacro ()
 # as is the case for development branches, and now revision from a revision
 # control system is available.
 function (basis_get_build_timestamp TIMESTAMP)
-  if (WIN32)
-    execute_process (
-      COMMAND "${BASIS_MODULE_PATH}/buildtimestamp.cmd"
-      RESULT_VARIABLE RT
-      OUTPUT_VARIABLE BUILD_TIMESTAMP
-      ERROR_QUIET
-      OUTPUT_STRIP_TRAILING_WHITESPACE
-    )
-  else ()
-    execute_process (
-      COMMAND "date" -u "+%Y.%m.%d (%H:%M UTC)"
-      RESULT_VARIABLE RT
-      OUTPUT_VARIABLE BUILD_TIMESTAMP
-      ERROR_QUIET
-      OUTPUT_STRIP_TRAILING_WHITESPACE
-    )
-  endif ()
-  if (RT EQUAL 0)
-    set (${TIMESTAMP} "${BUILD_TIMESTAMP}" PARENT_SCOPE)
-  else ()
-    set (${TIMESTAMP} PARENT_SCOPE)
-  endif ()
+  string (TIMESTAMP BUILD_TIMESTAMP "%Y.%m.%d (%H:%M UTC)" UTC)
+  set (${TIMESTAMP} "${BUILD_TIMESTAMP}" PARENT_SCOPE)
 endfunction ()
 
 # ----------------------------------------------------------------------------
@@ -2065,6 +1943,9 @@ macro (basis_project_initialize)
   basis_set_project_property (PROPERTY TARGETS "")
   # see basis_finalize_targets()
   basis_set_project_property (PROPERTY FINALIZED_TARGETS "")
+  # see basis_add_glob_target()
+  basis_set_project_property (PROPERTY GLOB_TARGETS "")
+  basis_set_project_property (PROPERTY GLOB_FILES   "")
   # see basis_add_*() functions
   basis_set_project_property (PROPERTY EXPORT_TARGETS                "")
   basis_set_project_property (PROPERTY INSTALL_EXPORT_TARGETS        "")
@@ -2298,8 +2179,8 @@ macro (basis_install_public_headers)
       "${BINARY_INCLUDE_DIR}" "${INSTALL_INCLUDE_DIR}"
       REGEX   "/${_BASIS_H_PREFIX}basis\\.h$" EXCLUDE # BASIS utilities header only installed
                                                       # below if included by any other public header
-      PATTERN "*.cmake"                       EXCLUDE # e.g., <Name>PublicHeaders.cmake file,
-      PATTERN "*.cmake.*"                     EXCLUDE # see basis_configure_public_headers()
+      PATTERN "*.cmake"                       EXCLUDE # e.g., <Name>PublicHeaders.cmake file of older
+      PATTERN "*.cmake.*"                     EXCLUDE # BASIS versions
     )
   endif ()
   # "parse" public header files to check if C++ BASIS utilities are included
@@ -2379,7 +2260,18 @@ macro (basis_add_module MODULE)
   #       - ${MODULE}_INCLUDE_DIRS are the locations of public header files.
   if (BASIS_SUPERBUILD_MODULES)
     message (STATUS "Configuring super-build of module ${MODULE}...")
-    basis_super_build (${MODULE}) # automatically uses: "${MODULE_${MODULE}_SOURCE_DIR}" "${MODULE_${MODULE}_BINARY_DIR}"
+    include ("${BASIS_MODULE_PATH}/SuperBuildTools.cmake")
+    # modules are added in order of their dependency levels, such that the
+    # external projects of all modules this module depends on exist already
+    # and independent modules can be configured and built concurrently
+    basis_super_build (${MODULE} # automatically uses: "${MODULE_${MODULE}_SOURCE_DIR}" "${MODULE_${MODULE}_BINARY_DIR}"
+      DEPENDS ${${MODULE}_DEPENDS}
+              ${${MODULE}_OPTIONAL_DEPENDS}
+              ${${MODULE}_TOOLS_DEPENDS}
+              ${${MODULE}_OPTIONAL_TOOLS_DEPENDS}
+              ${${MODULE}_TEST_DEPENDS}
+              ${${MODULE}_OPTIONAL_TEST_DEPENDS}
+    )
     message (STATUS "Configuring super-build of module ${MODULE}... - done")
   else ()
     message (STATUS "Configuring module ${MODULE}...")
@@ -2387,7 +2279,10 @@ macro (basis_add_module MODULE)
     message (STATUS "Configuring module ${MODULE}... - done")
   endif ()
   set (PROJECT_IS_MODULE FALSE)
-  include ("${BINARY_LIBCONF_DIR}/${TOPLEVEL_PROJECT_PACKAGE_CONFIG_PREFIX}${MODULE}Config.cmake")
+  # configuration of module is deferred until build step in case of super-build
+  if (NOT BASIS_SUPERBUILD_MODULES)
+    include ("${BINARY_LIBCONF_DIR}/${TOPLEVEL_PROJECT_PACKAGE_CONFIG_PREFIX}${MODULE}Config.cmake")
+  endif ()
 endmacro ()
 
 # ----------------------------------------------------------------------------
@@ -2627,7 +2522,9 @@ macro (basis_project_end)
                           IMPORTED_RANKS
                           PROJECT_INCLUDE_DIRS
                           PROJECT_LINK_DIRS
-                          BUNDLE_LINK_DIRS)
+                          BUNDLE_LINK_DIRS
+                          GLOB_TARGETS
+                          GLOB_FILES)
         basis_get_project_property (V ${M} ${P})
         basis_set_project_property (APPEND PROPERTY ${P} ${V})
       endforeach ()
@@ -2651,6 +2548,10 @@ macro (basis_project_end)
 
   # add missing build commands for custom targets
   basis_finalize_targets ()
+  # add single target which re-globs the source files of all targets
+  if (NOT PROJECT_IS_MODULE)
+    basis_add_glob_check ()
+  endif ()
   if (NOT PROJECT_IS_MODULE OR PROJECT_IS_SUBPROJECT)
     # configure the BASIS utilities
     basis_configure_utilities ()
@@ -2747,13 +2648,18 @@ endmacro ()
 #
 # @ingroup CMakeAPI
 macro (basis_project_impl)
+  basis_profile_begin (basis_project "${CMAKE_CURRENT_SOURCE_DIR}")
   # initialize project
+  basis_profile_begin (basis_project_begin)
   basis_project_begin ()
+  basis_profile_end (basis_project_begin "${PROJECT_NAME}")
   # process modules
   if (NOT PROJECT_IS_MODULE)
     foreach (MODULE IN LISTS PROJECT_MODULES_ENABLED)
       basis_add_module (${MODULE})
-      basis_use_module (${MODULE})
+      if (NOT BASIS_SUPERBUILD_MODULES)
+        basis_use_module (${MODULE})
+      endif ()
     endforeach ()
   endif ()
   # process subdirectories
@@ -2761,5 +2667,12 @@ macro (basis_project_impl)
     basis_add_subdirectory (${SUBDIR})
   endforeach ()
   # finalize project
+  basis_profile_begin (basis_project_end "${PROJECT_NAME}")
   basis_project_end ()
+  basis_profile_end (basis_project_end)
+  basis_profile_end (basis_project)
+  # write profile of configure step
+  if (NOT PROJECT_IS_MODULE)
+    basis_profile_report ()
+  endif ()
 endmacro ()
@@ -152,13 +152,105 @@ endfunction ()
 # Git
 # ============================================================================
 
+# ----------------------------------------------------------------------------
+## @brief Find Git directory of working tree containing a given directory.
+#
+# The parent directories of @p DIR are searched for a <tt>.git</tt> directory.
+# A <tt>.git</tt> file as used by submodules and linked working trees, which
+# contains the path of the actual Git directory, is followed.
+#
+# @param [out] GIT_DIR Absolute path of Git directory or empty string if
+#                      @p DIR is not inside a Git working tree.
+# @param [in]  DIR     Absolute path of directory.
+function (basis_git_find_dir GIT_DIR DIR)
+  set (${GIT_DIR} "" PARENT_SCOPE)
+  set (CUR "${DIR}")
+  while (CUR)
+    if (IS_DIRECTORY "${CUR}/.git")
+      set (${GIT_DIR} "${CUR}/.git" PARENT_SCOPE)
+      return ()
+    elseif (EXISTS "${CUR}/.git")
+      file (STRINGS "${CUR}/.git" LINE LIMIT_COUNT 1)
+      if (LINE MATCHES "^gitdir: *(.+)$")
+        set (PATH "${CMAKE_MATCH_1}")
+        if (NOT IS_ABSOLUTE "${PATH}")
+          get_filename_component (PATH "${CUR}/${PATH}" ABSOLUTE)
+        endif ()
+        if (IS_DIRECTORY "${PATH}")
+          set (${GIT_DIR} "${PATH}" PARENT_SCOPE)
+        endif ()
+      endif ()
+      return ()
+    endif ()
+    get_filename_component (PARENT "${CUR}" PATH)
+    if (PARENT STREQUAL CUR)
+      break ()
+    endif ()
+    set (CUR "${PARENT}")
+  endwhile ()
+endfunction ()
+
+# ----------------------------------------------------------------------------
+## @brief Get commit SHA of HEAD from files in Git directory.
+#
+# This function resolves HEAD by reading the files in the Git directory
+# instead of executing the git command. Symbolic references are looked up
+# in the loose refs and the packed-refs file. Linked working trees share
+# these with the main repository named by the commondir file.
+#
+# @param [in]  GIT_DIR Git directory, e.g., as returned by basis_git_find_dir().
+# @param [out] SHA     Commit SHA of HEAD or empty string if it could not be
+#                      determined, e.g., because the branch has no commits yet
+#                      or the references are stored in a format not supported.
+function (basis_git_read_head GIT_DIR SHA)
+  set (OUT)
+  if (EXISTS "${GIT_DIR}/HEAD")
+    file (STRINGS "${GIT_DIR}/HEAD" HEAD LIMIT_COUNT 1)
+    if (HEAD MATCHES "^ref: *(.+)$")
+      set (REF "${CMAKE_MATCH_1}")
+      set (COMMON_DIR "${GIT_DIR}")
+      if (EXISTS "${GIT_DIR}/commondir")
+        file (STRINGS "${GIT_DIR}/commondir" COMMON_DIR LIMIT_COUNT 1)
+        if (NOT IS_ABSOLUTE "${COMMON_DIR}")
+          get_filename_component (COMMON_DIR "${GIT_DIR}/${COMMON_DIR}" ABSOLUTE)
+        endif ()
+      endif ()
+      foreach (D IN ITEMS "${GIT_DIR}" "${COMMON_DIR}")
+        if (NOT OUT AND EXISTS "${D}/${REF}" AND NOT IS_DIRECTORY "${D}/${REF}")
+          file (STRINGS "${D}/${REF}" OUT LIMIT_COUNT 1)
+        endif ()
+      endforeach ()
+      if (NOT OUT AND EXISTS "${COMMON_DIR}/packed-refs")
+        basis_sanitize_for_regex (RE "${REF}")
+        file (STRINGS "${COMMON_DIR}/packed-refs" LINE REGEX "^[0-9a-f]+ ${RE}$" LIMIT_COUNT 1)
+        if (LINE MATCHES "^([0-9a-f]+) ")
+          set (OUT "${CMAKE_MATCH_1}")
+        endif ()
+      endif ()
+    else ()
+      set (OUT "${HEAD}")
+    endif ()
+  endif ()
+  string (LENGTH "${OUT}" LEN)
+  if (NOT OUT MATCHES "^[0-9a-f]+$" OR LEN LESS 40)
+    set (OUT)
+  endif ()
+  set (${SHA} "${OUT}" PARENT_SCOPE)
+endfunction ()
+
 # ----------------------------------------------------------------------------
 # @brief Determine whether or not a given directory is a Git repository
 function (basis_is_git_repository FLAG DIR)
+  basis_git_find_dir (GIT_DIR "${DIR}")
+  if (GIT_DIR)
+    set (${FLAG} "TRUE" PARENT_SCOPE)
+    return ()
+  endif ()
   if (GITCOMMAND AND NOT GIT_EXECUTABLE)
     set (GIT_EXECUTABLE GITCOMMAND)
   endif ()
-  if (GIT_EXECUTABLE)
+  # Git directory may only be located using the GIT_DIR environment variable
+  if (GIT_EXECUTABLE AND DEFINED ENV{GIT_DIR})
     execute_process (
       COMMAND "${GIT_EXECUTABLE}" rev-parse
       WORKING_DIRECTORY "${DIR}"
@@ -195,9 +287,20 @@ function (basis_git_get_revision URL REV)
   if (GITCOMMAND AND NOT GIT_EXECUTABLE)
     set (GIT_EXECUTABLE GITCOMMAND)
   endif ()
-  if (GIT_EXECUTABLE)
-    # remove "file://" from URL
-    string (REGEX REPLACE "file://" "" DIR "${URL}")
+  # remove "file://" from URL
+  string (REGEX REPLACE "file://" "" DIR "${URL}")
+  # read Git commit SHA of HEAD from Git directory without running git
+  set (SHA)
+  if (IS_DIRECTORY "${DIR}")
+    basis_git_find_dir (GIT_DIR "${DIR}")
+    if (GIT_DIR)
+      basis_git_read_head ("${GIT_DIR}" SHA)
+      if (SHA)
+        set (OUT "${SHA}")
+      endif ()
+    endif ()
+  endif ()
+  if (GIT_EXECUTABLE AND NOT SHA)
     # retrieve Git commit SHA of HEAD
     if (IS_DIRECTORY "${DIR}")
       execute_process (
@@ -26,6 +26,10 @@ mark_as_advanced(BASIS_ALWAYS_RECONFIGURE_SUPER_BUILD)
 ##
 # @brief super build for BASIS modules
 #
+# The external project depends on those external projects named by the
+# DEPENDS argument which were added before. Independent external projects
+# are thus configured and built concurrently by a parallel build.
+#
 function(basis_super_build PACKAGE_NAME)
   set(options )
   set(singleValueArgs DIR CMAKE_MODULE_PATH BINARY_DIR CMAKE_INSTALL_PREFIX)
@@ -70,13 +74,14 @@ function(basis_super_build PACKAGE_NAME)
   # only specifiy dependencies that are actual targets
   # otherwise there would be an error
   set(SUPER_BUILD_TARGET_DEPENDENCIES)
-  foreach(DEPENDENCY IN ${DEPENDS})
-    if(TARGET DEPENDENCY)
+  foreach(DEPENDENCY IN LISTS ${PACKAGE_NAME}_DEPENDS)
+    if(TARGET ${DEPENDENCY})
       list(APPEND SUPER_BUILD_TARGET_DEPENDENCIES ${DEPENDENCY})
     endif()
   endforeach()
-    
-  string(REPLACE ";" " " SUPER_BUILD_TARGET_DEPENDENCIES "${SUPER_BUILD_TARGET_DEPENDENCIES}")
+  if(SUPER_BUILD_TARGET_DEPENDENCIES)
+    list(REMOVE_DUPLICATES SUPER_BUILD_TARGET_DEPENDENCIES)
+  endif()
   
   if(BASIS_DEBUG)
       message(STATUS 
@@ -89,6 +94,7 @@ function(basis_super_build PACKAGE_NAME)
                             -DCMAKE_CXX_FLAGS=${CMAKE_CXX_FLAGS} 
                             -DCMAKE_C_FLAGS=${CMAKE_C_FLAGS} 
                             -DCMAKE_BUILD_TYPE=${CMAKE_BUILD_TYPE} 
+                            -DBASIS_PROBE_CACHE_DIR=${BASIS_PROBE_CACHE_DIR}
                             ${${PACKAGE_NAME}_CMAKE_MODULE_PATH}
                             ${BASIS_SUPER_BUILD_ARGS}
                           CMAKE_CHACHE_ARGS
@@ -118,6 +124,7 @@ function(basis_super_build PACKAGE_NAME)
                             -DCMAKE_CXX_FLAGS=${CMAKE_CXX_FLAGS} 
                             -DCMAKE_C_FLAGS=${CMAKE_C_FLAGS} 
                             -DCMAKE_BUILD_TYPE=${CMAKE_BUILD_TYPE} 
+                            -DBASIS_PROBE_CACHE_DIR=${BASIS_PROBE_CACHE_DIR}
                             ${${PACKAGE_NAME}_CMAKE_MODULE_PATH}
                             ${BASIS_SUPER_BUILD_ARGS}
                           CMAKE_CHACHE_ARGS
@@ -560,6 +560,84 @@ macro (_basis_target_source_language)
   endif ()
 endmacro ()
 
+# ----------------------------------------------------------------------------
+## @brief Set up precompiled headers and unity build of C++ target.
+#
+# Used by basis_add_executable_target() and basis_add_library_target() to
+# apply the parsed @c PRECOMPILE_HEADERS, @c [NO_]UNITY_BUILD and
+# @c UNITY_BUILD_BATCH_SIZE options to the target @c TARGET_UID.
+# Both features require CMake 3.16 or later.
+macro (_basis_target_pch_and_unity_build)
+  if (ARGN_UNITY_BUILD AND ARGN_NO_UNITY_BUILD)
+    message (FATAL_ERROR "Target ${TARGET_UID}: Options UNITY_BUILD and NO_UNITY_BUILD are mutually exclusive!")
+  endif ()
+  if (NOT ARGN_UNITY_BUILD_BATCH_SIZE MATCHES "^[0-9]+$")
+    if (NOT "${ARGN_UNITY_BUILD_BATCH_SIZE}" STREQUAL "")
+      message (FATAL_ERROR "Target ${TARGET_UID}: Invalid UNITY_BUILD_BATCH_SIZE: ${ARGN_UNITY_BUILD_BATCH_SIZE}! Must be a non-negative integer.")
+    endif ()
+    set (ARGN_UNITY_BUILD_BATCH_SIZE "${BASIS_UNITY_BUILD_BATCH_SIZE}")
+  endif ()
+  if (CMAKE_VERSION VERSION_LESS 3.16)
+    if (ARGN_PRECOMPILE_HEADERS OR ARGN_UNITY_BUILD)
+      message (WARNING "Target ${TARGET_UID}: Options PRECOMPILE_HEADERS and UNITY_BUILD require CMake 3.16 or later and are ignored!")
+    endif ()
+  else ()
+    if (ARGN_PRECOMPILE_HEADERS)
+      target_precompile_headers (${TARGET_UID} PRIVATE ${ARGN_PRECOMPILE_HEADERS})
+    endif ()
+    if (ARGN_UNITY_BUILD OR (BASIS_UNITY_BUILD AND NOT ARGN_NO_UNITY_BUILD))
+      set_target_properties (${TARGET_UID} PROPERTIES UNITY_BUILD ON)
+      if (ARGN_UNITY_BUILD_BATCH_SIZE MATCHES "^[0-9]+$")
+        set_target_properties (${TARGET_UID} PROPERTIES UNITY_BUILD_BATCH_SIZE ${ARGN_UNITY_BUILD_BATCH_SIZE})
+      endif ()
+    elseif (ARGN_NO_UNITY_BUILD)
+      set_target_properties (${TARGET_UID} PROPERTIES UNITY_BUILD OFF)
+    endif ()
+  endif ()
+endmacro ()
+
+# ----------------------------------------------------------------------------
+## @brief Remove precompiled header and unity build options from arguments.
+#
+# Used by basis_add_executable() and basis_add_library() to drop the options
+# which are not supported by the target of a language other than C++. The
+# options are removed by their position rather than by value such that source
+# files named like one of the headers remain in the list. The option values
+# are those parsed by the caller into @c ARGN_PRECOMPILE_HEADERS and
+# @c ARGN_UNITY_BUILD_BATCH_SIZE.
+#
+# @param [out] ARGS Name of output variable set to the remaining arguments.
+# @param [in]  ARGN Arguments of the calling function.
+function (_basis_target_remove_pch_and_unity_build_options ARGS)
+  set (REMAINING)
+  set (HEADERS ${ARGN_PRECOMPILE_HEADERS})
+  set (KEYWORD)
+  foreach (ARG IN LISTS ARGN)
+    set (DROP FALSE)
+    if ("^${KEYWORD}$" STREQUAL "^PRECOMPILE_HEADERS$" AND HEADERS)
+      list (GET HEADERS 0 HEADER)
+      if ("^${ARG}$" STREQUAL "^${HEADER}$")
+        list (REMOVE_AT HEADERS 0)
+        set (DROP TRUE)
+      endif ()
+    elseif ("^${KEYWORD}$" STREQUAL "^UNITY_BUILD_BATCH_SIZE$")
+      if ("^${ARG}$" STREQUAL "^${ARGN_UNITY_BUILD_BATCH_SIZE}$")
+        set (DROP TRUE)
+        set (KEYWORD)
+      endif ()
+    endif ()
+    if (NOT DROP)
+      set (KEYWORD)
+      if (ARG MATCHES "^(PRECOMPILE_HEADERS|UNITY_BUILD_BATCH_SIZE)$")
+        set (KEYWORD "${ARG}")
+      elseif (NOT ARG MATCHES "^(NO_)?UNITY_BUILD$")
+        list (APPEND REMAINING "${ARG}")
+      endif ()
+    endif ()
+  endforeach ()
+  set (${ARGS} "${REMAINING}" PARENT_SCOPE)
+endfunction ()
+
 # ----------------------------------------------------------------------------
 ## @brief Add executable target.
 #
@@ -711,6 +789,28 @@ endmacro ()
 #         using this option or calling basis_finalize_targets() at the end of each
 #         CMakeLists.txt file.</td>
 #   </tr>
+#   <tr>
+#     @tp @b CMDLINE_SCHEMA XML|JSON @endtp
+#     <td>Write a machine-readable description of the command-line interface of
+#         an executable built from C++ sources which uses basis::CmdLine to a file
+#         next to the executable after each build. See basis_add_executable_target().
+#         (default: @c BASIS_CMDLINE_SCHEMA)</td>
+#   </tr>
+#   <tr>
+#     @tp @b PRECOMPILE_HEADERS header1 [header2...] @endtp
+#     <td>Headers to precompile for an executable built from C++ sources.
+#         See basis_add_executable_target().</td>
+#   </tr>
+#   <tr>
+#     @tp @b [NO_]UNITY_BUILD @endtp
+#     <td>Whether to compile the C++ sources of the executable in batches.
+#         See basis_add_executable_target(). (default: @c BASIS_UNITY_BUILD)</td>
+#   </tr>
+#   <tr>
+#     @tp @b UNITY_BUILD_BATCH_SIZE n @endtp
+#     <td>Maximum number of C++ source files compiled as one unity source.
+#         (default: @c BASIS_UNITY_BUILD_BATCH_SIZE)</td>
+#   </tr>
 # </table>
 #
 # @returns Adds an executable build target. In case of an executable which is
@@ -724,13 +824,14 @@ endmacro ()
 #
 # @ingroup CMakeAPI
 function (basis_add_executable TARGET_NAME)
+  basis_profile_begin (basis_add_executable "${TARGET_NAME}")
   # --------------------------------------------------------------------------
   # parse arguments
   CMAKE_PARSE_ARGUMENTS (
     ARGN
-      "EXECUTABLE;LIBEXEC;NO_BASIS_UTILITIES;USE_BASIS_UTILITIES;EXPORT;NOEXPORT;FINAL"
-      "COMPONENT;DESTINATION;LANGUAGE"
-      ""
+      "EXECUTABLE;LIBEXEC;NO_BASIS_UTILITIES;USE_BASIS_UTILITIES;EXPORT;NOEXPORT;FINAL;UNITY_BUILD;NO_UNITY_BUILD"
+      "COMPONENT;DESTINATION;LANGUAGE;CMDLINE_SCHEMA;UNITY_BUILD_BATCH_SIZE"
+      "PRECOMPILE_HEADERS"
     ${ARGN}
   )
   # derive target name from path if existing source path is given as first argument instead
@@ -769,7 +870,17 @@ function (basis_add_executable TARGET_NAME)
   foreach (ARG IN LISTS ARGN_UNPARSED_ARGUMENTS)
     list (REMOVE_ITEM ARGN "${ARG}")
   endforeach ()
-  list (APPEND ARGN ${SOURCES})
+  set (ARGN ${SOURCES} ${ARGN})
+  if (ARGN_CMDLINE_SCHEMA AND NOT ARGN_LANGUAGE MATCHES "CXX")
+    message (WARNING "Target ${TARGET_UID}: Option CMDLINE_SCHEMA only supported for C++ executables!")
+    list (REMOVE_ITEM ARGN CMDLINE_SCHEMA ${ARGN_CMDLINE_SCHEMA})
+  endif ()
+  if (NOT ARGN_LANGUAGE MATCHES "CXX")
+    if (ARGN_PRECOMPILE_HEADERS OR ARGN_UNITY_BUILD OR NOT "${ARGN_UNITY_BUILD_BATCH_SIZE}" STREQUAL "")
+      message (WARNING "Target ${TARGET_UID}: Options PRECOMPILE_HEADERS and UNITY_BUILD only supported for C++ executables!")
+    endif ()
+    _basis_target_remove_pch_and_unity_build_options (ARGN ${ARGN})
+  endif ()
   # --------------------------------------------------------------------------
   # C++
   if (ARGN_LANGUAGE MATCHES "CXX")
@@ -797,12 +908,15 @@ function (basis_add_executable TARGET_NAME)
   endif ()
   # --------------------------------------------------------------------------
   # re-glob source files before each build (if necessary)
-  if (TARGET __${TARGET_UID})
+  basis_get_project_property (GLOB_TARGETS PROPERTY GLOB_TARGETS)
+  list (FIND GLOB_TARGETS "${TARGET_UID}" IDX)
+  if (NOT IDX EQUAL -1)
     if (TARGET _${TARGET_UID})
-      add_dependencies (_${TARGET_UID} __${TARGET_UID})
+      add_dependencies (_${TARGET_UID} __glob)
     endif ()
-    add_dependencies (${TARGET_UID} __${TARGET_UID})
+    add_dependencies (${TARGET_UID} __glob)
   endif ()
+  basis_profile_end (basis_add_executable)
 endfunction ()
 
 # ----------------------------------------------------------------------------
@@ -999,6 +1113,21 @@ endfunction ()
 #         using this option or calling basis_finalize_targets() at the end of each
 #         CMakeLists.txt file.</td>
 #   </tr>
+#   <tr>
+#     @tp @b PRECOMPILE_HEADERS header1 [header2...] @endtp
+#     <td>Headers to precompile for a library built from C++ sources.
+#         See basis_add_library_target().</td>
+#   </tr>
+#   <tr>
+#     @tp @b [NO_]UNITY_BUILD @endtp
+#     <td>Whether to compile the C++ sources of the library in batches.
+#         See basis_add_library_target(). (default: @c BASIS_UNITY_BUILD)</td>
+#   </tr>
+#   <tr>
+#     @tp @b UNITY_BUILD_BATCH_SIZE n @endtp
+#     <td>Maximum number of C++ source files compiled as one unity source.
+#         (default: @c BASIS_UNITY_BUILD_BATCH_SIZE)</td>
+#   </tr>
 # </table>
 #
 # @returns Adds a library build target. In case of a library not written in C++
@@ -1013,13 +1142,14 @@ endfunction ()
 #
 # @ingroup CMakeAPI
 function (basis_add_library TARGET_NAME)
+  basis_profile_begin (basis_add_library "${TARGET_NAME}")
   # --------------------------------------------------------------------------
   # parse arguments
   CMAKE_PARSE_ARGUMENTS (
     ARGN
-      "STATIC;SHARED;MODULE;MEX;USE_BASIS_UTILITIES;NO_BASIS_UTILITIES;EXPORT;NOEXPORT;FINAL"
-      "COMPONENT;RUNTIME_COMPONENT;LIBRARY_COMPONENT;DESTINATION;RUNTIME_DESTINATION;LIBRARY_DESTINATION;LANGUAGE"
-      ""
+      "STATIC;SHARED;MODULE;MEX;USE_BASIS_UTILITIES;NO_BASIS_UTILITIES;EXPORT;NOEXPORT;FINAL;UNITY_BUILD;NO_UNITY_BUILD"
+      "COMPONENT;RUNTIME_COMPONENT;LIBRARY_COMPONENT;DESTINATION;RUNTIME_DESTINATION;LIBRARY_DESTINATION;LANGUAGE;UNITY_BUILD_BATCH_SIZE"
+      "PRECOMPILE_HEADERS"
     ${ARGN}
   )
   # derive target name from path if existing source path is given as first argument instead
@@ -1061,7 +1191,13 @@ function (basis_add_library TARGET_NAME)
   foreach (ARG IN LISTS ARGN_UNPARSED_ARGUMENTS)
     list (REMOVE_ITEM ARGN "${ARG}")
   endforeach ()
-  list (APPEND ARGN ${SOURCES})
+  set (ARGN ${SOURCES} ${ARGN})
+  if (ARGN_MEX OR NOT ARGN_LANGUAGE MATCHES "CXX")
+    if (ARGN_PRECOMPILE_HEADERS OR ARGN_UNITY_BUILD OR NOT "${ARGN_UNITY_BUILD_BATCH_SIZE}" STREQUAL "")
+      message (WARNING "Target ${TARGET_UID}: Options PRECOMPILE_HEADERS and UNITY_BUILD only supported for C++ libraries!")
+    endif ()
+    _basis_target_remove_pch_and_unity_build_options (ARGN ${ARGN})
+  endif ()
   # --------------------------------------------------------------------------
   # C++
   if (ARGN_LANGUAGE MATCHES "CXX")
@@ -1102,12 +1238,15 @@ function (basis_add_library TARGET_NAME)
   endif ()
   # --------------------------------------------------------------------------
   # re-glob source files before each build (if necessary)
-  if (TARGET __${TARGET_UID})
+  basis_get_project_property (GLOB_TARGETS PROPERTY GLOB_TARGETS)
+  list (FIND GLOB_TARGETS "${TARGET_UID}" IDX)
+  if (NOT IDX EQUAL -1)
     if (TARGET _${TARGET_UID})
-      add_dependencies (_${TARGET_UID} __${TARGET_UID})
+      add_dependencies (_${TARGET_UID} __glob)
     endif ()
-    add_dependencies (${TARGET_UID} __${TARGET_UID})
+    add_dependencies (${TARGET_UID} __glob)
   endif ()
+  basis_profile_end (basis_add_library)
 endfunction ()
 
 # ----------------------------------------------------------------------------
@@ -1603,6 +1742,7 @@ endfunction ()
 # @sa basis_build_mcc_target()
 # @sa basis_build_mex_file()
 function (basis_finalize_targets)
+  basis_profile_begin (basis_finalize_targets)
   if (ARGN)
     set (TARGETS)
     foreach (TARGET_NAME ${ARGN})
@@ -1612,6 +1752,7 @@ function (basis_finalize_targets)
   else ()
     basis_get_project_property (TARGETS PROPERTY TARGETS)
     if (NOT TARGETS)
+      basis_profile_end (basis_finalize_targets)
       return()
     endif ()
     # targets of BASIS utilities are finalized separately
@@ -1657,6 +1798,7 @@ function (basis_finalize_targets)
     list (APPEND FINALIZED_TARGETS ${TARGET_UID})
   endforeach ()
   basis_set_project_property (PROPERTY FINALIZED_TARGETS ${FINALIZED_TARGETS})
+  basis_profile_end (basis_finalize_targets)
 endfunction ()
 
 # ============================================================================
@@ -1781,6 +1923,35 @@ endfunction ()
 #         and hence a link dependency on the BASIS utilities library has to be added.
 #         (default: @c BASIS_UTILITIES)</td>
 #   </tr>
+#   <tr>
+#     @tp @b CMDLINE_SCHEMA XML|JSON @endtp
+#     <td>Run the executable with the --helpxml or --helpjson option of basis::CmdLine
+#         after each build and save the output as &lt;name&gt;.xml or &lt;name&gt;.json,
+#         respectively, in the runtime output directory. The file is installed along
+#         with the executable. The path of the file is stored in the @c CMDLINE_SCHEMA
+#         property of the target. Ignored when cross-compiling.
+#         (default: @c BASIS_CMDLINE_SCHEMA)</td>
+#   </tr>
+#   <tr>
+#     @tp @b PRECOMPILE_HEADERS header1 [header2...] @endtp
+#     <td>Headers which are precompiled and included by each source file of the
+#         executable. Headers can be given as paths relative to the current source
+#         directory or as <tt>&lt;name&gt;</tt> to be searched in the include
+#         directories. Requires CMake 3.16 or later.</td>
+#   </tr>
+#   <tr>
+#     @tp @b [NO_]UNITY_BUILD @endtp
+#     <td>Whether to combine the source files of the executable into unity sources
+#         which are each compiled at once. Source files with the
+#         @c SKIP_UNITY_BUILD_INCLUSION property are compiled separately.
+#         Requires CMake 3.16 or later. (default: @c BASIS_UNITY_BUILD)</td>
+#   </tr>
+#   <tr>
+#     @tp @b UNITY_BUILD_BATCH_SIZE n @endtp
+#     <td>Maximum number of source files combined into one unity source,
+#         where 0 combines all source files of the executable.
+#         (default: @c BASIS_UNITY_BUILD_BATCH_SIZE)</td>
+#   </tr>
 # </table>
 #
 # @returns Adds executable target using CMake's add_executable() command.
@@ -1794,13 +1965,22 @@ function (basis_add_executable_target TARGET_NAME)
   # parse arguments
   CMAKE_PARSE_ARGUMENTS (
     ARGN
-      "USE_BASIS_UTILITIES;NO_BASIS_UTILITIES;EXPORT;NOEXPORT;LIBEXEC"
-      "COMPONENT;DESTINATION"
-      ""
+      "USE_BASIS_UTILITIES;NO_BASIS_UTILITIES;EXPORT;NOEXPORT;LIBEXEC;UNITY_BUILD;NO_UNITY_BUILD"
+      "COMPONENT;DESTINATION;CMDLINE_SCHEMA;UNITY_BUILD_BATCH_SIZE"
+      "PRECOMPILE_HEADERS"
     ${ARGN}
   )
   set (SOURCES ${ARGN_UNPARSED_ARGUMENTS})
   basis_set_flag (ARGN EXPORT  ${BASIS_EXPORT_DEFAULT})
+  if (NOT ARGN_CMDLINE_SCHEMA)
+    set (ARGN_CMDLINE_SCHEMA "${BASIS_CMDLINE_SCHEMA}")
+  endif ()
+  if (ARGN_CMDLINE_SCHEMA)
+    string (TOLOWER "${ARGN_CMDLINE_SCHEMA}" ARGN_CMDLINE_SCHEMA)
+    if (NOT ARGN_CMDLINE_SCHEMA MATCHES "^(xml|json)$")
+      message (FATAL_ERROR "Target ${TARGET_UID}: Invalid CMDLINE_SCHEMA format: ${ARGN_CMDLINE_SCHEMA}! Must be either XML or JSON.")
+    endif ()
+  endif ()
   if (ARGN_USE_BASIS_UTILITIES AND ARGN_NO_BASIS_UTILITIES)
     message (FATAL_ERROR "Target ${TARGET_UID}: Options USE_BASIS_UTILITIES and NO_BASIS_UTILITIES are mutually exclusive!")
   endif ()
@@ -1853,6 +2033,8 @@ function (basis_add_executable_target TARGET_NAME)
     set_target_properties (${TARGET_UID} PROPERTIES LIBEXEC 0)
   endif ()
   set_target_properties (${TARGET_UID} PROPERTIES TEST ${IS_TEST})
+  # precompiled headers and unity build
+  _basis_target_pch_and_unity_build ()
   # output directory
   if (IS_TEST)
     if (ARGN_LIBEXEC)
@@ -1873,6 +2055,22 @@ function (basis_add_executable_target TARGET_NAME)
   else ()
     set_target_properties (${TARGET_UID} PROPERTIES BASIS_UTILITIES FALSE)
   endif ()
+  # description of command-line interface
+  set (SCHEMA_FILE)
+  if (ARGN_CMDLINE_SCHEMA AND NOT CMAKE_CROSSCOMPILING)
+    get_target_property (SCHEMA_DIR ${TARGET_UID} RUNTIME_OUTPUT_DIRECTORY)
+    set (SCHEMA_FILE "${SCHEMA_DIR}/${OUTPUT_NAME}.${ARGN_CMDLINE_SCHEMA}")
+    add_custom_command (
+      TARGET ${TARGET_UID} POST_BUILD
+      COMMAND "${CMAKE_COMMAND}"
+          "-DCOMMAND=$<TARGET_FILE:${TARGET_UID}>$<SEMICOLON>--help${ARGN_CMDLINE_SCHEMA}"
+          "-DOUTPUT_FILE=${SCHEMA_FILE}"
+          -P "${BASIS_SCRIPT_EXECUTE_PROCESS}"
+      COMMENT "Writing command-line description of ${TARGET_UID}..."
+      VERBATIM
+    )
+    set_target_properties (${TARGET_UID} PROPERTIES CMDLINE_SCHEMA "${SCHEMA_FILE}")
+  endif ()
   # export
   set (EXPORT_OPT)
   if (EXPORT)
@@ -1888,6 +2086,13 @@ function (basis_add_executable_target TARGET_NAME)
         DESTINATION "${ARGN_DESTINATION}"
         COMPONENT   "${ARGN_COMPONENT}"
       )
+      if (SCHEMA_FILE)
+        install (
+          FILES       "${SCHEMA_FILE}"
+          DESTINATION "${ARGN_DESTINATION}"
+          COMPONENT   "${ARGN_COMPONENT}"
+        )
+      endif ()
     endif ()
   endif ()
   # done
@@ -1989,6 +2194,26 @@ endfunction ()
 #         and hence a link dependency on the BASIS utilities library shall be added.
 #         (default: @c BASIS_UTILITIES)</td>
 #   </tr>
+#   <tr>
+#     @tp @b PRECOMPILE_HEADERS header1 [header2...] @endtp
+#     <td>Headers which are precompiled and included by each source file of the
+#         library. Headers can be given as paths relative to the current source
+#         directory or as <tt>&lt;name&gt;</tt> to be searched in the include
+#         directories. Requires CMake 3.16 or later.</td>
+#   </tr>
+#   <tr>
+#     @tp @b [NO_]UNITY_BUILD @endtp
+#     <td>Whether to combine the source files of the library into unity sources
+#         which are each compiled at once. Source files with the
+#         @c SKIP_UNITY_BUILD_INCLUSION property are compiled separately.
+#         Requires CMake 3.16 or later. (default: @c BASIS_UNITY_BUILD)</td>
+#   </tr>
+#   <tr>
+#     @tp @b UNITY_BUILD_BATCH_SIZE n @endtp
+#     <td>Maximum number of source files combined into one unity source,
+#         where 0 combines all source files of the library.
+#         (default: @c BASIS_UNITY_BUILD_BATCH_SIZE)</td>
+#   </tr>
 # </table>
 #
 # @returns Adds library target using CMake's add_library() command.
@@ -2010,9 +2235,9 @@ function (basis_add_library_target TARGET_NAME)
   # parse arguments
   CMAKE_PARSE_ARGUMENTS (
     ARGN
-      "STATIC;SHARED;MODULE;USE_BASIS_UTILITIES;NO_BASIS_UTILITIES;EXPORT;NOEXPORT"
-      "COMPONENT;RUNTIME_COMPONENT;LIBRARY_COMPONENT;DESTINATION;RUNTIME_DESTINATION;LIBRARY_DESTINATION"
-      ""
+      "STATIC;SHARED;MODULE;USE_BASIS_UTILITIES;NO_BASIS_UTILITIES;EXPORT;NOEXPORT;UNITY_BUILD;NO_UNITY_BUILD"
+      "COMPONENT;RUNTIME_COMPONENT;LIBRARY_COMPONENT;DESTINATION;RUNTIME_DESTINATION;LIBRARY_DESTINATION;UNITY_BUILD_BATCH_SIZE"
+      "PRECOMPILE_HEADERS"
     ${ARGN}
   )
   set (SOURCES ${ARGN_UNPARSED_ARGUMENTS})
@@ -2116,6 +2341,8 @@ function (basis_add_library_target TARGET_NAME)
   endif ()
   basis_get_target_name (OUTPUT_NAME ${TARGET_UID})
   set_target_properties (${TARGET_UID} PROPERTIES BASIS_TYPE "${TYPE}_LIBRARY" LANGUAGE "CXX" OUTPUT_NAME "${OUTPUT_NAME}")
+  # precompiled headers and unity build
+  _basis_target_pch_and_unity_build ()
   # output directory
   if (IS_TEST)
     set_target_properties (
@@ -3057,6 +3284,10 @@ endfunction ()
 # by basis_project_end(), i.e., the end of the root CMake configuration file
 # of the (sub-)project.
 #
+# The modules are built in batches of at most @c BASIS_SCRIPT_BATCH_SIZE
+# modules. Each batch is configured by a single build command which runs
+# the build script generated from configure_scripts.cmake.in.
+#
 # @param [in] TARGET_UID Name/UID of custom target added by basis_add_script_library().
 #
 # @sa basis_add_script_library()
@@ -3147,7 +3378,19 @@ function (basis_build_script_library TARGET_UID)
   if (COMPILE)
     list (APPEND OPTIONS COMPILE)
   endif ()
-  # add build command for each module
+  # add build command for each batch of modules
+  if (BASIS_SCRIPT_BATCH_SIZE GREATER 0)
+    set (BATCH_SIZE ${BASIS_SCRIPT_BATCH_SIZE})
+  else ()
+    set (BATCH_SIZE 1)
+  endif ()
+  list (LENGTH SOURCES NUM_SOURCES)
+  set (I 0)                                             # number of processed modules
+  set (BATCH 0)                                         # number of batches
+  set (BATCH_MODULES)                                   # indices of modules in current batch
+  set (BATCH_CODE)                                      # CMake code to set module settings
+  set (BATCH_SOURCES)                                   # source files of current batch
+  set (BATCH_OUTPUT_FILES)                              # output files of current batch
   set (OUTPUT_FILES)                                    # list of all output files
   set (FILES_TO_COPY)                                   # relative paths of build tree modules
   set (FILES_TO_INSTALL)                                # list of output files for installation
@@ -3162,7 +3405,6 @@ function (basis_build_script_library TARGET_UID)
   foreach (SOURCE_FILE IN LISTS SOURCES)
     file (RELATIVE_PATH S "${SOURCE_DIRECTORY}" "${SOURCE_FILE}")
     string (REGEX REPLACE "\\.in$" "" S "${S}")
-    basis_get_source_target_name (BUILD_SCRIPT_NAME "build_${S}")
     # arguments of build script
     if (PREFIX)
       set (S "${PREFIX}${S}")
@@ -3180,10 +3422,7 @@ function (basis_build_script_library TARGET_UID)
       set (INSTALL_FILE)
       set (DESTINATION)
     endif ()
-    # configure build script
-    set (BUILD_SCRIPT "${BUILD_DIR}/${BUILD_SCRIPT_NAME}.cmake")
-    configure_file ("${BASIS_MODULE_PATH}/configure_script.cmake.in" "${BUILD_SCRIPT}" @ONLY)
-    # output files of this command
+    # output files of this module
     set (_OUTPUT_FILES "${OUTPUT_FILE}")
     if (INSTALL_FILE)
       list (APPEND _OUTPUT_FILES "${INSTALL_FILE}")
@@ -3228,23 +3467,49 @@ function (basis_build_script_library TARGET_UID)
     elseif (INSTALL_FILE)
       list (APPEND FILES_TO_INSTALL "${INSTALL_FILE}")
     endif ()
-    # add build command
-    if (OUTPUT_CFILE)
-      file (RELATIVE_PATH REL "${CMAKE_BINARY_DIR}" "${OUTPUT_CFILE}")
-    else ()
-      file (RELATIVE_PATH REL "${CMAKE_BINARY_DIR}" "${OUTPUT_FILE}")
+    # add module to current batch
+    math (EXPR I "${I} + 1")
+    list (LENGTH BATCH_MODULES M)
+    math (EXPR M "${M} + 1")
+    list (APPEND BATCH_MODULES ${M})
+    list (APPEND BATCH_SOURCES "${SOURCE_FILE}")
+    list (APPEND BATCH_OUTPUT_FILES ${_OUTPUT_FILES})
+    set (BATCH_CODE "${BATCH_CODE}set (MODULE_${M}_SOURCE_FILE  \"${SOURCE_FILE}\")\n")
+    set (BATCH_CODE "${BATCH_CODE}set (MODULE_${M}_OUTPUT_FILE  \"${OUTPUT_FILE}\")\n")
+    set (BATCH_CODE "${BATCH_CODE}set (MODULE_${M}_INSTALL_FILE \"${INSTALL_FILE}\")\n")
+    set (BATCH_CODE "${BATCH_CODE}set (MODULE_${M}_DIRECTORY    \"${OUTPUT_DIR}\")\n")
+    set (BATCH_CODE "${BATCH_CODE}set (MODULE_${M}_DESTINATION  \"${DESTINATION}\")\n")
+    set (BATCH_CODE "${BATCH_CODE}set (MODULE_${M}_OUTPUT_FILES \"${_OUTPUT_FILES}\")\n")
+    # add build command for complete batch
+    if (M EQUAL BATCH_SIZE OR I EQUAL NUM_SOURCES)
+      math (EXPR BATCH "${BATCH} + 1")
+      set (MODULES "${BATCH_CODE}set (MODULES ${BATCH_MODULES})")
+      set (BUILD_SCRIPT "${BUILD_DIR}/build_${BATCH}.cmake")
+      configure_file ("${BASIS_MODULE_PATH}/configure_scripts.cmake.in" "${BUILD_SCRIPT}" @ONLY)
+      if (M EQUAL 1)
+        if (OUTPUT_CFILE)
+          file (RELATIVE_PATH REL "${CMAKE_BINARY_DIR}" "${OUTPUT_CFILE}")
+        else ()
+          file (RELATIVE_PATH REL "${CMAKE_BINARY_DIR}" "${OUTPUT_FILE}")
+        endif ()
+        set (COMMENT "Building ${LANGUAGE} module ${REL}...")
+      else ()
+        set (COMMENT "Building ${M} ${LANGUAGE} modules of ${TARGET_UID} (batch ${BATCH})...")
+      endif ()
+      add_custom_command (
+        OUTPUT          ${BATCH_OUTPUT_FILES}
+        COMMAND         "${CMAKE_COMMAND}" -D "CONFIGURATION=$<${BASIS_GE_CONFIG}>" -P "${BUILD_SCRIPT}"
+        DEPENDS         ${BATCH_SOURCES} "${BUILD_SCRIPT}" "${BASIS_MODULE_PATH}/CommonTools.cmake" # basis_configure_script() definition
+        COMMENT         "${COMMENT}"
+        VERBATIM
+      )
+      # add output files of command to list of all output files
+      list (APPEND OUTPUT_FILES ${BATCH_OUTPUT_FILES})
+      set (BATCH_MODULES)
+      set (BATCH_CODE)
+      set (BATCH_SOURCES)
+      set (BATCH_OUTPUT_FILES)
     endif ()
-    set (COMMENT "Building ${LANGUAGE} module ${REL}...")
-    add_custom_command (
-      OUTPUT          ${_OUTPUT_FILES}
-      COMMAND         "${CMAKE_COMMAND}" -D "CONFIGURATION=$<${BASIS_GE_CONFIG}>" -P "${BUILD_SCRIPT}"
-      MAIN_DEPENDENCY "${SOURCE_FILE}"
-      DEPENDS         "${BUILD_SCRIPT}" "${BASIS_MODULE_PATH}/CommonTools.cmake" # basis_configure_script() definition
-      COMMENT         "${COMMENT}"
-      VERBATIM
-    )
-    # add output files of command to list of all output files
-    list (APPEND OUTPUT_FILES ${_OUTPUT_FILES})
   endforeach ()
   # add custom target to build modules
   add_custom_target (_${TARGET_UID} DEPENDS ${OUTPUT_FILES})
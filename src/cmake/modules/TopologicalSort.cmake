@@ -144,3 +144,66 @@ function(topological_sort LIST PREFIX SUFFIX)
 
   set(${LIST} ${${LIST}} PARENT_SCOPE)
 endfunction(topological_sort)
+
+##############################################################################
+# @brief Group the elements of a list by dependency level.
+#
+#   topological_levels(my_list "MY_" "_EDGES" MY_LEVELS)
+#
+# The edges are given as for topological_sort(). Each element of the
+# list is assigned to the lowest level which is greater than the levels of
+# all elements that can be reached by following its outgoing edges. Elements
+# without outgoing edges are at level 0. The elements of one level do not
+# depend on each other and can thus be processed concurrently once all
+# elements of the lower levels have been processed.
+#
+# The variable named by LEVELS is set to the number of levels and the
+# variable ${LEVELS}_<n> to the list of elements at level n. Elements
+# which are reached by following the outgoing edges but which are not
+# contained in LIST are not assigned to any level. The variable named by
+# LIST is set to the concatenation of all levels, which is a valid reverse
+# topological ordering of its elements. Given the example dependency graph
+# of topological_sort(), MY_LEVELS is set to 3 and MY_LEVELS_0, MY_LEVELS_1,
+# and MY_LEVELS_2 are set to b, a, and c, respectively.
+#
+# @ingroup CMakeUtilities
+##############################################################################
+function(topological_levels LIST PREFIX SUFFIX LEVELS)
+  set(VERTICES "${${LIST}}")
+  set(SORTED "${VERTICES}")
+  topological_sort(SORTED "${PREFIX}" "${SUFFIX}")
+  # Mark the vertices to be grouped by level
+  foreach(VERTEX ${VERTICES})
+    set(IN_LIST_${VERTEX} TRUE)
+  endforeach(VERTEX)
+  # Each vertex comes after the vertices it depends on in the sorted list
+  set(NUM_LEVELS 0)
+  set(${LIST})
+  foreach(VERTEX ${SORTED})
+    set(LEVEL 0)
+    foreach(EDGE ${${PREFIX}${VERTEX}${SUFFIX}})
+      if (DEFINED LEVEL_${EDGE} AND NOT LEVEL_${EDGE} LESS LEVEL)
+        math(EXPR LEVEL "${LEVEL_${EDGE}} + 1")
+      endif ()
+    endforeach(EDGE)
+    if (IN_LIST_${VERTEX})
+      set(LEVEL_${VERTEX} ${LEVEL})
+      list(APPEND VERTICES_${LEVEL} ${VERTEX})
+      if (NOT LEVEL LESS NUM_LEVELS)
+        math(EXPR NUM_LEVELS "${LEVEL} + 1")
+      endif ()
+    elseif (LEVEL GREATER 0)
+      # Vertex not in list which depends on vertices in list
+      math(EXPR LEVEL_${VERTEX} "${LEVEL} - 1")
+    endif ()
+  endforeach(VERTEX)
+  # Return levels
+  set(LEVEL 0)
+  while(LEVEL LESS NUM_LEVELS)
+    list(APPEND ${LIST} ${VERTICES_${LEVEL}})
+    set(${LEVELS}_${LEVEL} "${VERTICES_${LEVEL}}" PARENT_SCOPE)
+    math(EXPR LEVEL "${LEVEL} + 1")
+  endwhile()
+  set(${LEVELS} ${NUM_LEVELS} PARENT_SCOPE)
+  set(${LIST} "${${LIST}}" PARENT_SCOPE)
+endfunction(topological_levels)
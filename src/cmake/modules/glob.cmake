@@ -9,57 +9,63 @@
 
 ##############################################################################
 # @file  glob.cmake
-# @brief Glob source files and optionally compare to previous glob result.
+# @brief Re-glob source files of all globbed targets and compare to previous result.
+#
+# This script is run by the custom target added by basis_add_glob_check().
+# For each target listed in the MANIFEST file, the source files are only
+# globbed again if the modification time of one of the searched directories
+# changed since the last check. If the source files of a target changed, its
+# sources.txt file is touched, which triggers a re-configuration upon the
+# next build, and an error is reported.
 ##############################################################################
 
 include ("${CMAKE_CURRENT_LIST_DIR}/CommonTools.cmake")
 
-if (NOT EXPRESSIONS)
-  message (FATAL_ERROR "Missing EXPRESSIONS argument!")
-endif ()
-if (NOT SOURCES_FILE)
-  message (FATAL_ERROR "Missing SOURCES_FILE argument!")
+if (NOT MANIFEST)
+  message (FATAL_ERROR "Missing MANIFEST argument!")
 endif ()
 
-set (SOURCES)
-foreach (EXPRESSION IN LISTS EXPRESSIONS)
-  if (EXPRESSION MATCHES "[*][*]")
-    string (REPLACE "**" "*" EXPRESSION "${EXPRESSION}")
-    file (GLOB_RECURSE _SOURCES "${EXPRESSION}")
-    list (APPEND SOURCES ${_SOURCES})
-  elseif (EXPRESSION MATCHES "[*?]|\\[[0-9]+-[0-9]+\\]")
-    file (GLOB _SOURCES "${EXPRESSION}")
-    list (APPEND SOURCES ${_SOURCES})
-  else ()
-    list (APPEND SOURCES "${EXPRESSION}")
-  endif ()
-endforeach ()
-if (SOURCES)
-  list (REMOVE_DUPLICATES SOURCES)
-endif ()
+include ("${MANIFEST}")
 
-set (_SOURCES)
-foreach (SOURCE IN LISTS SOURCES)
-  if (SOURCE MATCHES "^\\$<") # preserve generator expressions
-    list (APPEND _SOURCES "${SOURCE}")
-  else ()
-    get_filename_component (SOURCE_NAME "${SOURCE}" NAME)
-    if (NOT SOURCE MATCHES "(^|/).(svn|git)/" AND NOT SOURCE_NAME MATCHES "^\\.")
-      list (APPEND _SOURCES "${SOURCE}")
+set (CHANGED_TARGETS)
+foreach (GLOB_FILE IN LISTS GLOB_FILES)
+  set (GLOB_DIRECTORIES)
+  set (GLOB_TIMESTAMPS)
+  include ("${GLOB_FILE}")
+  # skip targets whose searched directories were not modified
+  set (MODIFIED TRUE)
+  if (GLOB_DIRECTORIES)
+    set (MODIFIED FALSE)
+    set (I 0)
+    foreach (DIR IN LISTS GLOB_DIRECTORIES)
+      list (GET GLOB_TIMESTAMPS ${I} T)
+      file (TIMESTAMP "${DIR}" TIME)
+      if (NOT "${TIME}" STREQUAL "${T}")
+        set (MODIFIED TRUE)
+        break ()
+      endif ()
+      math (EXPR I "${I} + 1")
+    endforeach ()
+  endif ()
+  # re-glob source files
+  if (MODIFIED)
+    get_filename_component (BUILD_DIR "${GLOB_FILE}" PATH)
+    set (SOURCES_FILE "${BUILD_DIR}/sources.txt")
+    include ("${SOURCES_FILE}")
+    basis_get_glob_timestamps (DIRECTORIES TIMESTAMPS ${GLOB_EXPRESSIONS})
+    basis_glob_source_files (SOURCES ${GLOB_EXPRESSIONS})
+    if ("${SOURCES}" STREQUAL "${INITIAL_SOURCES}")
+      basis_write_glob_file ("${GLOB_FILE}" ${GLOB_TARGET} "${GLOB_EXPRESSIONS}" "${DIRECTORIES}" "${TIMESTAMPS}")
+    else ()
+      # touching this file which is included by basis_add_glob_target()
+      # re-triggers CMake upon the next build
+      execute_process (COMMAND "${CMAKE_COMMAND}" -E touch "${SOURCES_FILE}")
+      list (APPEND CHANGED_TARGETS "${GLOB_TARGET}")
     endif ()
   endif ()
 endforeach ()
-set (SOURCES ${_SOURCES})
-unset (_SOURCES)
 
-if (INIT)
-  basis_write_list ("${SOURCES_FILE}" INITIAL_SOURCES ${SOURCES})
-else ()
-  include ("${SOURCES_FILE}")
-  if (NOT "${SOURCES}" STREQUAL "${INITIAL_SOURCES}")
-    # touching this file which is included by basis_add_glob_target()
-    # re-triggers CMake upon the next build
-    execute_process (COMMAND "${CMAKE_COMMAND}" -E touch "${SOURCES_FILE}")
-    message (FATAL_ERROR "${ERRORMSG}")
-  endif ()
+if (CHANGED_TARGETS)
+  string (REPLACE ";" "\n  " CHANGED_TARGETS "${CHANGED_TARGETS}")
+  message (FATAL_ERROR "Source files of the following targets changed:\n  ${CHANGED_TARGETS}\n${ERRORMSG}")
 endif ()
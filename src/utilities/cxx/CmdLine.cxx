@@ -13,8 +13,20 @@
  */
 
 
+#include <map>
 #include <set>
+#include <fstream>
+#include <sstream>
+#include <algorithm> // find
 
+#include <basis/config.h>
+
+#if UNIX
+#  include <fcntl.h>    // open
+#  include <unistd.h>   // close
+#  include <sys/mman.h> // mmap
+#  include <sys/stat.h> // fstat
+#endif
 
 #include <basis/tclap/Arg.h>
 #include <basis/tclap/ArgException.h>
@@ -26,6 +38,7 @@
 #include <basis/os.h>     // exename()
 #include <basis/except.h> // BASIS_THROW, runtime_error
 #include <basis/stdio.h>  // get_terminal_columns(), print_wrapped()
+#include <basis/subprocess.h> // Subprocess::split()
 
 #include <basis/CmdLine.h>
 
@@ -37,6 +50,50 @@ using namespace std;
 namespace basis {
 
 
+// ===========================================================================
+// helpers
+// ===========================================================================
+
+/// Names of standard arguments added by CmdLine::setup().
+static const char* const standard_args[] = {
+    "ignore_rest", "verbose", "help", "helpshort", "helpxml", "helpjson", "helpman", "version"
+};
+
+// ---------------------------------------------------------------------------
+/**
+ * @brief Determine whether an argument has a label or not.
+ *
+ * @param [in] arg Command-line argument.
+ *
+ * @returns Whether the given argument is a positional argument.
+ */
+static bool is_unlabeled_arg(TCLAP::Arg* arg)
+{
+    const string id = arg->longID();
+    string::size_type pos = id.find(TCLAP::Arg::nameStartString() + arg->getName());
+    return pos == string::npos;
+}
+
+// ---------------------------------------------------------------------------
+/**
+ * @brief Get string describing type of argument value.
+ *
+ * @param [in] arg Command-line argument.
+ *
+ * @returns String describing type of argument value.
+ */
+static string get_type_description(TCLAP::Arg* arg)
+{
+    string typedesc = arg->shortID();
+    string::size_type start = typedesc.find ('<');
+    string::size_type end   = typedesc.rfind('>');
+    if (start != string::npos && end != string::npos) {
+        return typedesc.substr(start + 1, end - start - 1);
+    } else {
+        return "";
+    }
+}
+
 // ===========================================================================
 // class: StdOutput
 // ===========================================================================
@@ -101,6 +158,18 @@ protected:
      */
     void updateTerminalInfo();
 
+    /**
+     * @brief Get rendered usage or help text.
+     *
+     * The text is rendered only once for the current number of columns and
+     * re-used by subsequent calls unless arguments were added meanwhile.
+     *
+     * @param [in] full Whether to render the full help or the usage only.
+     *
+     * @returns Text to be written to the standard output.
+     */
+    const string& getText(bool full);
+
     /**
      * @brief Determine whether an argument has a label or not.
      *
@@ -180,9 +249,12 @@ protected:
     // member variables
 protected:
 
-    CmdLine*    _cmd;     ///< The command-line with additional attributes.
-    set<string> _stdargs; ///< Names of standard arguments.
-    int         _columns; ///< Maximum number of columns to use for output.
+    CmdLine*    _cmd;            ///< The command-line with additional attributes.
+    set<string> _stdargs;        ///< Names of standard arguments.
+    int         _columns;        ///< Maximum number of columns to use for output.
+    string      _text[2];        ///< Rendered usage and help text.
+    int         _textColumns[2]; ///< Number of columns of rendered texts.
+    size_t      _textArgs[2];    ///< Number of arguments of rendered texts.
 
 }; // class StdOutput
 
@@ -196,13 +268,9 @@ StdOutput::StdOutput(CmdLine* cmd)
     _cmd(cmd),
     _columns(75)
 {
-    _stdargs.insert("ignore_rest");
-    _stdargs.insert("verbose");
-    _stdargs.insert("help");
-    _stdargs.insert("helpshort");
-    _stdargs.insert("helpxml");
-    _stdargs.insert("helpman");
-    _stdargs.insert("version");
+    _textColumns[0] = _textColumns[1] = 0;
+    _textArgs   [0] = _textArgs   [1] = 0;
+    _stdargs.insert(standard_args, standard_args + sizeof(standard_args) / sizeof(standard_args[0]));
 }
 
 // ---------------------------------------------------------------------------
@@ -213,23 +281,18 @@ StdOutput::StdOutput(CmdLine* cmd)
 void StdOutput::usage(TCLAP::CmdLineInterface&)
 {
     updateTerminalInfo();
-    cout << endl;
-    printUsage(cout, false);
-    //printArguments(cout, false);
-    cout << endl;
+    const string& text = getText(false);
+    cout.write(text.data(), text.size());
+    cout.flush();
 }
 
 // ---------------------------------------------------------------------------
 void StdOutput::help(TCLAP::CmdLineInterface&)
 {
     updateTerminalInfo();
-    cout << endl;
-    printUsage(cout);
-    printDescription(cout);
-    printArguments(cout, true);
-    printExample(cout);
-    printContact(cout);
-    cout << endl;
+    const string& text = getText(true);
+    cout.write(text.data(), text.size());
+    cout.flush();
 }
 
 // ---------------------------------------------------------------------------
@@ -275,25 +338,41 @@ inline void StdOutput::updateTerminalInfo()
     if (columns > 40) _columns = columns;
 }
 
+// ---------------------------------------------------------------------------
+const string& StdOutput::getText(bool full)
+{
+    const int    i     = full ? 1 : 0;
+    const size_t nargs = _cmd->getArgList().size();
+    if (_text[i].empty() || _textColumns[i] != _columns || _textArgs[i] != nargs) {
+        ostringstream os;
+        os << '\n';
+        if (full) {
+            printUsage(os);
+            printDescription(os);
+            printArguments(os, true);
+            printExample(os);
+            printContact(os);
+        } else {
+            printUsage(os, false);
+        }
+        os << '\n';
+        _text       [i] = os.str();
+        _textColumns[i] = _columns;
+        _textArgs   [i] = nargs;
+    }
+    return _text[i];
+}
+
 // ---------------------------------------------------------------------------
 inline bool StdOutput::isUnlabeledArg(TCLAP::Arg* arg) const
 {
-    const string id = arg->longID();
-    string::size_type pos = id.find(TCLAP::Arg::nameStartString() + arg->getName());
-    return pos == string::npos;
+    return is_unlabeled_arg(arg);
 }
 
 // ---------------------------------------------------------------------------
 inline string StdOutput::getTypeDescription(TCLAP::Arg* arg) const
 {
-    string typedesc = arg->shortID();
-    string::size_type start = typedesc.find ('<');
-    string::size_type end   = typedesc.rfind('>');
-    if (start != string::npos && end != string::npos) {
-        return typedesc.substr(start + 1, end - start - 1);
-    } else {
-        return "";
-    }
+    return get_type_description(arg);
 }
 
 // ---------------------------------------------------------------------------
@@ -334,7 +413,7 @@ void StdOutput::printArgumentHelp(ostream& os, TCLAP::Arg* arg, bool indentFirst
 void StdOutput::printUsage(ostream& os, bool heading) const
 {
     string                        exec_name  = os::exename();
-    list<TCLAP::Arg*>             args       = _cmd->getArgList();
+    list<TCLAP::Arg*>&            args       = _cmd->getArgList();
     TCLAP::XorHandler&            xorhandler = _cmd->getXorHandler();
     vector< vector<TCLAP::Arg*> > xors       = xorhandler.getXorList();
 
@@ -444,7 +523,7 @@ void StdOutput::printUsage(ostream& os, bool heading) const
     int offset = static_cast<int>(exec_name.length()) + 1;
     if (offset > _columns / 2) offset = 8;
     print_wrapped(os, s, _columns, 4, offset);
-    print_wrapped(os, exec_name + " [-h|--help|--helpshort|--helpxml|--helpman|--version]", _columns, 4, offset);
+    print_wrapped(os, exec_name + " [-h|--help|--helpshort|--helpxml|--helpjson|--helpman|--version]", _columns, 4, offset);
 }
 
 // ---------------------------------------------------------------------------
@@ -460,7 +539,7 @@ void StdOutput::printDescription(ostream& os) const
 // ---------------------------------------------------------------------------
 void StdOutput::printArguments(ostream& os, bool all) const
 {
-    list<TCLAP::Arg*>             args       = _cmd->getArgList();
+    list<TCLAP::Arg*>&            args       = _cmd->getArgList();
     TCLAP::XorHandler&            xorhandler = _cmd->getXorHandler();
     vector< vector<TCLAP::Arg*> > xors       = xorhandler.getXorList();
 
@@ -667,13 +746,13 @@ private:
 }; // class HelpVisitor
 
 // ===========================================================================
-// class: XmlVisitor
+// class: SchemaVisitor
 // ===========================================================================
 
 /**
- * @brief Outputs the command-line interface in XML format.
+ * @brief Outputs the command-line interface in XML or JSON format.
  */
-class XmlVisitor: public TCLAP::Visitor
+class SchemaVisitor: public TCLAP::Visitor
 {
     // -----------------------------------------------------------------------
     // construction / destruction
@@ -681,10 +760,15 @@ public:
 
     /**
      * @brief Constructor.
+     *
+     * @param [in] cmd    The command-line to describe.
+     * @param [in] format Output format.
      */
-    XmlVisitor()
+    SchemaVisitor(CmdLine* cmd, CmdLine::SchemaFormat format)
     :
-        Visitor()
+        Visitor(),
+        _cmd(cmd),
+        _format(format)
     { }
 
     // -----------------------------------------------------------------------
@@ -692,11 +776,12 @@ public:
 public:
 
     /**
-     * @brief Print help.
+     * @brief Print description of command-line interface.
      */
     void visit()
     {
-        cerr << "Not implemented yet! Use --help instead." << endl;
+        _cmd->serialize(cout, _format);
+        cout.flush();
         // exit
         throw TCLAP::ExitException(0); 
     }
@@ -705,15 +790,17 @@ public:
     // member variables
 protected:
 
+    CmdLine*              _cmd;    ///< The command-line to describe.
+    CmdLine::SchemaFormat _format; ///< Output format.
 
     // -----------------------------------------------------------------------
     // unsupported
 private:
 
-    XmlVisitor(const XmlVisitor&);            ///< Not implemented.
-    XmlVisitor& operator=(const XmlVisitor&); ///< Not implemented.
+    SchemaVisitor(const SchemaVisitor&);            ///< Not implemented.
+    SchemaVisitor& operator=(const SchemaVisitor&); ///< Not implemented.
 
-}; // class XmlVisitor
+}; // class SchemaVisitor
 
 // ===========================================================================
 // class: ManPageVisitor
@@ -764,6 +851,163 @@ private:
 
 }; // class ManPageVisitor
 
+// ===========================================================================
+// response files
+// ===========================================================================
+
+// ---------------------------------------------------------------------------
+/**
+ * @brief Read arguments from response file.
+ *
+ * Large files are memory-mapped and split into arguments directly without
+ * copying the file contents into a string first.
+ *
+ * @param [in]     path Path of response file.
+ * @param [in,out] args Argument vector to which arguments are appended.
+ *
+ * @returns Whether the file was read successfully.
+ */
+static bool read_response_file(const string& path, vector<string>& args)
+{
+#if UNIX
+    // files smaller than this are read into memory
+    const off_t mmap_threshold = 65536;
+    int fd = open(path.c_str(), O_RDONLY);
+    if (fd == -1) return false;
+    struct stat info;
+    if (fstat(fd, &info) == -1) {
+        close(fd);
+        return false;
+    }
+    if (info.st_size >= mmap_threshold) {
+        const size_t n = static_cast<size_t>(info.st_size);
+        void* data = mmap(NULL, n, PROT_READ, MAP_PRIVATE, fd, 0);
+        close(fd);
+        if (data == MAP_FAILED) return false;
+        madvise(data, n, MADV_SEQUENTIAL);
+        Subprocess::split(static_cast<const char*>(data), n, args);
+        munmap(data, n);
+        return true;
+    }
+    close(fd);
+#endif
+    ifstream ifs(path.c_str(), ios::in | ios::binary);
+    if (!ifs) return false;
+    ostringstream oss;
+    oss << ifs.rdbuf();
+    if (ifs.bad()) return false;
+    const string contents = oss.str();
+    Subprocess::split(contents.data(), contents.size(), args);
+    return true;
+}
+
+// ---------------------------------------------------------------------------
+/**
+ * @brief Replace \@file arguments by the arguments read from the named files.
+ *
+ * @param [in,out] args  Command-line arguments excluding the program name.
+ * @param [in]     depth Nesting level of response files.
+ *
+ * @throws TCLAP::CmdLineParseException if a response file cannot be read.
+ */
+static void expand_response_files(vector<string>& args, int depth = 0)
+{
+    const int max_depth = 16;
+    const string ignore_rest = TCLAP::Arg::nameStartString();
+
+    // nothing to do if there are no response files
+    vector<string>::size_type i;
+    for (i = 0; i < args.size(); ++i) {
+        if (args[i] == ignore_rest) return;
+        if (args[i].size() > 1 && args[i][0] == '@') break;
+    }
+    if (i == args.size()) return;
+    if (depth >= max_depth) {
+        throw TCLAP::CmdLineParseException("Response files nested too deeply", args[i]);
+    }
+
+    vector<string> expanded(args.begin(), args.begin() + i);
+    for (; i < args.size(); ++i) {
+        if (args[i] == ignore_rest) {
+            expanded.insert(expanded.end(), args.begin() + i, args.end());
+            break;
+        }
+        if (args[i].size() > 1 && args[i][0] == '@') {
+            vector<string> fileargs;
+            if (!read_response_file(args[i].substr(1), fileargs)) {
+                throw TCLAP::CmdLineParseException("Failed to read response file", args[i]);
+            }
+            expand_response_files(fileargs, depth + 1);
+            expanded.insert(expanded.end(), fileargs.begin(), fileargs.end());
+            // do not expand arguments following "--" in response file
+            if (find(fileargs.begin(), fileargs.end(), ignore_rest) != fileargs.end()) {
+                expanded.insert(expanded.end(), args.begin() + i + 1, args.end());
+                break;
+            }
+        } else {
+            expanded.push_back(args[i]);
+        }
+    }
+    args.swap(expanded);
+}
+
+// ===========================================================================
+// schema
+// ===========================================================================
+
+// ---------------------------------------------------------------------------
+/**
+ * @brief Escape special characters of XML attribute value or text.
+ */
+static string xml_escape(const string& str)
+{
+    string out;
+    out.reserve(str.size());
+    for (string::const_iterator c = str.begin(); c != str.end(); ++c) {
+        switch (*c) {
+            case '&':  out += "&amp;";  break;
+            case '<':  out += "&lt;";   break;
+            case '>':  out += "&gt;";   break;
+            case '"':  out += "&quot;"; break;
+            case '\'': out += "&apos;"; break;
+            default:   out += *c;       break;
+        }
+    }
+    return out;
+}
+
+// ---------------------------------------------------------------------------
+/**
+ * @brief Quote string as JSON string literal.
+ */
+static string json_quote(const string& str)
+{
+    static const char hex[] = "0123456789abcdef";
+    string out;
+    out.reserve(str.size() + 2);
+    out += '"';
+    for (string::const_iterator c = str.begin(); c != str.end(); ++c) {
+        switch (*c) {
+            case '"':  out += "\\\""; break;
+            case '\\': out += "\\\\"; break;
+            case '\n': out += "\\n";  break;
+            case '\r': out += "\\r";  break;
+            case '\t': out += "\\t";  break;
+            default:
+                if (static_cast<unsigned char>(*c) < 0x20) {
+                    out += "\\u00";
+                    out += hex[(*c >> 4) & 0xf];
+                    out += hex[*c & 0xf];
+                } else {
+                    out += *c;
+                }
+                break;
+        }
+    }
+    out += '"';
+    return out;
+}
+
 // ===========================================================================
 // class: CmdLine
 // ===========================================================================
@@ -785,7 +1029,8 @@ CmdLine::CmdLine(const std::string& name,
     _project(project),
     _copyright(copyright),
     _license(license),
-    _contact(contact)
+    _contact(contact),
+    _expandResponseFiles(true)
 {
     if (example != "") _examples.push_back(example);
     setup(stdargs);
@@ -809,7 +1054,8 @@ CmdLine::CmdLine(const std::string&              name,
     _examples(examples),
     _copyright(copyright),
     _license(license),
-    _contact(contact)
+    _contact(contact),
+    _expandResponseFiles(true)
 {
     setup(stdargs);
 }
@@ -854,13 +1100,20 @@ void CmdLine::setup(bool stdargs)
         deleteOnExit(helpshort);
         deleteOnExit(v);
 
-        v = new XmlVisitor();
+        v = new SchemaVisitor(this, SCHEMA_XML);
         TCLAP::SwitchArg* helpxml = new TCLAP::SwitchArg(
                 "", "helpxml", "Display help in XML format and exit.", false, v);
         add(helpxml);
         deleteOnExit(helpxml);
         deleteOnExit(v);
 
+        v = new SchemaVisitor(this, SCHEMA_JSON);
+        TCLAP::SwitchArg* helpjson = new TCLAP::SwitchArg(
+                "", "helpjson", "Display help in JSON format and exit.", false, v);
+        add(helpjson);
+        deleteOnExit(helpjson);
+        deleteOnExit(v);
+
         v = new ManPageVisitor();
         TCLAP::SwitchArg* helpman = new TCLAP::SwitchArg(
                 "", "helpman", "Display help as man page and exit.", false, v);
@@ -950,10 +1203,37 @@ void CmdLine::parse(vector<string>& args)
     try {
         _progName = os::exename();
         args.erase(args.begin());
+        if (_expandResponseFiles) expand_response_files(args);
+
+        // index labeled arguments by "-flag" and "--name" such that these
+        // are dispatched directly instead of trying each argument in turn
+        map<string, TCLAP::Arg*> index;
+        for (TCLAP::ArgListIterator it = _argList.begin(); it != _argList.end(); it++) {
+            const string& flag = (*it)->getFlag();
+            const string& name = (*it)->getName();
+            const string  key  = TCLAP::Arg::nameStartString() + name;
+            // unlabeled arguments are always at the end of the list
+            if ((*it)->longID().find(key) == string::npos) break;
+            index.insert(make_pair(key, *it));
+            if (!flag.empty()) index.insert(make_pair(TCLAP::Arg::flagStartString() + flag, *it));
+        }
 
         int requiredCount = 0;
         for (int i = 0; static_cast<unsigned int>(i) < args.size(); i++) {
             bool matched = false;
+            map<string, TCLAP::Arg*>::const_iterator match;
+            if (TCLAP::Arg::delimiter() == ' ') {
+                match = index.find(args[i]);
+            } else {
+                string::size_type pos = args[i].find(TCLAP::Arg::delimiter());
+                match = index.find(pos > 1 && pos != string::npos ? args[i].substr(0, pos) : args[i]);
+            }
+            if (match != index.end() && match->second->processArg(&i, args)) {
+                requiredCount += _xorHandler.check(match->second);
+                continue;
+            }
+            // unlabeled arguments, combined switches, and arguments which
+            // did not accept the token, e.g., because the rest is ignored
             for (TCLAP::ArgListIterator it = _argList.begin(); it != _argList.end(); it++) {
                 if ((*it)->processArg(&i, args)) {
                     requiredCount += _xorHandler.check(*it);
@@ -1000,5 +1280,87 @@ void CmdLine::parse(vector<string>& args)
     if (shouldExit) exit(estat);
 }
 
+// -----------------------------------------------------------------------
+void CmdLine::serialize(ostream& os, SchemaFormat format)
+{
+    const set<string> stdargs(standard_args, standard_args + sizeof(standard_args) / sizeof(standard_args[0]));
+    const vector< vector<TCLAP::Arg*> >& xors = _xorHandler.getXorList();
+    const bool json = (format == SCHEMA_JSON);
+
+    if (json) {
+        os << "{\n";
+        os << "  \"name\": "        << json_quote(_name)        << ",\n";
+        os << "  \"project\": "     << json_quote(_project)     << ",\n";
+        os << "  \"version\": "     << json_quote(_version)     << ",\n";
+        os << "  \"description\": " << json_quote(_message)     << ",\n";
+        os << "  \"arguments\": [";
+    } else {
+        os << "<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n";
+        os << "<cmdline>\n";
+        os << "  <name>"        << xml_escape(_name)    << "</name>\n";
+        os << "  <project>"     << xml_escape(_project) << "</project>\n";
+        os << "  <version>"     << xml_escape(_version) << "</version>\n";
+        os << "  <description>" << xml_escape(_message) << "</description>\n";
+        os << "  <arguments>\n";
+    }
+    for (TCLAP::ArgListIterator it = _argList.begin(); it != _argList.end(); ++it) {
+        TCLAP::Arg* arg = *it;
+        // properties of argument
+        string kind = "switch";
+        if      (is_unlabeled_arg(arg))  kind = "positional";
+        else if (arg->isValueRequired()) kind = "option";
+        string type = arg->isValueRequired() ? get_type_description(arg) : string();
+        string desc = arg->getDescription();
+        if (desc.compare (0, 12, "(required)  ")    == 0) desc.erase(0, 12);
+        if (desc.compare (0, 15, "(OR required)  ") == 0) desc.erase(0, 15);
+        int group = -1;
+        for (size_t i = 0; group == -1 && i < xors.size(); i++) {
+            if (find(xors[i].begin(), xors[i].end(), arg) != xors[i].end()) {
+                group = static_cast<int>(i);
+            }
+        }
+        const char* required = arg->isRequired()            ? "true" : "false";
+        const char* multiple = arg->acceptsMultipleValues() ? "true" : "false";
+        const char* standard = stdargs.find(arg->getName()) != stdargs.end() ? "true" : "false";
+        // write argument
+        if (json) {
+            if (it != _argList.begin()) os << ",";
+            os << "\n    {";
+            os << "\"name\": "         << json_quote(arg->getName());
+            os << ", \"flag\": "       << json_quote(arg->getFlag());
+            os << ", \"kind\": "       << json_quote(kind);
+            os << ", \"type\": "       << json_quote(type);
+            os << ", \"required\": "   << required;
+            os << ", \"multiple\": "   << multiple;
+            os << ", \"standard\": "   << standard;
+            os << ", \"group\": ";
+            if (group == -1) os << "null";
+            else             os << group;
+            os << ", \"description\": " << json_quote(desc);
+            os << "}";
+        } else {
+            os << "    <argument";
+            os << " name=\""     << xml_escape(arg->getName()) << "\"";
+            os << " flag=\""     << xml_escape(arg->getFlag()) << "\"";
+            os << " kind=\""     << kind                       << "\"";
+            os << " type=\""     << xml_escape(type)           << "\"";
+            os << " required=\"" << required                   << "\"";
+            os << " multiple=\"" << multiple                   << "\"";
+            os << " standard=\"" << standard                   << "\"";
+            if (group != -1) os << " group=\"" << group << "\"";
+            os << ">\n";
+            os << "      <description>" << xml_escape(desc) << "</description>\n";
+            os << "    </argument>\n";
+        }
+    }
+    if (json) {
+        os << "\n  ]\n";
+        os << "}\n";
+    } else {
+        os << "  </arguments>\n";
+        os << "</cmdline>\n";
+    }
+}
+
 
 } // namespace basis
@@ -0,0 +1,452 @@
+// ============================================================================
+// Copyright (c) 2011-2012 University of Pennsylvania
+// Copyright (c) 2013-2016 Andreas Schuh
+// All rights reserved.
+//
+// See COPYING file for license information or visit
+// https://cmake-basis.github.io/download.html#license
+// ============================================================================
+
+/**
+ * @file  benchmark.cxx
+ * @brief Implementation of C++ microbenchmark framework.
+ */
+
+
+#include <basis/config.h> // platform macros - must be first
+
+#include <algorithm>  // sort()
+#include <cmath>      // fabs()
+#include <cstdlib>    // atoi(), atof()
+#include <exception>
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <sstream>
+#include <vector>
+
+#if WINDOWS
+#  include <windows.h>          // QueryPerformanceCounter()
+#elif MACOS
+#  include <mach/mach_time.h>   // mach_absolute_time()
+#else
+#  include <time.h>             // clock_gettime()
+#endif
+
+#include <basis/benchmark.h>
+
+
+// acceptable in .cxx file
+using namespace std;
+
+
+namespace basis { namespace benchmark {
+
+
+// ===========================================================================
+// constants
+// ===========================================================================
+
+/// @brief Maximum number of iterations per repetition.
+static const long kMaxIterations = 1000000000L;
+
+/// @brief Prefix of command-line options of benchmarks.
+static const char kFlagPrefix[] = "--benchmark_";
+
+// ===========================================================================
+// types
+// ===========================================================================
+
+/// @brief Registered benchmark.
+struct Registration
+{
+    string           fixture; ///< Name of benchmark fixture.
+    string           name;    ///< Name of benchmark.
+    BenchmarkFactory factory; ///< Function creating benchmark instance.
+};
+
+/// @brief Options of benchmark run.
+struct Options
+{
+    Options()
+    :
+        filter("*"), repetitions(10), warmup(1), min_time(10.0), threshold(1.5), list(false)
+    {}
+
+    string filter;      ///< Colon-separated patterns of benchmarks to run.
+    int    repetitions; ///< Number of timed repetitions.
+    int    warmup;      ///< Number of warm-up repetitions.
+    double min_time;    ///< Minimum time of each repetition in milliseconds.
+    string output;      ///< JSON file to which results are written.
+    string baseline;    ///< JSON file with baseline results.
+    double threshold;   ///< Maximum ratio of median time to baseline median.
+    bool   list;        ///< Only list names of benchmarks.
+};
+
+// ===========================================================================
+// auxiliary functions
+// ===========================================================================
+
+// ---------------------------------------------------------------------------
+/// @brief Get registered benchmarks.
+static vector<Registration>& registry()
+{
+    static vector<Registration> benchmarks;
+    return benchmarks;
+}
+
+// ---------------------------------------------------------------------------
+/// @brief Get wall clock time in nanoseconds from a monotonic clock.
+static double now()
+{
+#if WINDOWS
+    static LARGE_INTEGER frequency = {{0, 0}};
+    if (frequency.QuadPart == 0) QueryPerformanceFrequency(&frequency);
+    LARGE_INTEGER count;
+    QueryPerformanceCounter(&count);
+    return 1e9 * static_cast<double>(count.QuadPart) / static_cast<double>(frequency.QuadPart);
+#elif MACOS
+    static mach_timebase_info_data_t timebase = {0, 0};
+    if (timebase.denom == 0) mach_timebase_info(&timebase);
+    return static_cast<double>(mach_absolute_time()) * timebase.numer / timebase.denom;
+#else
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return 1e9 * static_cast<double>(ts.tv_sec) + static_cast<double>(ts.tv_nsec);
+#endif
+}
+
+// ---------------------------------------------------------------------------
+/// @brief Time given number of iterations of benchmark in nanoseconds.
+static double time_iterations(Benchmark& benchmark, long iterations)
+{
+    const double start = now();
+    for (long i = 0; i < iterations; i++) benchmark.Run();
+    return now() - start;
+}
+
+// ---------------------------------------------------------------------------
+/// @brief Get median of values.
+static double median(vector<double> values)
+{
+    if (values.empty()) return 0.0;
+    sort(values.begin(), values.end());
+    const size_t n = values.size();
+    if (n % 2 == 1) return values[n / 2];
+    return 0.5 * (values[n / 2 - 1] + values[n / 2]);
+}
+
+// ---------------------------------------------------------------------------
+/// @brief Whether name matches glob pattern with wildcards '*' and '?'.
+static bool match(const char* pattern, const char* name)
+{
+    switch (*pattern) {
+        case '\0': return *name == '\0';
+        case '?':  return *name != '\0' && match(pattern + 1, name + 1);
+        case '*':  return match(pattern + 1, name) || (*name != '\0' && match(pattern, name + 1));
+        default:   return *pattern == *name && match(pattern + 1, name + 1);
+    }
+}
+
+// ---------------------------------------------------------------------------
+/// @brief Whether name matches one of the colon-separated glob patterns.
+static bool match_filter(const string& filter, const string& name)
+{
+    size_t begin = 0;
+    while (begin <= filter.size()) {
+        size_t end = filter.find(':', begin);
+        if (end == string::npos) end = filter.size();
+        if (match(filter.substr(begin, end - begin).c_str(), name.c_str())) return true;
+        begin = end + 1;
+    }
+    return false;
+}
+
+// ---------------------------------------------------------------------------
+/// @brief Format time given in nanoseconds using a suitable unit.
+static string format_time(double ns)
+{
+    ostringstream oss;
+    oss.precision(4);
+    if      (ns >= 1e9) oss << ns / 1e9 << " s";
+    else if (ns >= 1e6) oss << ns / 1e6 << " ms";
+    else if (ns >= 1e3) oss << ns / 1e3 << " us";
+    else                oss << ns       << " ns";
+    return oss.str();
+}
+
+// ---------------------------------------------------------------------------
+/// @brief Get numeric value of JSON object member written by write_results().
+static double json_number(const string& line, const char* name)
+{
+    const string key = string("\"") + name + "\": ";
+    const size_t pos = line.find(key);
+    return pos == string::npos ? 0.0 : atof(line.c_str() + pos + key.size());
+}
+
+// ---------------------------------------------------------------------------
+/// @brief Write benchmark results to JSON file.
+static bool write_results(const string& path, const vector<Statistics>& results)
+{
+    ofstream ofs(path.c_str());
+    ofs.precision(10);
+    ofs << "{\n  \"benchmarks\": [";
+    for (size_t i = 0; i < results.size(); i++) {
+        if (i > 0) ofs << ",";
+        ofs << "\n    {\"name\": \""    << results[i].name
+            << "\", \"median\": "      << results[i].median
+            << ", \"mad\": "           << results[i].mad
+            << ", \"min\": "           << results[i].min
+            << ", \"max\": "           << results[i].max
+            << ", \"repetitions\": "   << results[i].repetitions
+            << ", \"iterations\": "    << results[i].iterations << "}";
+    }
+    ofs << "\n  ]\n}\n";
+    return !ofs.fail();
+}
+
+// ---------------------------------------------------------------------------
+/// @brief Read median times from JSON file written by write_results().
+static bool read_results(const string& path, map<string, double>& medians)
+{
+    ifstream ifs(path.c_str());
+    if (!ifs) return false;
+    const string key = "{\"name\": \"";
+    string line;
+    while (getline(ifs, line)) {
+        const size_t pos = line.find(key);
+        if (pos == string::npos) continue;
+        const size_t begin = pos + key.size();
+        medians[line.substr(begin, line.find('"', begin) - begin)] = json_number(line, "median");
+    }
+    return true;
+}
+
+// ---------------------------------------------------------------------------
+/// @brief Print usage information.
+static void print_usage(const char* exec)
+{
+    cout << "Usage:\n  " << exec << " [options]\n\n"
+            "Options:\n"
+            "  --benchmark_list               List names of benchmarks and exit.\n"
+            "  --benchmark_filter=<patterns>  Colon-separated glob patterns of benchmarks to run. (default: *)\n"
+            "  --benchmark_repetitions=<n>    Number of timed repetitions. (default: 10)\n"
+            "  --benchmark_warmup=<n>         Number of warm-up repetitions. (default: 1)\n"
+            "  --benchmark_min_time=<ms>      Minimum time of each repetition in milliseconds. (default: 10)\n"
+            "  --benchmark_output=<file>      Write results to JSON file.\n"
+            "  --benchmark_baseline=<file>    Compare median times to results of previous run.\n"
+            "  --benchmark_threshold=<ratio>  Maximum ratio of median time to baseline median. (default: 1.5)\n"
+            "  --help, -h                     Print help and exit.\n";
+    cout.flush();
+}
+
+// ---------------------------------------------------------------------------
+/// @brief Parse command-line arguments.
+///
+/// @returns -1 if benchmarks should be run or exit code otherwise.
+static int parse_arguments(int argc, char* argv[], Options& options)
+{
+    const size_t len = sizeof(kFlagPrefix) - 1;
+    for (int i = 1; i < argc; i++) {
+        const string arg = argv[i];
+        if (arg == "--help" || arg == "-h") {
+            print_usage(argv[0]);
+            return 0;
+        }
+        const size_t eq    = arg.find('=');
+        const string name  = arg.substr(0, eq);
+        const string value = (eq == string::npos ? "" : arg.substr(eq + 1));
+        if (name.compare(0, len, kFlagPrefix) != 0) {
+            cerr << "Invalid argument: " << arg << endl;
+            print_usage(argv[0]);
+            return 1;
+        }
+        const string flag = name.substr(len);
+        if      (flag == "list")        options.list        = true;
+        else if (flag == "filter")      options.filter      = value;
+        else if (flag == "repetitions") options.repetitions = atoi(value.c_str());
+        else if (flag == "warmup")      options.warmup      = atoi(value.c_str());
+        else if (flag == "min_time")    options.min_time    = atof(value.c_str());
+        else if (flag == "output")      options.output      = value;
+        else if (flag == "baseline")    options.baseline    = value;
+        else if (flag == "threshold")   options.threshold   = atof(value.c_str());
+        else {
+            cerr << "Invalid argument: " << arg << endl;
+            print_usage(argv[0]);
+            return 1;
+        }
+    }
+    if (options.repetitions < 1) options.repetitions = 1;
+    if (options.warmup      < 0) options.warmup      = 0;
+    return -1;
+}
+
+// ---------------------------------------------------------------------------
+/// @brief Run benchmark and compute statistics of the time per iteration.
+///
+/// @returns Whether the benchmark completed. Otherwise, @p error is set.
+static bool run_benchmark(const Registration& registration, const Options& options,
+                          Statistics& stats, string& error)
+{
+    Benchmark*     benchmark = registration.factory();
+    long           n         = 1;
+    vector<double> times;
+    try {
+        benchmark->SetUp();
+        // choose number of iterations such that a repetition takes at least min_time
+        const double min_time = 1e6 * options.min_time;
+        double t = time_iterations(*benchmark, n);
+        while (t < min_time && n < kMaxIterations) {
+            double factor = (t > 0.0 ? 1.4 * min_time / t : 10.0);
+            if (factor > 10.0) factor = 10.0;
+            const long m = static_cast<long>(static_cast<double>(n) * factor);
+            n = (m > n ? m : n + 1);
+            if (n > kMaxIterations) n = kMaxIterations;
+            t = time_iterations(*benchmark, n);
+        }
+        // warm-up repetitions
+        for (int r = 0; r < options.warmup; r++) {
+            time_iterations(*benchmark, n);
+        }
+        // timed repetitions
+        times.resize(options.repetitions);
+        for (int r = 0; r < options.repetitions; r++) {
+            times[r] = time_iterations(*benchmark, n) / static_cast<double>(n);
+        }
+    } catch (const exception& e) {
+        error = e.what();
+    } catch (...) {
+        error = "Unknown exception";
+    }
+    // tear down also if SetUp() or Run() threw, reporting the first exception
+    try {
+        benchmark->TearDown();
+    } catch (const exception& e) {
+        if (error.empty()) error = e.what();
+    } catch (...) {
+        if (error.empty()) error = "Unknown exception";
+    }
+    delete benchmark;
+    if (!error.empty()) return false;
+    // statistics
+    stats.name        = registration.fixture + "." + registration.name;
+    stats.median      = median(times);
+    stats.min         = *min_element(times.begin(), times.end());
+    stats.max         = *max_element(times.begin(), times.end());
+    stats.repetitions = options.repetitions;
+    stats.iterations  = n;
+    vector<double> deviations(times.size());
+    for (size_t r = 0; r < times.size(); r++) {
+        deviations[r] = fabs(times[r] - stats.median);
+    }
+    stats.mad = median(deviations);
+    return true;
+}
+
+// ===========================================================================
+// public functions
+// ===========================================================================
+
+// ---------------------------------------------------------------------------
+bool register_benchmark(const char* fixture, const char* name, BenchmarkFactory factory)
+{
+    Registration registration;
+    registration.fixture = fixture;
+    registration.name    = name;
+    registration.factory = factory;
+    registry().push_back(registration);
+    return true;
+}
+
+// ---------------------------------------------------------------------------
+static const volatile void* volatile sink = NULL;
+
+void keep_pointer(const volatile void* value)
+{
+    sink = value;
+}
+
+// ---------------------------------------------------------------------------
+int run(int argc, char* argv[])
+{
+    Options options;
+    const int status = parse_arguments(argc, argv, options);
+    if (status != -1) return status;
+
+    const vector<Registration>& benchmarks = registry();
+    vector<const Registration*> selected;
+    for (size_t i = 0; i < benchmarks.size(); i++) {
+        if (match_filter(options.filter, benchmarks[i].fixture + "." + benchmarks[i].name)) {
+            selected.push_back(&benchmarks[i]);
+        }
+    }
+    if (options.list) {
+        for (size_t i = 0; i < selected.size(); i++) {
+            cout << selected[i]->fixture << "." << selected[i]->name << "\n";
+        }
+        cout.flush();
+        return 0;
+    }
+
+    map<string, double> baseline;
+    if (!options.baseline.empty() && !read_results(options.baseline, baseline)) {
+        cout << "Baseline file " << options.baseline << " not found, results are not compared." << endl;
+    }
+
+    cout << "[==========] Running " << selected.size() << " benchmarks." << endl;
+    vector<Statistics> results;
+    vector<string>     failed;
+    for (size_t i = 0; i < selected.size(); i++) {
+        const string name = selected[i]->fixture + "." + selected[i]->name;
+        cout << "[ RUN      ] " << name << endl;
+        Statistics stats;
+        string     error;
+        if (!run_benchmark(*selected[i], options, stats, error)) {
+            cout << "Exception thrown: " << error << "\n"
+                 << "[  FAILED  ] " << name << endl;
+            failed.push_back(name);
+            continue;
+        }
+        results.push_back(stats);
+        cout << "<DartMeasurement name=\"" << name << " Median\" type=\"numeric/double\">"
+             << stats.median << "</DartMeasurement>\n"
+             << "<DartMeasurement name=\"" << name << " MAD\" type=\"numeric/double\">"
+             << stats.mad << "</DartMeasurement>\n";
+        bool ok = true;
+        map<string, double>::const_iterator base = baseline.find(name);
+        if (base != baseline.end() && base->second > 0.0) {
+            const double ratio = stats.median / base->second;
+            cout << "<DartMeasurement name=\"" << name << " Baseline Ratio\" type=\"numeric/double\">"
+                 << ratio << "</DartMeasurement>\n";
+            if (ratio > options.threshold) {
+                cout << "[  SLOWER  ] " << name << " median " << format_time(stats.median)
+                     << " exceeds baseline " << format_time(base->second)
+                     << " by factor " << ratio << " (threshold: " << options.threshold << ")\n";
+                ok = false;
+            }
+        }
+        cout << (ok ? "[       OK ] " : "[  FAILED  ] ") << name
+             << " (median " << format_time(stats.median) << ", MAD " << format_time(stats.mad)
+             << ", " << stats.repetitions << " x " << stats.iterations << " iterations)" << endl;
+        if (!ok) failed.push_back(name);
+    }
+
+    if (!options.output.empty() && !write_results(options.output, results)) {
+        cerr << "Failed to write benchmark results to " << options.output << endl;
+        return 1;
+    }
+
+    cout << "[==========] " << selected.size() << " benchmarks ran.\n"
+         << "[  PASSED  ] " << (selected.size() - failed.size()) << " benchmarks.\n";
+    if (!failed.empty()) {
+        cout << "[  FAILED  ] " << failed.size() << " benchmarks, listed below:\n";
+        for (size_t i = 0; i < failed.size(); i++) {
+            cout << "[  FAILED  ] " << failed[i] << "\n";
+        }
+    }
+    cout.flush();
+    return failed.empty() ? 0 : 1;
+}
+
+
+} } // namespace basis::benchmark
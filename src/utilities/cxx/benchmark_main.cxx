@@ -0,0 +1,33 @@
+// ============================================================================
+// Copyright (c) 2011-2012 University of Pennsylvania
+// Copyright (c) 2013-2016 Andreas Schuh
+// All rights reserved.
+//
+// See COPYING file for license information or visit
+// https://cmake-basis.github.io/download.html#license
+// ============================================================================
+
+/**
+ * @file  benchmark_main.cxx
+ * @brief Default implementation of main() function of benchmarks.
+ *
+ * This file is compiled into the benchmark library as separate object file.
+ * Hence, benchmarks which define their own main() function, e.g., to
+ * initialize other libraries before calling basis::benchmark::run(),
+ * can still link to this library.
+ */
+
+
+#include <basis/benchmark.h>
+
+
+/**
+ * @brief Default implementation of main() function of benchmarks.
+ *
+ * @returns Exit status.
+ * @retval 0 On success.
+ */
+int main(int argc, char* argv[])
+{
+    return basis::benchmark::run(argc, argv);
+}
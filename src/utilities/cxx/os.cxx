@@ -21,10 +21,10 @@
 #include <string.h>            // strncmp()
 
 #if WINDOWS
-#  include <direct.h>          // _getcwd()
+#  include <direct.h>          // _getcwd(), _chdir()
 #  include <windows.h>         // GetModuleFileName()
 #else
-#  include <unistd.h>          // getcwd(), rmdir()
+#  include <unistd.h>          // getcwd(), chdir(), rmdir()
 #  include <dirent.h>          // opendir()
 #  include <sys/stat.h>        // mkdir()
 #endif
@@ -59,6 +59,16 @@ string getcwd()
     return wd;
 }
 
+// ---------------------------------------------------------------------------
+bool chdir(const string& path)
+{
+#if WINDOWS
+    return ::_chdir(path.c_str()) == 0;
+#else
+    return ::chdir(path.c_str()) == 0;
+#endif
+}
+
 // ---------------------------------------------------------------------------
 string exepath()
 {
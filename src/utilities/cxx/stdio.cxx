@@ -98,6 +98,18 @@ int get_terminal_columns()
     return columns;
 }
 
+// ---------------------------------------------------------------------------
+/**
+ * @brief Write a number of space characters to the output stream.
+ */
+static inline void write_spaces(ostream& os, int n)
+{
+    static const char spaces[] = "                                ";
+    const int chunk = static_cast<int>(sizeof(spaces)) - 1;
+    for (; n > chunk; n -= chunk) os.write(spaces, chunk);
+    if (n > 0) os.write(spaces, n);
+}
+
 // ---------------------------------------------------------------------------
 ostream& print_wrapped(ostream&      os,
                        const string& text,
@@ -133,9 +145,10 @@ ostream& print_wrapped(ostream&      os,
         for (int i = 0; i < line_length; i++) {
             if (text[start + i] == '\n') line_length = i + 1;
         }
-        // print the line and add a newline
-        for (int i = 0; i < indent; i++ ) os << " ";
-        os << text.substr(start, line_length) << endl;
+        // print the line and add a newline, the stream is not flushed
+        write_spaces(os, indent);
+        os.write(text.data() + start, line_length);
+        os.put('\n');
         // adjust indent for lines after the first one
         if (start == 0) {
             indent         += offset;
@@ -19,14 +19,15 @@
 
 #include <cstdlib>
 #include <cassert>         // assert
-#include <cstring>         // strlen
-#include <algorithm>       // for_each
+#include <cstring>         // memchr
 
 #if UNIX
 #    include <sys/wait.h>  // waitpid
 #    include <signal.h>    // kill
 #    include <sys/errno.h> // errno, ECHILD
 #    include <stdio.h>     // strerror_r
+#    include <fcntl.h>     // fcntl, FD_CLOEXEC, splice, tee
+#    include <poll.h>      // poll
 #endif
 
 #include <basis/except.h>
@@ -44,124 +45,148 @@ namespace basis {
 // ===========================================================================
 
 // ---------------------------------------------------------------------------
-// Attention: Order matters! First, escaped backslashes are converted to
-//            the unused ASCII character 255 and finally these characters are
-//            replaced by single backslashes.
-static const char* olds[] = {"\\\\", "\\\"", "\xFF"};
-static const char* news[] = {"\xFF", "\"",   "\\"};
+/// Whether character is a whitespace which separates arguments.
+static inline bool iswhitespace(char c)
+{
+    return c == ' ' || c == '\t' || c == '\n' || c == '\r' || c == '\f' || c == '\v';
+}
 
+// ---------------------------------------------------------------------------
 /**
- * @brief Function object used to convert special characters in command-line
- *        given as single string.
+ * @brief Append argument to string with escaped special characters converted.
+ *
+ * An escaped backslash (\\) is replaced by a single backslash and an escaped
+ * double quote (\") by a double quote. Any other character including a
+ * single backslash is copied as is.
  */
-struct ConvertSpecialChars
+static void unescape(const char* begin, const char* end, string& arg)
 {
-    void operator ()(string& str)
-    {
-        string::size_type i;
-        for (unsigned int n = 0; n < 3; n++) {
-            while ((i = str.find(olds[n])) != string::npos) {
-                str.replace(i, strlen(olds[n]), news[n]);
-            }
+    arg.reserve(arg.size() + (end - begin));
+    while (begin != end) {
+        if (*begin == '\\' && begin + 1 != end && (begin[1] == '\\' || begin[1] == '\"')) {
+            ++begin;
         }
+        arg.push_back(*begin++);
     }
-}; // struct ConvertSpecialChars
+}
 
 // ---------------------------------------------------------------------------
 Subprocess::CommandLine Subprocess::split(const string& cmd)
 {
-    const char whitespace[] = " \f\n\r\t\v";
-
     CommandLine args;
-    string::size_type j;
-    string::size_type k;
-    unsigned int      n;
-
-    for (string::size_type i = 0; i < cmd.size(); i++) {
-        if (cmd[i] == '\"') {
-            j = i;
-            do {
-                j = cmd.find('\"', ++j);
-                if (j == string::npos) break;
-                // count number of backslashes to determine whether this
-                // double quote is escaped or not
-                k = j;
-                n = 0;
-                // Note: There is at least the leading double quote (").
-                //       Hence, k will always be > 0 here.
-                while (cmd[--k] == '\\') n++;
-                // continue while found double quote is escaped
-            } while (n % 2);
+    split(cmd.data(), cmd.size(), args);
+    return args;
+}
+
+// ---------------------------------------------------------------------------
+void Subprocess::split(const char* cmd, size_t n, CommandLine& args)
+{
+    const char* const s = cmd;
+    size_t            i = 0;
+    size_t            j;
+    size_t            nbs; // number of consecutive backslashes
+
+    while (i < n) {
+        if (iswhitespace(s[i])) {
+            ++i;
+            continue;
+        }
+        args.push_back(string());
+        string& arg = args.back();
+        if (s[i] == '\"') {
+            // find double quote which is not escaped by an odd number of
+            // backslashes and terminates the argument
+            for (j = i + 1, nbs = 0; j < n; ++j) {
+                if (s[j] == '\\') {
+                    ++nbs;
+                } else if (s[j] == '\"' && nbs % 2 == 0) {
+                    break;
+                } else {
+                    nbs = 0;
+                }
+            }
             // if trailing double quote is missing, consider leading
             // double quote to be part of argument which extends to the
             // end of the entire string
-            if (j == string::npos) {
-                args.push_back(cmd.substr(i));
+            if (j == n) {
+                unescape(s + i, s + n, arg);
                 break;
-            } else {
-                args.push_back(cmd.substr(i + 1, j - i - 1));
-                i = j;
             }
-        } else if (isspace(cmd[i])) {
-            j = cmd.find_first_not_of(whitespace, i);
-            i = j - 1;
+            unescape(s + i + 1, s + j, arg);
+            i = j + 1;
         } else {
-            j = i;
-            do {
-                j = cmd.find_first_of(whitespace, ++j);
-                if (j == string::npos) break;
-                // count number of backslashes to determine whether this
-                // whitespace character is escaped or not
-                k = j;
-                n = 0;
-                if (cmd[j] == ' ') {
-                    // Note: The previous else block handles whitespaces
-                    //       in between arguments including leading whitespaces.
-                    //       Hence, k will always be > 0 here.
-                    while (cmd[--k] == '\\') n++;
+            // find whitespace which terminates the argument, where a space
+            // preceded by an odd number of backslashes is part of the argument
+            for (j = i, nbs = 0; j < n; ++j) {
+                if (s[j] == '\\') {
+                    ++nbs;
+                } else if (iswhitespace(s[j]) && (s[j] != ' ' || nbs % 2 == 0)) {
+                    break;
+                } else {
+                    nbs = 0;
                 }
-                // continue while found whitespace is escaped
-            } while (n % 2);
-            if (j == string::npos) {
-                args.push_back(cmd.substr(i));
-                break;
-            } else {
-                args.push_back(cmd.substr(i, j - i));
-                i = j - 1;
             }
+            unescape(s + i, s + j, arg);
+            i = j;
         }
     }
+}
 
-    for_each(args.begin(), args.end(), ConvertSpecialChars());
-
-    return args;
+// ---------------------------------------------------------------------------
+/**
+ * @brief Determine how argument has to be written to command-line string.
+ *
+ * @param [in]  arg     Argument.
+ * @param [out] nescape Number of backslashes and double quotes in argument.
+ *
+ * @returns Whether the argument has to be double quoted such that split()
+ *          returns it unmodified.
+ */
+static bool needsquotes(const string& arg, size_t& nescape)
+{
+    bool quote = arg.empty() || arg[0] == '\"' || arg[arg.size() - 1] == '\\';
+    nescape = 0;
+    for (string::const_iterator c = arg.begin(); c != arg.end(); ++c) {
+        if (*c == '\\' || *c == '\"') {
+            ++nescape;
+            if (*c == '\\' && c + 1 != arg.end() && (c[1] == '\\' || c[1] == '\"')) quote = true;
+        } else if (iswhitespace(*c)) {
+            quote = true;
+        }
+    }
+    return quote;
 }
 
 // ---------------------------------------------------------------------------
 string Subprocess::tostring(const CommandLine& args)
 {
-    const char whitespace[] = " \f\n\r\t\v";
+    CommandLine::const_iterator i;
+    size_t                      nescape;
+
+    // determine length of command-line string
+    size_t len = 0;
+    for (i = args.begin(); i != args.end(); ++i) {
+        len += i->size() + 1;
+        if (needsquotes(*i, nescape)) len += nescape + 2;
+    }
 
     string cmd;
-    string arg;
-    string::size_type j;
-
-    for (CommandLine::const_iterator i = args.begin(); i != args.end(); ++i) {
-        if (!cmd.empty()) cmd.push_back(' ');
-        if (i->find_first_of(whitespace) != string::npos) {
-            arg = *i;
+    cmd.reserve(len);
+    for (i = args.begin(); i != args.end(); ++i) {
+        if (i != args.begin()) cmd.push_back(' ');
+        if (needsquotes(*i, nescape)) {
+            // surround argument by double quotes and
             // escape backslashes (\) and double quotes (")
-            j = arg.find_first_of("\\\"");
-            while (j != string::npos) {
-                arg.insert(j, 1, '\\');
-                j = arg.find_first_of("\\\"", j + 2);
-            }
-            // surround argument by double quotes if necessary
-            if (cmd.empty() || arg.find_first_of("' \t") != string::npos) {
-                cmd.push_back('\"');
-                cmd.append(arg);
-                cmd.push_back('\"');
+            cmd.push_back('\"');
+            if (nescape == 0) {
+                cmd.append(*i);
+            } else {
+                for (string::const_iterator c = i->begin(); c != i->end(); ++c) {
+                    if (*c == '\\' || *c == '\"') cmd.push_back('\\');
+                    cmd.push_back(*c);
+                }
             }
+            cmd.push_back('\"');
         } else {
             cmd.append(*i);
         }
@@ -169,6 +194,188 @@ string Subprocess::tostring(const CommandLine& args)
     return cmd;
 }
 
+#if WINDOWS
+// ---------------------------------------------------------------------------
+/**
+ * @brief Convert argument vector to command-line string for CreateProcess().
+ *
+ * Unlike tostring(), the quoting follows the command-line parsing of the
+ * Microsoft C runtime and CommandLineToArgvW(), where backslashes are only
+ * special when they precede a double quote. A quoted argument such as
+ * "\\server\share dir" therefore reaches the child process unmodified.
+ */
+static string tocmdline(const Subprocess::CommandLine& args)
+{
+    string cmd;
+    for (Subprocess::CommandLine::const_iterator i = args.begin(); i != args.end(); ++i) {
+        if (i != args.begin()) cmd.push_back(' ');
+        if (!i->empty() && i->find_first_of(" \t\n\v\"") == string::npos) {
+            cmd.append(*i);
+            continue;
+        }
+        // surround argument by double quotes, escape double quotes (")
+        // and double backslashes (\) which precede a double quote
+        cmd.push_back('\"');
+        size_t nbs = 0; // number of consecutive backslashes
+        for (string::const_iterator c = i->begin(); c != i->end(); ++c) {
+            if (*c == '\\') {
+                ++nbs;
+            } else {
+                if (*c == '\"') cmd.append(nbs + 1, '\\');
+                nbs = 0;
+            }
+            cmd.push_back(*c);
+        }
+        cmd.append(nbs, '\\');
+        cmd.push_back('\"');
+    }
+    return cmd;
+}
+#endif
+
+#if UNIX
+// ---------------------------------------------------------------------------
+/**
+ * @brief Create pipe whose file descriptors are closed upon exec().
+ *
+ * The child process duplicates the end of the pipe it uses to one of
+ * the standard file descriptors, which are not closed upon exec(). This
+ * ensures that no other subprocess, e.g., a later stage of a pipeline,
+ * inherits the pipe and thus prevents the end-of-file from being detected.
+ */
+static int pipe_cloexec(int fds[2])
+{
+    if (pipe(fds) == -1) return -1;
+    fcntl(fds[0], F_SETFD, FD_CLOEXEC);
+    fcntl(fds[1], F_SETFD, FD_CLOEXEC);
+    return 0;
+}
+
+// ---------------------------------------------------------------------------
+/// Redirect standard file descriptor of child process to given file.
+static void redirect_fd(int fd, int target)
+{
+    if (fd == target) {
+        fcntl(fd, F_SETFD, 0);
+    } else {
+        dup2(fd, target);
+    }
+}
+#endif
+
+// ---------------------------------------------------------------------------
+/**
+ * @brief Create pipe or open file for redirection of standard input/output.
+ *
+ * @param [in]  rm     Redirection mode.
+ * @param [in]  path   File used for redirection mode RM_FILE.
+ * @param [in]  append Whether to append output to file.
+ * @param [out] fds    Read and write end of pipe. In case of a file, only the
+ *                     end used by the subprocess is set to the opened file.
+ * @param [in]  input  Whether the subprocess reads from this file.
+ *
+ * @returns Whether the redirection was set up successfully.
+ */
+static bool open_stdio(Subprocess::RedirectMode rm, const string& path, bool append,
+                       Subprocess::PipeHandle fds[2], bool input)
+{
+#if WINDOWS
+    SECURITY_ATTRIBUTES saAttr;
+    saAttr.nLength              = sizeof(SECURITY_ATTRIBUTES);
+    saAttr.bInheritHandle       = TRUE;
+    saAttr.lpSecurityDescriptor = NULL;
+    if (rm == Subprocess::RM_PIPE) {
+        if (CreatePipe(&fds[0], &fds[1], &saAttr, 0) == 0) {
+            cerr << "Subprocess::popen(): Failed to create pipe!" << endl;
+            return false;
+        }
+    } else if (rm == Subprocess::RM_FILE || rm == Subprocess::RM_DEVNULL) {
+        const char* fname = (rm == Subprocess::RM_FILE ? path.c_str() : "NUL");
+        HANDLE h;
+        if (input) {
+            h = CreateFileA(fname, GENERIC_READ, FILE_SHARE_READ, &saAttr,
+                            OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+        } else {
+            h = CreateFileA(fname, (append ? FILE_APPEND_DATA : GENERIC_WRITE),
+                            FILE_SHARE_READ | FILE_SHARE_WRITE, &saAttr,
+                            (append ? OPEN_ALWAYS : CREATE_ALWAYS),
+                            FILE_ATTRIBUTE_NORMAL, NULL);
+        }
+        if (h == INVALID_HANDLE_VALUE) {
+            cerr << "Subprocess::popen(): Failed to open file " << fname << "!" << endl;
+            return false;
+        }
+        fds[input ? 0 : 1] = h;
+    }
+#else
+    if (rm == Subprocess::RM_PIPE) {
+        if (pipe_cloexec(fds) == -1) {
+            cerr << "Subprocess::popen(): Failed to create pipe!" << endl;
+            return false;
+        }
+    } else if (rm == Subprocess::RM_FILE || rm == Subprocess::RM_DEVNULL) {
+        const char* fname = (rm == Subprocess::RM_FILE ? path.c_str() : "/dev/null");
+        int flags = O_RDONLY;
+        if (!input) flags = O_WRONLY | O_CREAT | (append ? O_APPEND : O_TRUNC);
+        int fd = open(fname, flags, 0666);
+        if (fd == -1) {
+            cerr << "Subprocess::popen(): Failed to open file " << fname << "!" << endl;
+            return false;
+        }
+        fcntl(fd, F_SETFD, FD_CLOEXEC);
+        fds[input ? 0 : 1] = fd;
+    }
+#endif
+    return true;
+}
+
+// ---------------------------------------------------------------------------
+/// Write all bytes of a buffer to the given file.
+static bool write_all(Subprocess::PipeHandle to, const char* buf, size_t nbuf)
+{
+    while (nbuf > 0) {
+#if WINDOWS
+        DWORD n = 0;
+        if (!WriteFile(to, buf, static_cast<DWORD>(nbuf), &n, NULL)) return false;
+#else
+        ssize_t n = ::write(to, buf, nbuf);
+        if (n == -1) {
+            if (errno == EINTR) continue;
+            return false;
+        }
+#endif
+        buf  += n;
+        nbuf -= static_cast<size_t>(n);
+    }
+    return true;
+}
+
+// ---------------------------------------------------------------------------
+/// Copy data from one file to one or two others until the end of the input.
+static bool copy_all(Subprocess::PipeHandle from, Subprocess::PipeHandle to,
+                     Subprocess::PipeHandle copy, bool has_copy)
+{
+    const size_t nbuf = 65536;
+    char buf[nbuf];
+    for (;;) {
+#if WINDOWS
+        DWORD n = 0;
+        if (!ReadFile(from, buf, nbuf, &n, NULL)) {
+            return GetLastError() == ERROR_BROKEN_PIPE;
+        }
+#else
+        ssize_t n = ::read(from, buf, nbuf);
+        if (n == -1) {
+            if (errno == EINTR) continue;
+            return false;
+        }
+#endif
+        if (n == 0) return true;
+        if (!write_all(to, buf, static_cast<size_t>(n))) return false;
+        if (has_copy && !write_all(copy, buf, static_cast<size_t>(n))) return false;
+    }
+}
+
 // ===========================================================================
 // construction / destruction
 // ===========================================================================
@@ -188,6 +395,7 @@ Subprocess::Subprocess ()
     _stderr = -1;
 #endif
     _status = -1;
+    _append[0] = _append[1] = _append[2] = false;
 }
 
 // ---------------------------------------------------------------------------
@@ -210,6 +418,31 @@ Subprocess::~Subprocess ()
 #endif
 }
 
+// ===========================================================================
+// redirection
+// ===========================================================================
+
+// ---------------------------------------------------------------------------
+void Subprocess::stdin_file(const string& path)
+{
+    _file  [0] = path;
+    _append[0] = false;
+}
+
+// ---------------------------------------------------------------------------
+void Subprocess::stdout_file(const string& path, bool append)
+{
+    _file  [1] = path;
+    _append[1] = append;
+}
+
+// ---------------------------------------------------------------------------
+void Subprocess::stderr_file(const string& path, bool append)
+{
+    _file  [2] = path;
+    _append[2] = append;
+}
+
 // ===========================================================================
 // process control
 // ===========================================================================
@@ -220,6 +453,22 @@ bool Subprocess::popen(const CommandLine& args,
                        const RedirectMode rm_out,
                        const RedirectMode rm_err,
                        const Environment* env)
+{
+#if WINDOWS
+    return spawn(args, rm_in, rm_out, rm_err, env, INVALID_HANDLE_VALUE, INVALID_HANDLE_VALUE);
+#else
+    return spawn(args, rm_in, rm_out, rm_err, env, -1, -1);
+#endif
+}
+
+// ---------------------------------------------------------------------------
+bool Subprocess::spawn(const CommandLine& args,
+                       const RedirectMode rm_in,
+                       const RedirectMode rm_out,
+                       const RedirectMode rm_err,
+                       const Environment* env,
+                       PipeHandle         hin,
+                       PipeHandle         hout)
 {
     if (!poll()) {
         cerr << "Subprocess::popen(): Previously opened process not terminated yet!" << endl;
@@ -235,31 +484,22 @@ bool Subprocess::popen(const CommandLine& args,
     _stderr = INVALID_HANDLE_VALUE;
     _status = -1;
 
-    SECURITY_ATTRIBUTES saAttr; 
     HANDLE hStdIn[2]  = {INVALID_HANDLE_VALUE, INVALID_HANDLE_VALUE}; // read, write
     HANDLE hStdOut[2] = {INVALID_HANDLE_VALUE, INVALID_HANDLE_VALUE};
     HANDLE hStdErr[2] = {INVALID_HANDLE_VALUE, INVALID_HANDLE_VALUE};
- 
-    // set the bInheritHandle flag so pipe handles are inherited
-    saAttr.nLength              = sizeof(SECURITY_ATTRIBUTES); 
-    saAttr.bInheritHandle       = TRUE; 
-    saAttr.lpSecurityDescriptor = NULL;
 
-    // create pipes for standard input/output
-    if (rm_in == RM_PIPE && CreatePipe(&hStdIn[0], &hStdIn[1], &saAttr, 0) == 0) {
-        cerr << "Subprocess::popen(): Failed to create pipe!" << endl;
+    // create pipes or open files for standard input/output
+    if (hin == INVALID_HANDLE_VALUE && !open_stdio(rm_in, _file[0], _append[0], hStdIn, true)) {
         return false;
     }
 
-    if (rm_out == RM_PIPE && CreatePipe(&hStdOut[0], &hStdOut[1], &saAttr, 0) == 0) {
-        cerr << "Subprocess::popen(): Failed to create pipe!" << endl;
+    if (hout == INVALID_HANDLE_VALUE && !open_stdio(rm_out, _file[1], _append[1], hStdOut, false)) {
         CloseHandle(hStdIn[0]);
         CloseHandle(hStdIn[1]);
         return false;
     }
 
-    if (rm_err == RM_PIPE && CreatePipe(&hStdErr[0], &hStdErr[1], &saAttr, 0) == 0) {
-        cerr << "Subprocess::popen(): Failed to create pipe!" << endl;
+    if (!open_stdio(rm_err, _file[2], _append[2], hStdErr, false)) {
         CloseHandle(hStdIn[0]);
         CloseHandle(hStdIn[1]);
         CloseHandle(hStdOut[0]);
@@ -281,16 +521,29 @@ bool Subprocess::popen(const CommandLine& args,
         return false;
     }
 
+    // ensure that handles of pipeline are inherited by this subprocess
+    if ((hin  != INVALID_HANDLE_VALUE && !SetHandleInformation(hin,  HANDLE_FLAG_INHERIT, HANDLE_FLAG_INHERIT)) ||
+            (hout != INVALID_HANDLE_VALUE && !SetHandleInformation(hout, HANDLE_FLAG_INHERIT, HANDLE_FLAG_INHERIT))) {
+        cerr << "Subprocess::popen(): Failed to connect pipeline!" << endl;
+        CloseHandle(hStdIn[0]);
+        CloseHandle(hStdIn[1]);
+        CloseHandle(hStdOut[0]);
+        CloseHandle(hStdOut[1]);
+        CloseHandle(hStdErr[0]);
+        CloseHandle(hStdErr[1]);
+        return false;
+    }
+
     // create subprocess
     STARTUPINFO siStartInfo;
     ZeroMemory(&siStartInfo, sizeof(STARTUPINFO));
     siStartInfo.cb          = sizeof(STARTUPINFO); 
     siStartInfo.hStdError   = hStdErr[1];
-    siStartInfo.hStdOutput  = hStdOut[1];
-    siStartInfo.hStdInput   = hStdIn[0];
+    siStartInfo.hStdOutput  = (hout != INVALID_HANDLE_VALUE ? hout : hStdOut[1]);
+    siStartInfo.hStdInput   = (hin  != INVALID_HANDLE_VALUE ? hin  : hStdIn[0]);
     siStartInfo.dwFlags    |= STARTF_USESTDHANDLES;
 
-    string cmd = tostring(args);
+    string cmd = tocmdline(args);
 
     LPTSTR szCmdline = NULL;
 #ifdef UNICODE
@@ -356,25 +609,22 @@ bool Subprocess::popen(const CommandLine& args,
     _stderr = -1;
     _status = -1;
 
-    // create pipes for standard input/output
+    // create pipes or open files for standard input/output
     int fdsin [2] = {-1, -1}; // read, write
     int fdsout[2] = {-1, -1};
     int fdserr[2] = {-1, -1};
 
-    if (rm_in == RM_PIPE && pipe(fdsin) == -1) {
-        cerr << "Subprocess::popen(): Failed to create pipe!" << endl;
+    if (hin == -1 && !open_stdio(rm_in, _file[0], _append[0], fdsin, true)) {
         return false;
     }
 
-    if (rm_out == RM_PIPE && pipe(fdsout) == -1) {
-        cerr << "Subprocess::popen(): Failed to create pipe!" << endl;
+    if (hout == -1 && !open_stdio(rm_out, _file[1], _append[1], fdsout, false)) {
         if (fdsin[0] != -1) close(fdsin[0]);
         if (fdsin[1] != -1) close(fdsin[1]);
         return false;
     }
 
-    if (rm_err == RM_PIPE && pipe(fdserr) == -1) {
-        cerr << "Subprocess::popen(): Failed to create pipe!" << endl;
+    if (!open_stdio(rm_err, _file[2], _append[2], fdserr, false)) {
         if (fdsin[0]  != -1) close(fdsin[0]);
         if (fdsin[1]  != -1) close(fdsin[1]);
         if (fdsout[0] != -1) close(fdsout[0]);
@@ -407,20 +657,24 @@ bool Subprocess::popen(const CommandLine& args,
         // See http://www.unixwiz.net/techtips/remap-pipe-fds.html for details
         // on why it could happen that the created pipes use file descriptors
         // which are already either one of the three standard file descriptors.
+        //
+        // Note: All pipe ends are closed upon exec() except of those which
+        //       were duplicated to the standard file descriptors.
 
-        if (fdsin[0] != -1) {
-            dup2(fdsin[0], 0);
-            close(fdsin[0]);
+        if (hin != -1) {
+            redirect_fd(hin, 0);
+        } else if (fdsin[0] != -1) {
+            redirect_fd(fdsin[0], 0);
         }
-        if (fdsout[1] != -1) {
-            dup2(fdsout[1], 1);
-            close(fdsout[1]);
+        if (hout != -1) {
+            redirect_fd(hout, 1);
+        } else if (fdsout[1] != -1) {
+            redirect_fd(fdsout[1], 1);
         }
         if (rm_err == RM_STDOUT) {
             dup2(1, 2);
         } else if (fdserr[1] != -1) {
-            dup2(fdserr[1], 2);
-            close(fdserr[1]);
+            redirect_fd(fdserr[1], 2);
         }
 
         // redirect standard input/output
@@ -763,6 +1017,74 @@ int Subprocess::read(void* buf, size_t nbuf, bool err)
 #endif
 }
 
+// ---------------------------------------------------------------------------
+bool Subprocess::splice(PipeHandle to, bool err)
+{
+#if WINDOWS
+    HANDLE from = _stdout;
+    if (err && _stderr != INVALID_HANDLE_VALUE) from = _stderr;
+    if (from == INVALID_HANDLE_VALUE) return false;
+#else
+    int from = _stdout;
+    if (err && _stderr != -1) from = _stderr;
+    if (from == -1) return false;
+#  if LINUX
+    for (;;) {
+        ssize_t n = ::splice(from, NULL, to, NULL, 65536, SPLICE_F_MOVE | SPLICE_F_MORE);
+        if (n == 0) return true;
+        if (n == -1) {
+            if (errno == EINTR) continue;
+            // splicing not supported for this file, e.g., opened with O_APPEND
+            if (errno == EINVAL || errno == ENOSYS) break;
+            return false;
+        }
+    }
+#  endif
+#endif
+    return copy_all(from, to, to, false);
+}
+
+// ---------------------------------------------------------------------------
+bool Subprocess::tee(PipeHandle to, PipeHandle copy, bool err)
+{
+#if WINDOWS
+    HANDLE from = _stdout;
+    if (err && _stderr != INVALID_HANDLE_VALUE) from = _stderr;
+    if (from == INVALID_HANDLE_VALUE) return false;
+#else
+    int from = _stdout;
+    if (err && _stderr != -1) from = _stderr;
+    if (from == -1) return false;
+#  if LINUX
+    for (;;) {
+        // duplicate data available in pipe without consuming it
+        ssize_t n = ::tee(from, to, 65536, 0);
+        if (n == 0) return true;
+        if (n == -1) {
+            if (errno == EINTR) continue;
+            // output is not a pipe
+            if (errno == EINVAL || errno == ENOSYS) break;
+            return false;
+        }
+        // consume the duplicated data by moving it to the copy
+        while (n > 0) {
+            ssize_t m = ::splice(from, NULL, copy, NULL, static_cast<size_t>(n), SPLICE_F_MOVE | SPLICE_F_MORE);
+            if (m == -1) {
+                if (errno == EINTR) continue;
+                if (errno != EINVAL && errno != ENOSYS) return false;
+                // copy does not support splicing, read data instead
+                char buf[65536];
+                m = ::read(from, buf, static_cast<size_t>(n));
+                if (m <= 0 || !write_all(copy, buf, static_cast<size_t>(m))) return false;
+            }
+            n -= m;
+        }
+    }
+#  endif
+#endif
+    return copy_all(from, to, copy, true);
+}
+
 // ===========================================================================
 // static methods
 // ===========================================================================
@@ -783,5 +1105,397 @@ int Subprocess::call(const string& cmd)
     return -1;
 }
 
+// ===========================================================================
+// private helpers
+// ===========================================================================
+
+// ---------------------------------------------------------------------------
+void Subprocess::close_stdin()
+{
+#if WINDOWS
+    if (_stdin != INVALID_HANDLE_VALUE) CloseHandle(_stdin);
+    _stdin = INVALID_HANDLE_VALUE;
+#else
+    if (_stdin != -1) close(_stdin);
+    _stdin = -1;
+#endif
+}
+
+// ===========================================================================
+// pipeline
+// ===========================================================================
+
+// ---------------------------------------------------------------------------
+Pipeline::Pipeline()
+{
+}
+
+// ---------------------------------------------------------------------------
+Pipeline::~Pipeline()
+{
+    for (size_t i = 0; i < _procs.size(); ++i) delete _procs[i];
+}
+
+// ---------------------------------------------------------------------------
+Pipeline& Pipeline::push_back(const CommandLine& cmd)
+{
+    _cmds.push_back(cmd);
+    _procs.push_back(new Subprocess());
+    return *this;
+}
+
+// ---------------------------------------------------------------------------
+bool Pipeline::popen(const RedirectMode rm_in,
+                     const RedirectMode rm_out,
+                     const RedirectMode rm_err,
+                     const Environment* env)
+{
+    if (_procs.empty()) {
+        cerr << "Pipeline::popen(): Pipeline has no commands!" << endl;
+        return false;
+    }
+    if (!poll()) {
+        cerr << "Pipeline::popen(): Previously opened processes not terminated yet!" << endl;
+        return false;
+    }
+#if WINDOWS
+    const HANDLE invalid = INVALID_HANDLE_VALUE;
+    // read end of pipe connected to stdout of previous subprocess
+    HANDLE hprev = invalid;
+    for (size_t i = 0; i < _procs.size(); ++i) {
+        HANDLE hpipe[2] = {invalid, invalid}; // read, write
+        if (i + 1 < _procs.size() && CreatePipe(&hpipe[0], &hpipe[1], NULL, 0) == 0) {
+            cerr << "Pipeline::popen(): Failed to create pipe!" << endl;
+            if (hprev != invalid) CloseHandle(hprev);
+            kill();
+            return false;
+        }
+        bool ok = _procs[i]->spawn(_cmds[i], rm_in, rm_out, rm_err, env, hprev, hpipe[1]);
+        if (hprev    != invalid) CloseHandle(hprev);
+        if (hpipe[1] != invalid) CloseHandle(hpipe[1]);
+        hprev = hpipe[0];
+        if (!ok) {
+            if (hprev != invalid) CloseHandle(hprev);
+            kill();
+            return false;
+        }
+    }
+#else
+    // read end of pipe connected to stdout of previous subprocess
+    int fdprev = -1;
+    for (size_t i = 0; i < _procs.size(); ++i) {
+        int fdpipe[2] = {-1, -1}; // read, write
+        if (i + 1 < _procs.size() && pipe_cloexec(fdpipe) == -1) {
+            cerr << "Pipeline::popen(): Failed to create pipe!" << endl;
+            if (fdprev != -1) close(fdprev);
+            kill();
+            return false;
+        }
+        bool ok = _procs[i]->spawn(_cmds[i], rm_in, rm_out, rm_err, env, fdprev, fdpipe[1]);
+        // close ends of pipes used by subprocesses only
+        if (fdprev    != -1) close(fdprev);
+        if (fdpipe[1] != -1) close(fdpipe[1]);
+        fdprev = fdpipe[0];
+        if (!ok) {
+            if (fdprev != -1) close(fdprev);
+            kill();
+            return false;
+        }
+    }
+#endif
+    return true;
+}
+
+// ---------------------------------------------------------------------------
+bool Pipeline::poll() const
+{
+    for (size_t i = 0; i < _procs.size(); ++i) {
+        if (!_procs[i]->poll()) return false;
+    }
+    return true;
+}
+
+// ---------------------------------------------------------------------------
+bool Pipeline::wait()
+{
+    bool ok = true;
+    for (size_t i = 0; i < _procs.size(); ++i) {
+        // skip subprocesses which were waited for already, e.g., by communicate()
+        if (_procs[i]->pid() > 0 && !_procs[i]->wait()) ok = false;
+    }
+    return ok;
+}
+
+// ---------------------------------------------------------------------------
+bool Pipeline::terminate()
+{
+    bool ok = true;
+    for (size_t i = 0; i < _procs.size(); ++i) {
+        if (!_procs[i]->poll() && !_procs[i]->terminate()) ok = false;
+    }
+    return ok;
+}
+
+// ---------------------------------------------------------------------------
+bool Pipeline::kill()
+{
+    bool ok = true;
+    for (size_t i = 0; i < _procs.size(); ++i) {
+        if (!_procs[i]->poll() && !_procs[i]->kill()) ok = false;
+    }
+    return ok;
+}
+
+// ---------------------------------------------------------------------------
+int Pipeline::returncode() const
+{
+    return _procs.empty() ? -1 : _procs.back()->returncode();
+}
+
+// ---------------------------------------------------------------------------
+/**
+ * @brief Handler which writes the output of pipeline stages to streams.
+ *
+ * Output written to stderr is discarded if no stream is given for it.
+ */
+class PipelineOutputHandler : public SubprocessMonitor::Handler
+{
+public:
+
+    PipelineOutputHandler(ostream& out, ostream* err) : ok(true), _out(out), _err(err) {}
+
+    void output(Subprocess&, const char* data, size_t n, bool err)
+    {
+        ostream* os = (err ? _err : &_out);
+        if (os == NULL) return;
+        os->write(data, static_cast<streamsize>(n));
+        if (os->bad()) ok = false;
+    }
+
+    bool ok; ///< Whether all output was written successfully.
+
+private:
+
+    ostream& _out;
+    ostream* _err;
+};
+
+// ---------------------------------------------------------------------------
+bool Pipeline::drain(std::ostream& out, std::ostream* err)
+{
+#if WINDOWS
+    const HANDLE invalid = INVALID_HANDLE_VALUE;
+#else
+    const int invalid = -1;
+#endif
+    PipelineOutputHandler handler(out, err);
+    SubprocessMonitor     monitor;
+    for (size_t i = 0; i < _procs.size(); ++i) {
+        // stages without pipes to the parent are waited for afterwards
+        if (_procs[i]->_stdout != invalid || _procs[i]->_stderr != invalid) {
+            monitor.add(*_procs[i], handler, SubprocessMonitor::CHUNKS);
+        }
+    }
+    monitor.run();
+    return handler.ok;
+}
+
+// ---------------------------------------------------------------------------
+bool Pipeline::communicate(std::ostream& out)
+{
+    if (_procs.empty()) return false;
+    front().close_stdin();
+    bool ok = drain(out, NULL);
+    return wait() && ok;
+}
+
+// ---------------------------------------------------------------------------
+bool Pipeline::communicate(std::ostream& out, std::ostream& err)
+{
+    if (_procs.empty()) return false;
+    front().close_stdin();
+    bool ok = drain(out, &err);
+    return wait() && ok;
+}
+
+// ===========================================================================
+// subprocess monitor
+// ===========================================================================
+
+// ---------------------------------------------------------------------------
+SubprocessMonitor::SubprocessMonitor()
+{
+}
+
+// ---------------------------------------------------------------------------
+SubprocessMonitor::~SubprocessMonitor()
+{
+    for (size_t i = 0; i < _entries.size(); ++i) delete _entries[i];
+}
+
+// ---------------------------------------------------------------------------
+void SubprocessMonitor::add(Subprocess& p, Handler& handler, Mode mode)
+{
+    Entry* entry = new Entry;
+    entry->process = &p;
+    entry->handler = &handler;
+    entry->mode    = mode;
+    _entries.push_back(entry);
+}
+
+// ---------------------------------------------------------------------------
+bool SubprocessMonitor::dispatch(Entry& entry, bool err)
+{
+    const size_t nbuf = 65536;
+    char buf[nbuf];
+
+    Subprocess&             p    = *entry.process;
+    Subprocess::PipeHandle& h    = (err ? p._stderr : p._stdout);
+    string&                 line = entry.line[err ? 1 : 0];
+
+#if WINDOWS
+    DWORD n = 0;
+    DWORD navail = 0;
+    bool  eof = !PeekNamedPipe(h, NULL, 0, NULL, &navail, NULL);
+    if (!eof) {
+        if (navail == 0) return true;
+        if (!ReadFile(h, buf, (navail < nbuf ? navail : nbuf), &n, NULL)) eof = true;
+    }
+    if (eof || n == 0) {
+        CloseHandle(h);
+        h = INVALID_HANDLE_VALUE;
+#else
+    ssize_t n = ::read(h, buf, nbuf);
+    if (n == -1 && errno == EINTR) return true;
+    if (n <= 0) {
+        close(h);
+        h = -1;
+#endif
+        // pass on incomplete last line
+        if (!line.empty()) {
+            entry.handler->output(p, line.data(), line.size(), err);
+            line.clear();
+        }
+        return false;
+    }
+
+    if (entry.mode == CHUNKS) {
+        entry.handler->output(p, buf, static_cast<size_t>(n), err);
+        return true;
+    }
+
+    // pass on complete lines without copying them unless a previous
+    // read ended in the middle of the line
+    const char* begin = buf;
+    const char* end   = buf + n;
+    const char* eol;
+    while ((eol = static_cast<const char*>(memchr(begin, '\n', end - begin))) != NULL) {
+        ++eol;
+        if (line.empty()) {
+            entry.handler->output(p, begin, static_cast<size_t>(eol - begin), err);
+        } else {
+            line.append(begin, eol);
+            entry.handler->output(p, line.data(), line.size(), err);
+            line.clear();
+        }
+        begin = eol;
+    }
+    line.append(begin, end);
+    return true;
+}
+
+// ---------------------------------------------------------------------------
+void SubprocessMonitor::finish(size_t i)
+{
+    Entry* entry = _entries[i];
+    _entries.erase(_entries.begin() + i);
+    entry->process->wait();
+    // handler may add new subprocesses to the monitor
+    entry->handler->finished(*entry->process);
+    delete entry;
+}
+
+// ---------------------------------------------------------------------------
+bool SubprocessMonitor::run_once(int timeout)
+{
+#if WINDOWS
+    const DWORD start = GetTickCount();
+    bool        ready = false;
+    while (!ready) {
+        for (size_t i = 0; i < _entries.size(); ++i) {
+            Subprocess& p = *_entries[i]->process;
+            DWORD navail = 0;
+            if (p._stdout != INVALID_HANDLE_VALUE &&
+                    (!PeekNamedPipe(p._stdout, NULL, 0, NULL, &navail, NULL) || navail > 0)) {
+                dispatch(*_entries[i], false);
+                ready = true;
+            }
+            if (p._stderr != INVALID_HANDLE_VALUE &&
+                    (!PeekNamedPipe(p._stderr, NULL, 0, NULL, &navail, NULL) || navail > 0)) {
+                dispatch(*_entries[i], true);
+                ready = true;
+            }
+            if (p._stdout == INVALID_HANDLE_VALUE && p._stderr == INVALID_HANDLE_VALUE) {
+                ready = true;
+            }
+        }
+        if (_entries.empty()) break;
+        if (timeout >= 0 && GetTickCount() - start >= static_cast<DWORD>(timeout)) break;
+        if (!ready) Sleep(1);
+    }
+    // remove finished subprocesses
+    for (size_t i = _entries.size(); i > 0; --i) {
+        Subprocess& p = *_entries[i - 1]->process;
+        if (p._stdout == INVALID_HANDLE_VALUE && p._stderr == INVALID_HANDLE_VALUE) finish(i - 1);
+    }
+#else
+    vector<struct pollfd> fds;
+    vector<size_t>        idx;
+    fds.reserve(2 * _entries.size());
+    idx.reserve(2 * _entries.size());
+    for (size_t i = 0; i < _entries.size(); ++i) {
+        Subprocess& p = *_entries[i]->process;
+        struct pollfd fd;
+        fd.events  = POLLIN;
+        fd.revents = 0;
+        if (p._stdout != -1) {
+            fd.fd = p._stdout;
+            fds.push_back(fd);
+            idx.push_back(i);
+        }
+        if (p._stderr != -1) {
+            fd.fd = p._stderr;
+            fds.push_back(fd);
+            idx.push_back(i);
+        }
+    }
+    if (!fds.empty()) {
+        if (::poll(&fds[0], fds.size(), timeout) == -1) {
+            if (errno != EINTR) {
+                BASIS_THROW(runtime_error, "poll() failed with error code " << errno);
+            }
+        } else {
+            for (size_t j = 0; j < fds.size(); ++j) {
+                if (fds[j].revents == 0) continue;
+                Entry& entry = *_entries[idx[j]];
+                dispatch(entry, fds[j].fd == entry.process->_stderr);
+            }
+        }
+    }
+    // remove finished subprocesses
+    for (size_t i = _entries.size(); i > 0; --i) {
+        Subprocess& p = *_entries[i - 1]->process;
+        if (p._stdout == -1 && p._stderr == -1) finish(i - 1);
+    }
+#endif
+    return !_entries.empty();
+}
+
+// ---------------------------------------------------------------------------
+void SubprocessMonitor::run()
+{
+    while (run_once()) {}
+}
+
 
 } // namespace basis
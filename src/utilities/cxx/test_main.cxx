@@ -35,22 +35,665 @@
  * @file  test_main.cc
  * @brief Implementation of main() function for GMock based test drivers.
  *
+ * The tests of a test driver can be run by several processes in parallel
+ * using the --basis_test_jobs=N option or the BASIS_TEST_JOBS environment
+ * variable. In this case, the test driver executes itself N times with
+ * the environment variables GTEST_TOTAL_SHARDS and GTEST_SHARD_INDEX set
+ * such that each subprocess runs a different subset of the tests. When all
+ * subprocesses finished, their output is printed in order and the XML reports
+ * are merged into the one requested by --gtest_output, if any.
+ *
+ * The wall clock time and processor time of each test and test case are
+ * reported as Dart measurements. The peak resident set size is a high-water
+ * mark of the whole process and therefore reported only once after all tests
+ * finished (the maximum over all test shards). These measurements can further
+ * be saved to a JSON file using --basis_test_timing=<file> or BASIS_TEST_TIMING. When a
+ * JSON file of a previous run is given as --basis_test_baseline=<file> or
+ * BASIS_TEST_BASELINE, tests which take longer than the baseline time times
+ * the factor set by --basis_test_threshold=<ratio> or BASIS_TEST_THRESHOLD
+ * (default: 1.5) are reported as performance regressions.
+ *
  * @ingroup CMakeHelpers
  */
 
+#include <algorithm> // max()
+#include <cstdlib>
+#include <ctime>     // clock()
+#include <map>
+#include <cstdio>   // remove()
+#include <cstring>
+#include <fstream>
 #include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
 #include <basis/test.h>
+#include <basis/os.h>
+#include <basis/subprocess.h>
 
 #if defined (_WIN32) || defined (WIN32) || defined (_WINDOWS)
 #  include <Winsock2.h> // gethostbyname()
+#  include <windows.h>
+#  include <psapi.h>    // GetProcessMemoryInfo()
 #  ifdef max
 #    undef max
 #  endif
 #  pragma comment(lib, "Ws2_32.lib")
+#  pragma comment(lib, "psapi.lib")
 #else
-#  include <netdb.h> // gethostbyname()
+#  include <netdb.h>        // gethostbyname()
+#  include <sys/resource.h> // getrusage()
+#  include <unistd.h>       // mkdtemp()
 #endif
 
+
+// ===========================================================================
+// performance measurements
+// ===========================================================================
+
+/// @brief Name of option used to request the output of test timings to a JSON file.
+static const char kTimingFlag[] = "--basis_test_timing=";
+/// @brief Name of option used to specify the JSON file of baseline test timings.
+static const char kBaselineFlag[] = "--basis_test_baseline=";
+/// @brief Name of option used to set the threshold of baseline time ratio.
+static const char kThresholdFlag[] = "--basis_test_threshold=";
+/// @brief Default ratio of test time to baseline time above which a test is
+///        reported as a performance regression.
+static const double kDefaultThreshold = 1.5;
+/// @brief Minimum wall clock time in milliseconds of a test to be considered
+///        a performance regression, i.e., to ignore the timer resolution.
+static const double kMinRegressionTime = 10.0;
+
+/// @brief Timing of a single test.
+struct TestTiming
+{
+    std::string name;     ///< Full name of test, i.e., "<test case>.<test>".
+    double      time;     ///< Wall clock time in milliseconds.
+    double      cpu_time; ///< Processor time in milliseconds.
+    bool        passed;   ///< Whether the test passed.
+};
+
+// ---------------------------------------------------------------------------
+/// @brief Get peak resident set size of this process in KiB.
+static long peak_rss()
+{
+#if defined (_WIN32) || defined (WIN32) || defined (_WINDOWS)
+    PROCESS_MEMORY_COUNTERS pmc;
+    if (!GetProcessMemoryInfo(GetCurrentProcess(), &pmc, sizeof(pmc))) return 0;
+    return static_cast<long>(pmc.PeakWorkingSetSize / 1024);
+#else
+    struct rusage usage;
+    if (getrusage(RUSAGE_SELF, &usage) != 0) return 0;
+#  if defined (__APPLE__)
+    return static_cast<long>(usage.ru_maxrss / 1024); // in bytes
+#  else
+    return static_cast<long>(usage.ru_maxrss);        // in KiB
+#  endif
+#endif
+}
+
+// ---------------------------------------------------------------------------
+/// @brief Get processor time used by this process in milliseconds.
+static double cpu_time()
+{
+    return 1000.0 * static_cast<double>(clock()) / CLOCKS_PER_SEC;
+}
+
+// ---------------------------------------------------------------------------
+/// @brief Write test timings and peak resident set size in KiB to JSON file.
+static bool write_timings(const std::string& path, const std::vector<TestTiming>& timings,
+                          long rss)
+{
+    std::ofstream ofs(path.c_str());
+    ofs << "{\n  \"peak_rss\": " << rss << ",\n  \"tests\": [";
+    for (size_t i = 0; i < timings.size(); i++) {
+        if (i > 0) ofs << ",";
+        ofs << "\n    {\"name\": \""   << timings[i].name
+            << "\", \"time\": "         << timings[i].time
+            << ", \"cpu_time\": "       << timings[i].cpu_time
+            << ", \"passed\": "         << (timings[i].passed ? "true" : "false") << "}";
+    }
+    ofs << "\n  ]\n}\n";
+    return !ofs.fail();
+}
+
+// ---------------------------------------------------------------------------
+/// @brief Get numeric value of JSON object member written by write_timings().
+static double json_number(const std::string& line, const char* name)
+{
+    const std::string key = std::string("\"") + name + "\": ";
+    const size_t      pos = line.find(key);
+    return pos == std::string::npos ? 0.0 : atof(line.c_str() + pos + key.size());
+}
+
+// ---------------------------------------------------------------------------
+/// @brief Read test timings from JSON file written by write_timings().
+///
+/// The peak resident set size @p rss is set to the maximum of its input
+/// value and the one read from the file.
+static bool read_timings(const std::string& path, std::vector<TestTiming>& timings, long& rss)
+{
+    std::ifstream ifs(path.c_str());
+    if (!ifs) return false;
+    const std::string key = "{\"name\": \"";
+    std::string line;
+    while (std::getline(ifs, line)) {
+        const size_t pos = line.find(key);
+        if (pos == std::string::npos) {
+            if (line.find("\"peak_rss\": ") != std::string::npos) {
+                rss = std::max(rss, static_cast<long>(json_number(line, "peak_rss")));
+            }
+            continue;
+        }
+        const size_t beg = pos + key.size();
+        TestTiming timing;
+        timing.name     = line.substr(beg, line.find('"', beg) - beg);
+        timing.time     = json_number(line, "time");
+        timing.cpu_time = json_number(line, "cpu_time");
+        timing.passed   = (line.find("\"passed\": true") != std::string::npos);
+        timings.push_back(timing);
+    }
+    return true;
+}
+
+// ---------------------------------------------------------------------------
+/**
+ * @brief Compare test timings to baseline and write them to JSON file.
+ *
+ * @param [in] timings   Timings of the tests which were run.
+ * @param [in] rss       Peak resident set size of test process(es) in KiB.
+ * @param [in] timing    JSON file to which test timings are written or empty string.
+ * @param [in] baseline  JSON file with baseline test timings or empty string.
+ * @param [in] threshold Ratio of test time to baseline time above which a
+ *                       test is reported as a performance regression.
+ */
+static void report_timings(const std::vector<TestTiming>& timings, long rss,
+                           const std::string& timing, const std::string& baseline,
+                           double threshold)
+{
+    std::cout << "<DartMeasurement name=\"Peak RSS\" type=\"numeric/integer\">"
+              << rss << "</DartMeasurement>" << std::endl;
+    if (!baseline.empty()) {
+        long baseline_rss = 0;
+        std::vector<TestTiming> previous;
+        if (read_timings(baseline, previous, baseline_rss)) {
+            std::map<std::string, double> times;
+            for (size_t i = 0; i < previous.size(); i++) {
+                times[previous[i].name] = previous[i].time;
+            }
+            int regressions = 0;
+            for (size_t i = 0; i < timings.size(); i++) {
+                std::map<std::string, double>::const_iterator t = times.find(timings[i].name);
+                if (t != times.end() && timings[i].time >= kMinRegressionTime
+                        && timings[i].time > threshold * t->second) {
+                    std::cout << "[  SLOWER  ] " << timings[i].name << " took " << timings[i].time
+                              << " ms (baseline: " << t->second << " ms)\n";
+                    regressions++;
+                }
+            }
+            std::cout << "<DartMeasurement name=\"Performance Regressions\" type=\"numeric/integer\">"
+                      << regressions << "</DartMeasurement>" << std::endl;
+        } else {
+            std::cerr << "Failed to read baseline test timings from " << baseline << std::endl;
+        }
+    }
+    if (!timing.empty() && !write_timings(timing, timings, rss)) {
+        std::cerr << "Failed to write test timings to " << timing << std::endl;
+    }
+}
+
+/**
+ * @brief Test event listener which reports performance measurements.
+ *
+ * The wall clock time and processor time of each test and test case are
+ * written to standard output as Dart measurements. The peak resident set size
+ * as reported by the operating system is the maximum over the lifetime of the
+ * process, including all previous tests. It is thus only reported at the end.
+ */
+class PerformanceListener : public testing::EmptyTestEventListener
+{
+public:
+
+    /**
+     * @brief Constructor.
+     *
+     * @param [in] timing    JSON file to which test timings are written or empty string.
+     * @param [in] baseline  JSON file with baseline test timings or empty string.
+     * @param [in] threshold Ratio of test time to baseline time above which a
+     *                       test is reported as a performance regression.
+     */
+    PerformanceListener(const std::string& timing, const std::string& baseline, double threshold)
+    :
+        _timing(timing), _baseline(baseline), _threshold(threshold),
+        _test_cpu_time(0.0), _case_cpu_time(0.0)
+    {}
+
+    virtual void OnTestCaseStart(const testing::TestCase&)
+    {
+        _case_cpu_time = cpu_time();
+    }
+
+    virtual void OnTestStart(const testing::TestInfo&)
+    {
+        _test_cpu_time = cpu_time();
+    }
+
+    virtual void OnTestEnd(const testing::TestInfo& test_info)
+    {
+        TestTiming timing;
+        timing.name     = std::string(test_info.test_case_name()) + "." + test_info.name();
+        timing.time     = static_cast<double>(test_info.result()->elapsed_time());
+        timing.cpu_time = cpu_time() - _test_cpu_time;
+        timing.passed   = test_info.result()->Passed();
+        Report(timing.name, timing.time, timing.cpu_time);
+        _timings.push_back(timing);
+    }
+
+    virtual void OnTestCaseEnd(const testing::TestCase& test_case)
+    {
+        Report(test_case.name(), static_cast<double>(test_case.elapsed_time()),
+               cpu_time() - _case_cpu_time);
+    }
+
+    virtual void OnTestProgramEnd(const testing::UnitTest&)
+    {
+        report_timings(_timings, peak_rss(), _timing, _baseline, _threshold);
+    }
+
+private:
+
+    /// @brief Write measurements of test or test case to standard output.
+    static void Report(const std::string& name, double time, double cpu)
+    {
+        std::cout << "<DartMeasurement name=\"" << name << " Time\" type=\"numeric/double\">"
+                  << time << "</DartMeasurement>\n"
+                  << "<DartMeasurement name=\"" << name << " CPU Time\" type=\"numeric/double\">"
+                  << cpu << "</DartMeasurement>" << std::endl;
+    }
+
+    std::string             _timing;        ///< Output JSON file.
+    std::string             _baseline;      ///< JSON file of baseline timings.
+    double                  _threshold;     ///< Regression threshold.
+    double                  _test_cpu_time; ///< Processor time at start of test.
+    double                  _case_cpu_time; ///< Processor time at start of test case.
+    std::vector<TestTiming> _timings;       ///< Timings of finished tests.
+};
+
+// ===========================================================================
+// parallel execution of test shards
+// ===========================================================================
+
+/// @brief Name of option used to request the parallel execution of test shards.
+static const char kJobsFlag[] = "--basis_test_jobs=";
+
+// ---------------------------------------------------------------------------
+/// @brief Read entire file into string.
+static std::string read_file(const std::string& path)
+{
+    std::ifstream ifs(path.c_str(), std::ios::in | std::ios::binary);
+    std::ostringstream oss;
+    if (ifs) oss << ifs.rdbuf();
+    return oss.str();
+}
+
+// ---------------------------------------------------------------------------
+/// @brief Create new temporary directory for the output files of the test shards.
+///
+/// @param [in] prefix Prefix of directory name. Not used on Windows.
+///
+/// @returns Path of created directory or empty string on failure.
+static std::string make_temp_dir(const std::string& prefix)
+{
+#if defined (_WIN32) || defined (WIN32) || defined (_WINDOWS)
+    char tmpdir[MAX_PATH + 1];
+    char fname [MAX_PATH + 1];
+    if (GetTempPathA(MAX_PATH + 1, tmpdir) == 0) return std::string();
+    if (GetTempFileNameA(tmpdir, "tst", 0, fname) == 0) return std::string();
+    // replace unique file by directory of the same name
+    DeleteFileA(fname);
+    if (!CreateDirectoryA(fname, NULL)) return std::string();
+    return fname;
+#else
+    const char* tmpdir = getenv("TMPDIR");
+    if (tmpdir == NULL || *tmpdir == '\0') tmpdir = "/tmp";
+    const std::string tmpl = std::string(tmpdir) + "/" + prefix + "-XXXXXX";
+    std::vector<char> dirname(tmpl.begin(), tmpl.end());
+    dirname.push_back('\0');
+    if (mkdtemp(&dirname[0]) == NULL) return std::string();
+    return &dirname[0];
+#endif
+}
+
+// ---------------------------------------------------------------------------
+/// @brief Find next XML element with given tag name starting at position @p pos.
+///
+/// @returns Whether the element was found. If so, @p begin and @p end are set to
+///          the start of the element and the position following its end tag.
+static bool xml_element(const std::string& xml, const char* tag, size_t pos,
+                        size_t& begin, size_t& end)
+{
+    begin = xml.find(std::string("<") + tag + " ", pos);
+    if (begin == std::string::npos) return false;
+    end = xml.find('>', begin);
+    if (end == std::string::npos) return false;
+    if (xml[end - 1] == '/') {
+        end += 1;
+    } else {
+        const std::string endtag = std::string("</") + tag + ">";
+        end = xml.find(endtag, end);
+        if (end == std::string::npos) return false;
+        end += endtag.size();
+    }
+    return true;
+}
+
+// ---------------------------------------------------------------------------
+/// @brief Get value of attribute of XML element starting at position @p tag.
+static std::string xml_attribute(const std::string& xml, size_t tag, const char* name)
+{
+    const std::string attr = std::string(" ") + name + "=\"";
+    const size_t      end  = xml.find('>', tag);
+    const size_t      pos  = xml.find(attr, tag);
+    if (pos == std::string::npos || pos > end) return std::string();
+    const size_t      beg  = pos + attr.size();
+    return xml.substr(beg, xml.find('"', beg) - beg);
+}
+
+// ---------------------------------------------------------------------------
+/// @brief Get numeric value of attribute of XML element starting at position @p tag.
+static double xml_number(const std::string& xml, size_t tag, const char* name)
+{
+    return atof(xml_attribute(xml, tag, name).c_str());
+}
+
+/**
+ * @brief Merge XML reports of test shards.
+ *
+ * Each test shard reports all tests, where the tests run by other shards have
+ * the status "notrun". The reports thus list the same test cases in the same
+ * order, and the merged report contains for each test case the element of the
+ * report of the shard which ran it.
+ *
+ * @param [in]  xml    XML reports of test shards.
+ * @param [out] out    Merged XML report.
+ * @param [out] run    Number of tests that were run.
+ * @param [out] failed Number of tests that failed.
+ *
+ * @returns Whether the reports could be merged.
+ */
+static bool merge_xml_reports(const std::vector<std::string>& xml, std::ostream& out,
+                              int& run, int& failed)
+{
+    const size_t       n = xml.size();
+    std::vector<size_t> pos(n, 0), begin(n), end(n);
+    double failures = 0.0, errors = 0.0, time = 0.0;
+    run = failed = 0;
+    // root element
+    for (size_t i = 0; i < n; i++) {
+        pos[i] = xml[i].find("<testsuites");
+        if (pos[i] == std::string::npos) return false;
+        failures += xml_number(xml[i], pos[i], "failures");
+        errors   += xml_number(xml[i], pos[i], "errors");
+        time      = std::max(time, xml_number(xml[i], pos[i], "time"));
+    }
+    std::ostringstream suites;
+    // test suites
+    while (xml_element(xml[0], "testsuite", pos[0], begin[0], end[0])) {
+        double suite_failures = 0.0, suite_errors = 0.0, suite_time = 0.0;
+        for (size_t i = 0; i < n; i++) {
+            if (i > 0 && !xml_element(xml[i], "testsuite", pos[i], begin[i], end[i])) return false;
+            suite_failures += xml_number(xml[i], begin[i], "failures");
+            suite_errors   += xml_number(xml[i], begin[i], "errors");
+            suite_time     += xml_number(xml[i], begin[i], "time");
+            pos[i] = begin[i] + 1;
+        }
+        suites << "  <testsuite name=\"" << xml_attribute(xml[0], begin[0], "name")
+               << "\" tests=\""         << xml_attribute(xml[0], begin[0], "tests")
+               << "\" failures=\""      << suite_failures
+               << "\" disabled=\""      << xml_attribute(xml[0], begin[0], "disabled")
+               << "\" errors=\""        << suite_errors
+               << "\" time=\""          << suite_time << "\">\n";
+        // test cases
+        const size_t suite_end = end[0];
+        size_t tb, te;
+        while (xml_element(xml[0], "testcase", pos[0], tb, te) && te <= suite_end) {
+            size_t k = 0;
+            for (size_t i = 0; i < n; i++) {
+                if (i == 0) begin[i] = tb, end[i] = te;
+                else if (!xml_element(xml[i], "testcase", pos[i], begin[i], end[i])) return false;
+                if (xml_attribute(xml[i], begin[i], "status") == "run") k = i;
+                pos[i] = end[i];
+            }
+            if (xml_attribute(xml[k], begin[k], "status") == "run") {
+                run++;
+                const size_t failure = xml[k].find("<failure", begin[k]);
+                if (failure != std::string::npos && failure < end[k]) failed++;
+            }
+            suites << "    ";
+            suites.write(xml[k].data() + begin[k], static_cast<std::streamsize>(end[k] - begin[k]));
+            suites << "\n";
+        }
+        suites << "  </testsuite>\n";
+        // continue after end of test suite
+        for (size_t i = 0; i < n; i++) {
+            pos[i] = xml[i].find("</testsuite>", pos[i]);
+            if (pos[i] == std::string::npos) return false;
+        }
+    }
+    const size_t root = xml[0].find("<testsuites");
+    out << "<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n"
+        << "<testsuites tests=\"" << xml_attribute(xml[0], root, "tests")
+        << "\" failures=\""      << failures
+        << "\" disabled=\""      << xml_attribute(xml[0], root, "disabled")
+        << "\" errors=\""        << errors
+        << "\" time=\""          << time << "\" name=\"AllTests\">\n"
+        << suites.str()
+        << "</testsuites>\n";
+    return true;
+}
+
+// ---------------------------------------------------------------------------
+/// @brief Path of XML report requested by --gtest_output or empty string.
+static std::string xml_output_path()
+{
+    const std::string output = testing::GTEST_FLAG(output);
+    if (output.compare(0, 3, "xml") != 0) return std::string();
+    if (output.size() <= 4) return "test_detail.xml";
+    std::string path = output.substr(4);
+    const char last = path[path.size() - 1];
+    if (last == '/' || last == '\\') {
+        path += basis::os::exename() + ".xml";
+    }
+    return path;
+}
+
+/**
+ * @brief Run shards of the tests in parallel subprocesses and merge their results.
+ *
+ * @param [in] argv      Arguments of this test driver excluding the --basis_test_*
+ *                       options of this main() function.
+ * @param [in] jobs      Number of test shards and subprocesses.
+ * @param [in] timing    JSON file to which test timings are written or empty string.
+ * @param [in] baseline  JSON file with baseline test timings or empty string.
+ * @param [in] threshold Ratio of test time to baseline time above which a
+ *                       test is reported as a performance regression.
+ *
+ * @returns Exit code of test driver.
+ */
+static int run_test_shards(const std::vector<std::string>& argv, int jobs,
+                           const std::string& timing, const std::string& baseline,
+                           double threshold)
+{
+    const std::string exe  = basis::os::exepath();
+    const std::string base = basis::os::exename();
+
+    // output files of test shards are written to a new temporary directory
+    // such that concurrent runs of the same test driver do not interfere
+    const std::string tmpdir = make_temp_dir(base);
+    if (tmpdir.empty()) {
+        std::cerr << "Failed to create temporary directory for output of test shards" << std::endl;
+        return 1;
+    }
+
+    // start subprocesses
+    std::vector<basis::Subprocess*> procs(jobs, NULL);
+    std::vector<std::string>        logs (jobs);
+    std::vector<std::string>        xmls (jobs);
+    std::vector<std::string>        jsons(jobs);
+    for (int i = 0; i < jobs; i++) {
+        std::ostringstream prefix;
+        prefix << basis::os::path::join(tmpdir, base) << "-shard" << i;
+        logs[i] = prefix.str() + ".log";
+        xmls[i] = prefix.str() + ".xml";
+        jsons[i] = prefix.str() + ".json"; // also used to get peak RSS of shard
+        basis::Subprocess::CommandLine cmd;
+        cmd.push_back(exe);
+        for (size_t j = 1; j < argv.size(); j++) {
+            if (argv[j].compare(0, 14, "--gtest_output") != 0) cmd.push_back(argv[j]);
+        }
+        cmd.push_back("--gtest_output=xml:" + xmls[i]);
+        cmd.push_back(kTimingFlag + jsons[i]);
+        basis::Subprocess::Environment env;
+        std::ostringstream total, index;
+        total << "GTEST_TOTAL_SHARDS=" << jobs;
+        index << "GTEST_SHARD_INDEX="  << i;
+        env.push_back(total.str());
+        env.push_back(index.str());
+        // timings of all shards are compared to the baseline below
+        env.push_back("BASIS_TEST_BASELINE=");
+        #if defined (_WIN32) || defined (WIN32) || defined (_WINDOWS)
+            // environment of subprocess is inherited from parent on Windows
+            for (size_t j = 0; j < env.size(); j++) _putenv(env[j].c_str());
+        #endif
+        procs[i] = new basis::Subprocess();
+        procs[i]->stdout_file(logs[i]);
+        if (!procs[i]->popen(cmd, basis::Subprocess::RM_NONE,
+                                  basis::Subprocess::RM_FILE,
+                                  basis::Subprocess::RM_STDOUT, &env)) {
+            std::cerr << "Failed to run test shard " << i << ": "
+                      << basis::Subprocess::tostring(cmd) << std::endl;
+            delete procs[i];
+            procs[i] = NULL;
+        }
+    }
+
+    // wait for subprocesses and print their output
+    int                      status = 0;
+    std::vector<std::string> reports;
+    std::vector<TestTiming>  timings;
+    long                     rss = 0;
+    for (int i = 0; i < jobs; i++) {
+        if (procs[i] == NULL) {
+            status = 1;
+            continue;
+        }
+        procs[i]->wait();
+        if (procs[i]->returncode() != 0) status = 1;
+        delete procs[i];
+        const std::string log = read_file(logs[i]);
+        std::cout << "[  SHARD   ] " << (i + 1) << "/" << jobs << "\n" << log;
+        if (!log.empty() && log[log.size() - 1] != '\n') std::cout << "\n";
+        const std::string xml = read_file(xmls[i]);
+        if (xml.empty()) {
+            std::cout << "[  SHARD   ] " << (i + 1) << "/" << jobs << " produced no test report!\n";
+            status = 1;
+        } else {
+            reports.push_back(xml);
+        }
+        read_timings(jsons[i], timings, rss);
+    }
+    basis::os::rmtree(tmpdir);
+
+    // merge reports
+    std::ostringstream merged;
+    int run = 0, failed = 0;
+    if (reports.empty() || !merge_xml_reports(reports, merged, run, failed)) {
+        std::cout << "[  SHARD   ] Failed to merge test reports of shards!\n";
+        status = 1;
+    }
+    const std::string output = xml_output_path();
+    if (!output.empty()) {
+        std::ofstream ofs(output.c_str());
+        ofs << merged.str();
+        if (!ofs) {
+            std::cerr << "Failed to write test report " << output << std::endl;
+            status = 1;
+        }
+    }
+
+    // summary
+    std::cout << "[==========] " << run << " tests ran in " << jobs << " shards.\n"
+              << "[  PASSED  ] " << (run - failed) << " tests.\n";
+    if (failed > 0) {
+        std::cout << "[  FAILED  ] " << failed << " tests.\n";
+    }
+    std::cout << "<DartMeasurement name=\"Test Shards\" type=\"numeric/integer\">"
+              << jobs << "</DartMeasurement>\n"
+              << "<DartMeasurement name=\"Tests Run\" type=\"numeric/integer\">"
+              << run << "</DartMeasurement>\n"
+              << "<DartMeasurement name=\"Tests Failed\" type=\"numeric/integer\">"
+              << failed << "</DartMeasurement>" << std::endl;
+    report_timings(timings, rss, timing, baseline, threshold);
+    return status;
+}
+
+// ===========================================================================
+// options
+// ===========================================================================
+
+// ---------------------------------------------------------------------------
+/**
+ * @brief Get value of option of this main() function.
+ *
+ * The option is removed from the arguments.
+ *
+ * @param [in, out] argc Number of arguments.
+ * @param [in, out] argv Arguments.
+ * @param [in]      flag Option flag including the trailing '='.
+ * @param [in]      env  Name of environment variable used when option not given.
+ *
+ * @returns Value of the option or empty string if not set.
+ */
+static std::string get_option(int& argc, char** argv, const char* flag, const char* env)
+{
+    std::string value;
+    const char* default_value = getenv(env);
+    if (default_value) value = default_value;
+    const size_t len = strlen(flag);
+    for (int i = 1; i < argc; i++) {
+        if (strncmp(argv[i], flag, len) == 0) {
+            value = argv[i] + len;
+            for (int j = i; j < argc; j++) argv[j] = argv[j + 1];
+            argc--;
+            i--;
+        }
+    }
+    return value;
+}
+
+// ---------------------------------------------------------------------------
+/**
+ * @brief Get number of parallel test shards requested by the user.
+ *
+ * The --basis_test_jobs option is removed from the arguments.
+ *
+ * @returns Number of test shards or 1 if tests are to be run by this process.
+ */
+static int get_test_jobs(int& argc, char** argv)
+{
+    int jobs = atoi(get_option(argc, argv, kJobsFlag, "BASIS_TEST_JOBS").c_str());
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--help") == 0 || strcmp(argv[i], "-h") == 0 ||
+            strcmp(argv[i], "-?")     == 0 || strcmp(argv[i], "/?") == 0) {
+            return 1;
+        }
+    }
+    // already a shard or only listing the tests
+    if (getenv("GTEST_TOTAL_SHARDS") || testing::GTEST_FLAG(list_tests)) jobs = 1;
+    return jobs > 1 ? jobs : 1;
+}
+
 // MS C++ compiler/linker has a bug on Windows (not on Windows CE), which
 // causes a link error when _tmain is defined in a static library and UNICODE
 // is enabled. For this reason instead of _tmain, main function is used on
@@ -92,6 +735,28 @@ int main(int argc, char** argv) {
     // Since Google Mock depends on Google Test, InitGoogleMock() is
     // also responsible for initializing Google Test.  Therefore there's
     // no need for calling testing::InitGoogleTest() separately.
+    #if GTEST_OS_WINDOWS_MOBILE
     testing::InitGoogleMock(&argc, argv);
+    #else
+    std::vector<std::string> args(argv, argv + argc);
+    testing::InitGoogleMock(&argc, argv);
+    // performance measurements
+    const std::string timing    = get_option(argc, argv, kTimingFlag,    "BASIS_TEST_TIMING");
+    const std::string baseline  = get_option(argc, argv, kBaselineFlag,  "BASIS_TEST_BASELINE");
+    const std::string ratio     = get_option(argc, argv, kThresholdFlag, "BASIS_TEST_THRESHOLD");
+    const double      threshold = ratio.empty() ? kDefaultThreshold : atof(ratio.c_str());
+    // run test shards in parallel subprocesses if requested
+    const int jobs = get_test_jobs(argc, argv);
+    if (jobs > 1) {
+        for (size_t i = 1; i < args.size(); i++) {
+            if (args[i].compare(0, 13, "--basis_test_") == 0) {
+                args.erase(args.begin() + i--);
+            }
+        }
+        return run_test_shards(args, jobs, timing, baseline, threshold);
+    }
+    testing::UnitTest::GetInstance()->listeners().Append(
+            new PerformanceListener(timing, baseline, threshold));
+    #endif
     return RUN_ALL_TESTS();
 }
@@ -14,6 +14,21 @@
  * @ingroup BasisCxxUtilities
  */
 
+#include <fstream>
+#include <cstdlib>  // getenv
+#include <cstring>  // strlen
+#include <cstdio>   // remove
+#include <climits>  // _POSIX_ARG_MAX
+
+#include <basis/config.h>
+
+#if WINDOWS
+#  include <windows.h>
+#else
+#  include <unistd.h> // sysconf, mkstemp
+extern char** environ;
+#endif
+
 #include <basis/subprocess.h>
 #include <basis/utilities.h>
 
@@ -134,19 +149,91 @@ vector<string> qsplit(const string& args)
     return Subprocess::split(args);
 }
 
+// ---------------------------------------------------------------------------
+/**
+ * @brief Whether command-line exceeds the maximum length supported by the system.
+ */
+static bool exceeds_arg_max(const vector<string>& args)
+{
+#if WINDOWS
+    // maximum length of command-line passed to CreateProcess()
+    return Subprocess::tostring(args).size() >= 32767;
+#else
+    long arg_max = sysconf(_SC_ARG_MAX);
+    if (arg_max <= 0) arg_max = _POSIX_ARG_MAX;
+    // arguments and environment share the available space,
+    // leave some head room for the auxiliary vector
+    size_t n = 2048;
+    for (char** env = environ; env != NULL && *env != NULL; ++env) {
+        n += strlen(*env) + 1 + sizeof(char*);
+    }
+    for (vector<string>::const_iterator arg = args.begin(); arg != args.end(); ++arg) {
+#  if LINUX
+        // maximum length of a single argument (MAX_ARG_STRLEN)
+        if (arg->size() >= 32 * 4096) return true;
+#  endif
+        n += arg->size() + 1 + sizeof(char*);
+    }
+    return n > static_cast<size_t>(arg_max);
+#endif
+}
+
+// ---------------------------------------------------------------------------
+/**
+ * @brief Write arguments to temporary response file.
+ *
+ * @param [in] args  Command-line arguments.
+ * @param [in] first Index of first argument to write to the file.
+ *
+ * @returns Path of response file or an empty string on failure.
+ */
+static string write_response_file(const vector<string>& args, size_t first)
+{
+    string path;
+#if WINDOWS
+    char tmpdir[MAX_PATH + 1];
+    char fname [MAX_PATH + 1];
+    if (GetTempPathA(MAX_PATH + 1, tmpdir) == 0) return "";
+    if (GetTempFileNameA(tmpdir, "rsp", 0, fname) == 0) return "";
+    path = fname;
+#else
+    const char* tmpdir = getenv("TMPDIR");
+    if (tmpdir == NULL || *tmpdir == '\0') tmpdir = "/tmp";
+    string tmpl = string(tmpdir) + "/basis-args-XXXXXX";
+    vector<char> fname(tmpl.begin(), tmpl.end());
+    fname.push_back('\0');
+    int fd = mkstemp(&fname[0]);
+    if (fd == -1) return "";
+    close(fd);
+    path = &fname[0];
+#endif
+    ofstream ofs(path.c_str(), ios::out | ios::binary | ios::trunc);
+    Subprocess::CommandLine arg(1);
+    for (size_t i = first; i < args.size() && ofs.good(); ++i) {
+        arg[0] = args[i];
+        ofs << Subprocess::tostring(arg) << '\n';
+    }
+    ofs.close();
+    if (ofs.fail()) {
+        remove(path.c_str());
+        return "";
+    }
+    return path;
+}
+
 // ---------------------------------------------------------------------------
 int execute(const string& cmd, bool quiet, ostream* out,
             bool allow_fail, int verbose, bool simulate,
-            const IExecutableTargetInfo* targets)
+            const IExecutableTargetInfo* targets, bool response_file)
 {
     vector<string> args = Subprocess::split(cmd);
-    return execute(args, quiet, out, allow_fail, verbose, simulate, targets);
+    return execute(args, quiet, out, allow_fail, verbose, simulate, targets, response_file);
 }
 
 // ---------------------------------------------------------------------------
 int execute(vector<string> args, bool quiet, ostream* out,
             bool allow_fail, int verbose, bool simulate,
-            const IExecutableTargetInfo* targets)
+            const IExecutableTargetInfo* targets, bool response_file)
 {
     if (args.empty() || args[0].empty()) {
         BASIS_THROW(SubprocessError, "execute_process(): No command specified");
@@ -161,12 +248,28 @@ int execute(vector<string> args, bool quiet, ostream* out,
         if (simulate) cout << " (simulated)";
         cout << endl;
     }
+    // pass arguments in response file if command-line is too long and
+    // the caller indicated that the executable reads @file arguments
+    string rspfile;
+    if (response_file && args.size() > 1 && exceeds_arg_max(args)) {
+        rspfile = write_response_file(args, 1);
+        if (rspfile.empty()) {
+            BASIS_THROW(SubprocessError, "execute_process(): Failed to write response file");
+        }
+        if (verbose > 0) cout << "Passing arguments in response file " << rspfile << endl;
+        args.resize(2);
+        args[1] = "@" + rspfile;
+    }
     // execute command
     char buf[1024];
     int  n;
     int status = 0;
     Subprocess p;
-    if (!p.popen(args, Subprocess::RM_NONE, Subprocess::RM_PIPE, Subprocess::RM_PIPE)) {
+    // discard output directly in subprocess if it is not used
+    Subprocess::RedirectMode rm_out = Subprocess::RM_PIPE;
+    if (quiet && out == NULL) rm_out = Subprocess::RM_DEVNULL;
+    if (!p.popen(args, Subprocess::RM_NONE, rm_out, Subprocess::RM_PIPE)) {
+        if (!rspfile.empty()) remove(rspfile.c_str());
         BASIS_THROW(SubprocessError, "execute_process(): Failed to create subprocess");
     }
     // read child's stdout (blocking)
@@ -181,7 +284,9 @@ int execute(vector<string> args, bool quiet, ostream* out,
         }
     }
     // wait for child process
-    if (!p.wait()) {
+    bool finished = p.wait();
+    if (!rspfile.empty()) remove(rspfile.c_str());
+    if (!finished) {
         BASIS_THROW(SubprocessError, "execute_process(): Failed to wait for subprocess");
     }
     // write error messages to stderr of parent process
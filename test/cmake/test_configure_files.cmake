@@ -0,0 +1,86 @@
+##############################################################################
+# @file  test_configure_files.cmake
+# @brief Test basis_configure_files().
+##############################################################################
+
+# ----------------------------------------------------------------------------
+# include modules
+include ("${MODULE_PATH}/CommonTools.cmake")
+
+# ----------------------------------------------------------------------------
+# auxiliary functions
+set (ROOT     "${OUTPUT_DIR}/test_configure_files/tree")
+set (MANIFEST "${ROOT}/manifest.cmake")
+
+function (assert_file_content FILE EXPECTED)
+  if (NOT EXISTS "${FILE}")
+    message (FATAL_ERROR "File ${FILE} does not exist")
+  endif ()
+  file (READ "${FILE}" ACTUAL)
+  if (NOT "^${ACTUAL}$" STREQUAL "^${EXPECTED}$")
+    message (FATAL_ERROR "Content of ${FILE}:\n\texpected: \"${EXPECTED}\"\n\tactual:   \"${ACTUAL}\"")
+  endif ()
+endfunction ()
+
+# ----------------------------------------------------------------------------
+# input files
+set (AT "@") # avoid evaluation of @VAR@ in quoted arguments
+file (REMOVE_RECURSE "${ROOT}")
+file (WRITE "${ROOT}/src/a.h.in" "${AT}A${AT}\n")
+file (WRITE "${ROOT}/src/b.h.in" "#cmakedefine B\n")
+file (WRITE "${ROOT}/src/c.h.in" "const\n")
+set (INPUTS  "${ROOT}/src/a.h.in" "${ROOT}/src/b.h.in" "${ROOT}/src/c.h.in")
+set (OUTPUTS "${ROOT}/include/a.h" "${ROOT}/include/b.h" "${ROOT}/include/c.h")
+set (A 1)
+set (B ON)
+
+# input files modified during the current second are always configured
+basis_configure_files ("${MANIFEST}" INPUTS ${INPUTS} OUTPUTS ${OUTPUTS})
+assert_file_content ("${ROOT}/include/a.h" "1\n")
+assert_file_content ("${ROOT}/include/b.h" "#define B\n")
+assert_file_content ("${ROOT}/include/c.h" "const\n")
+file (WRITE "${ROOT}/include/c.h" "modified\n")
+basis_configure_files ("${MANIFEST}" INPUTS ${INPUTS} OUTPUTS ${OUTPUTS})
+assert_file_content ("${ROOT}/include/c.h" "const\n")
+
+execute_process (COMMAND "${CMAKE_COMMAND}" -E sleep 1.1)
+basis_configure_files ("${MANIFEST}" INPUTS ${INPUTS} OUTPUTS ${OUTPUTS})
+
+# ----------------------------------------------------------------------------
+# unmodified files are not configured again
+if (NOT CMAKE_VERSION VERSION_LESS 3.0)
+  foreach (N IN ITEMS a b c)
+    file (WRITE "${ROOT}/include/${N}.h" "modified\n")
+  endforeach ()
+  basis_configure_files ("${MANIFEST}" INPUTS ${INPUTS} OUTPUTS ${OUTPUTS})
+  assert_file_content ("${ROOT}/include/a.h" "modified\n")
+  assert_file_content ("${ROOT}/include/b.h" "modified\n")
+  assert_file_content ("${ROOT}/include/c.h" "modified\n")
+endif ()
+
+# ----------------------------------------------------------------------------
+# files are configured again when a referenced variable was modified
+set (A 2)
+set (B OFF)
+basis_configure_files ("${MANIFEST}" INPUTS ${INPUTS} OUTPUTS ${OUTPUTS})
+assert_file_content ("${ROOT}/include/a.h" "2\n")
+assert_file_content ("${ROOT}/include/b.h" "/* #undef B */\n")
+
+# ----------------------------------------------------------------------------
+# files are configured again when the input was modified or output removed
+file (WRITE "${ROOT}/src/c.h.in" "${AT}A${AT}\n")
+basis_configure_files ("${MANIFEST}" INPUTS ${INPUTS} OUTPUTS ${OUTPUTS})
+assert_file_content ("${ROOT}/include/c.h" "2\n")
+file (REMOVE "${ROOT}/include/a.h")
+basis_configure_files ("${MANIFEST}" INPUTS ${INPUTS} OUTPUTS ${OUTPUTS})
+assert_file_content ("${ROOT}/include/a.h" "2\n")
+
+# ----------------------------------------------------------------------------
+# output files of removed input files are removed
+list (REMOVE_AT INPUTS  1)
+list (REMOVE_AT OUTPUTS 1)
+basis_configure_files ("${MANIFEST}" INPUTS ${INPUTS} OUTPUTS ${OUTPUTS})
+if (EXISTS "${ROOT}/include/b.h")
+  message (FATAL_ERROR "Output file of removed input file not removed")
+endif ()
+assert_file_content ("${ROOT}/include/a.h" "2\n")
@@ -0,0 +1,74 @@
+##############################################################################
+# @file  test_git_revision.cmake
+# @brief Test basis_git_find_dir() and basis_git_read_head().
+##############################################################################
+
+# ----------------------------------------------------------------------------
+# include modules
+include ("${MODULE_PATH}/CommonTools.cmake")
+include ("${MODULE_PATH}/RevisionTools.cmake")
+
+# ----------------------------------------------------------------------------
+# auxiliary functions
+set (ROOT "${OUTPUT_DIR}/test_git_revision/tree")
+set (SHA1 "0123456789abcdef0123456789abcdef01234567")
+set (SHA2 "89abcdef0123456789abcdef0123456789abcdef")
+
+function (assert_equal NAME ACTUAL EXPECTED)
+  if (NOT "^${ACTUAL}$" STREQUAL "^${EXPECTED}$")
+    message (FATAL_ERROR "${NAME}:\n\texpected: \"${EXPECTED}\"\n\tactual:   \"${ACTUAL}\"")
+  endif ()
+endfunction ()
+
+function (assert_head NAME DIR EXPECTED)
+  basis_git_find_dir (GIT_DIR "${DIR}")
+  basis_git_read_head ("${GIT_DIR}" SHA)
+  assert_equal ("${NAME}" "${SHA}" "${EXPECTED}")
+endfunction ()
+
+file (REMOVE_RECURSE "${ROOT}")
+
+# ----------------------------------------------------------------------------
+# loose and packed references
+file (WRITE "${ROOT}/repo/.git/HEAD" "ref: refs/heads/master\n")
+file (WRITE "${ROOT}/repo/.git/packed-refs"
+  "# pack-refs with: peeled fully-peeled sorted\n"
+  "${SHA2} refs/heads/master\n"
+  "${SHA1} refs/heads/master.x\n"
+)
+file (MAKE_DIRECTORY "${ROOT}/repo/src/sub")
+
+basis_git_find_dir (GIT_DIR "${ROOT}/repo/src/sub")
+assert_equal ("Git directory" "${GIT_DIR}" "${ROOT}/repo/.git")
+assert_head ("packed reference" "${ROOT}/repo/src/sub" "${SHA2}")
+file (WRITE "${ROOT}/repo/.git/refs/heads/master" "${SHA1}\n")
+assert_head ("loose reference" "${ROOT}/repo/src/sub" "${SHA1}")
+file (WRITE "${ROOT}/repo/.git/HEAD" "ref: refs/heads/unborn\n")
+assert_head ("unborn branch" "${ROOT}/repo" "")
+file (WRITE "${ROOT}/repo/.git/HEAD" "${SHA2}\n")
+assert_head ("detached HEAD" "${ROOT}/repo" "${SHA2}")
+
+basis_is_git_repository (FLAG "${ROOT}/repo/src")
+assert_equal ("basis_is_git_repository" "${FLAG}" "TRUE")
+basis_git_get_revision ("${ROOT}/repo/src" REV 7)
+assert_equal ("basis_git_get_revision" "${REV}" "89abcde")
+
+# ----------------------------------------------------------------------------
+# linked working tree with .git file and commondir
+file (WRITE "${ROOT}/repo/.git/HEAD" "ref: refs/heads/master\n")
+file (WRITE "${ROOT}/repo/.git/worktrees/wt/HEAD" "ref: refs/heads/master\n")
+file (WRITE "${ROOT}/repo/.git/worktrees/wt/commondir" "../..\n")
+file (WRITE "${ROOT}/wt/.git" "gitdir: ../repo/.git/worktrees/wt\n")
+
+basis_git_find_dir (GIT_DIR "${ROOT}/wt")
+assert_equal ("Git directory of working tree" "${GIT_DIR}" "${ROOT}/repo/.git/worktrees/wt")
+assert_head ("HEAD of working tree" "${ROOT}/wt" "${SHA1}")
+
+# ----------------------------------------------------------------------------
+# directory which is not inside a working tree
+file (MAKE_DIRECTORY "${ROOT}/other")
+basis_git_find_dir (GIT_DIR "${ROOT}/other")
+if (GIT_DIR AND NOT GIT_DIR MATCHES "^${ROOT}")
+  return () # output directory is inside another working tree
+endif ()
+assert_equal ("Git directory of other directory" "${GIT_DIR}" "")
@@ -0,0 +1,110 @@
+##############################################################################
+# @file  test_glob.cmake
+# @brief Test glob.cmake check of source files of globbed targets.
+##############################################################################
+
+# ----------------------------------------------------------------------------
+# include modules
+include ("${MODULE_PATH}/CommonTools.cmake")
+
+# ----------------------------------------------------------------------------
+# auxiliary functions
+set (ROOT     "${OUTPUT_DIR}/test_glob/tree")
+set (SRC_DIR  "${ROOT}/src")
+set (MANIFEST "${ROOT}/GlobFiles.txt")
+
+function (run_glob_check EXPECTED_RESULT)
+  execute_process (
+    COMMAND "${CMAKE_COMMAND}" "-DMANIFEST=${MANIFEST}" "-DERRORMSG=Re-configure!"
+                               -P "${MODULE_PATH}/glob.cmake"
+    RESULT_VARIABLE RETVAL
+    OUTPUT_VARIABLE STDOUT
+    ERROR_VARIABLE  STDERR
+  )
+  if (EXPECTED_RESULT AND NOT RETVAL EQUAL 0)
+    message (FATAL_ERROR "Expected glob check to succeed, but it failed:\n${STDOUT}${STDERR}")
+  elseif (NOT EXPECTED_RESULT)
+    if (RETVAL EQUAL 0)
+      message (FATAL_ERROR "Expected glob check to fail, but it succeeded")
+    endif ()
+    if (NOT STDERR MATCHES "foo\n.*Re-configure!" OR STDERR MATCHES "bar")
+      message (FATAL_ERROR "Expected glob check to report changed target foo only:\n${STDERR}")
+    endif ()
+  endif ()
+endfunction ()
+
+# ----------------------------------------------------------------------------
+# globbed source tree of two targets
+file (REMOVE_RECURSE "${ROOT}")
+file (WRITE "${SRC_DIR}/foo/a.cxx"     "")
+file (WRITE "${SRC_DIR}/foo/sub/b.cxx" "")
+file (WRITE "${SRC_DIR}/foo/.c.cxx"    "")
+file (WRITE "${SRC_DIR}/bar/d.cxx"     "")
+
+# directories modified during the current second have no valid timestamp
+basis_get_glob_timestamps (DIRECTORIES TIMESTAMPS "${SRC_DIR}/foo/**.cxx")
+if (DIRECTORIES OR TIMESTAMPS)
+  message (FATAL_ERROR "Expected no timestamps of just modified directories")
+endif ()
+execute_process (COMMAND "${CMAKE_COMMAND}" -E sleep 1.1)
+
+# ----------------------------------------------------------------------------
+# test basis_glob_source_files()
+basis_glob_source_files (SOURCES "${SRC_DIR}/foo/**.cxx" "$<TARGET_OBJECTS:obj>")
+list (SORT SOURCES)
+set (EXPECTED "$<TARGET_OBJECTS:obj>" "${SRC_DIR}/foo/a.cxx" "${SRC_DIR}/foo/sub/b.cxx")
+if (NOT "${SOURCES}" STREQUAL "${EXPECTED}")
+  message (FATAL_ERROR "basis_glob_source_files():\n\texpected: \"${EXPECTED}\"\n\tactual:   \"${SOURCES}\"")
+endif ()
+
+# ----------------------------------------------------------------------------
+# test basis_get_glob_timestamps()
+basis_get_glob_timestamps (DIRECTORIES TIMESTAMPS "${SRC_DIR}/foo/**.cxx")
+if (NOT CMAKE_VERSION VERSION_LESS 3.3)
+  list (SORT DIRECTORIES)
+  set (EXPECTED "${SRC_DIR}/foo" "${SRC_DIR}/foo/sub")
+  if (NOT "${DIRECTORIES}" STREQUAL "${EXPECTED}")
+    message (FATAL_ERROR "basis_get_glob_timestamps():\n\texpected: \"${EXPECTED}\"\n\tactual:   \"${DIRECTORIES}\"")
+  endif ()
+endif ()
+list (LENGTH DIRECTORIES N)
+list (LENGTH TIMESTAMPS  M)
+if (NOT N EQUAL M)
+  message (FATAL_ERROR "basis_get_glob_timestamps(): Expected one timestamp per directory")
+endif ()
+
+basis_get_glob_timestamps (DIRECTORIES TIMESTAMPS "${SRC_DIR}/bar/*.cxx" "${SRC_DIR}/bar/d.cxx")
+if (NOT "${DIRECTORIES}" STREQUAL "${SRC_DIR}/bar")
+  message (FATAL_ERROR "basis_get_glob_timestamps(): Expected only directory ${SRC_DIR}/bar, got \"${DIRECTORIES}\"")
+endif ()
+
+# ----------------------------------------------------------------------------
+# test glob.cmake
+set (GLOB_FILES)
+foreach (NAME foo bar)
+  if (NAME STREQUAL "foo")
+    set (EXPRESSIONS "${SRC_DIR}/foo/**.cxx")
+  else ()
+    set (EXPRESSIONS "${SRC_DIR}/bar/*.cxx")
+  endif ()
+  basis_get_glob_timestamps (DIRECTORIES TIMESTAMPS ${EXPRESSIONS})
+  basis_glob_source_files (INITIAL_SOURCES ${EXPRESSIONS})
+  basis_write_list ("${ROOT}/${NAME}.dir/sources.txt" INITIAL_SOURCES ${INITIAL_SOURCES})
+  basis_write_glob_file ("${ROOT}/${NAME}.dir/glob.txt" ${NAME} "${EXPRESSIONS}" "${DIRECTORIES}" "${TIMESTAMPS}")
+  list (APPEND GLOB_FILES "${ROOT}/${NAME}.dir/glob.txt")
+endforeach ()
+basis_write_list ("${MANIFEST}" GLOB_FILES ${GLOB_FILES})
+
+run_glob_check (TRUE)
+# files not matching the globbing expressions
+file (WRITE "${SRC_DIR}/foo/sub/README" "")
+file (WRITE "${SRC_DIR}/foo/.hidden.cxx" "")
+run_glob_check (TRUE)
+# added source file
+file (WRITE "${SRC_DIR}/foo/sub/e.cxx" "")
+run_glob_check (FALSE)
+# removed source file
+file (REMOVE "${SRC_DIR}/foo/sub/e.cxx")
+run_glob_check (TRUE)
+file (REMOVE "${SRC_DIR}/foo/a.cxx")
+run_glob_check (FALSE)
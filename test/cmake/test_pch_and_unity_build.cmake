@@ -0,0 +1,58 @@
+##############################################################################
+# @file  test_pch_and_unity_build.cmake
+# @brief Test precompiled header and unity build options of C++ targets.
+##############################################################################
+
+cmake_minimum_required (VERSION 3.16 FATAL_ERROR)
+
+find_package (BASIS REQUIRED)
+basis_use_package (BASIS)
+include ("${BASIS_MODULE_PATH}/BasisTest.cmake")
+
+set (PROJECT_TESTING_DIR "${CMAKE_CURRENT_SOURCE_DIR}")
+set (TESTING_OUTPUT_DIR  "${CMAKE_CURRENT_BINARY_DIR}")
+set (TESTING_RUNTIME_DIR "${CMAKE_CURRENT_BINARY_DIR}/bin")
+
+set (BASIS_UNITY_BUILD             ON)
+set (BASIS_UNITY_BUILD_BATCH_SIZE  4)
+set (BASIS_PRECOMPILE_TEST_HEADERS ON)
+
+function (assert_target_property TARGET PROPERTY EXPECTED_VALUE)
+  message ("assert_target_property(${TARGET} ${PROPERTY} '${EXPECTED_VALUE}')")
+  basis_get_target_uid (TARGET_UID "${TARGET}")
+  get_target_property (ACTUAL_VALUE ${TARGET_UID} ${PROPERTY})
+  if (NOT "^${ACTUAL_VALUE}$" STREQUAL "^${EXPECTED_VALUE}$")
+    message (FATAL_ERROR "Property ${PROPERTY} of ${TARGET}:\n\texpected: \"${EXPECTED_VALUE}\"\n\tactual:  \"${ACTUAL_VALUE}\"\n")
+  endif ()
+endfunction ()
+
+# unity build of executables is enabled by BASIS_UNITY_BUILD
+basis_add_executable (foo "${INPUT_DIR}/dummy_command.cxx" NO_BASIS_UTILITIES)
+assert_target_property (foo UNITY_BUILD ON)
+assert_target_property (foo UNITY_BUILD_BATCH_SIZE 4)
+assert_target_property (foo PRECOMPILE_HEADERS ACTUAL_VALUE-NOTFOUND)
+
+basis_add_executable (bar "${INPUT_DIR}/dummy_command.cxx" NO_BASIS_UTILITIES
+                      NO_UNITY_BUILD PRECOMPILE_HEADERS "<vector>")
+assert_target_property (bar UNITY_BUILD OFF)
+assert_target_property (bar PRECOMPILE_HEADERS "<vector>")
+
+# unit tests reuse the header precompiled once by BASIS_PRECOMPILE_TEST_HEADERS
+basis_add_test (unit_a SOURCES "${INPUT_DIR}/dummy_command.cxx" UNITTEST NO_DEFAULT_MAIN)
+basis_add_test (unit_b SOURCES "${INPUT_DIR}/dummy_command.cxx" UNITTEST NO_DEFAULT_MAIN)
+basis_get_target_uid (PCH_UID precompiled_test_headers)
+if (NOT TARGET "${PCH_UID}")
+  message (FATAL_ERROR "Target ${PCH_UID} which precompiles the test header not added!")
+endif ()
+assert_target_property (precompiled_test_headers PRECOMPILE_HEADERS "<basis/test.h>")
+assert_target_property (unit_a UNITY_BUILD ON)
+assert_target_property (unit_a PRECOMPILE_HEADERS_REUSE_FROM "${PCH_UID}")
+assert_target_property (unit_b PRECOMPILE_HEADERS_REUSE_FROM "${PCH_UID}")
+assert_target_property (unit_b PRECOMPILE_HEADERS ACTUAL_VALUE-NOTFOUND)
+
+basis_add_test (unit_c SOURCES "${INPUT_DIR}/dummy_command.cxx" UNITTEST NO_DEFAULT_MAIN NO_PRECOMPILE_HEADERS)
+assert_target_property (unit_c PRECOMPILE_HEADERS_REUSE_FROM ACTUAL_VALUE-NOTFOUND)
+
+basis_add_test (unit_d SOURCES "${INPUT_DIR}/dummy_command.cxx" UNITTEST NO_DEFAULT_MAIN PRECOMPILE_HEADERS "<map>")
+assert_target_property (unit_d PRECOMPILE_HEADERS_REUSE_FROM ACTUAL_VALUE-NOTFOUND)
+assert_target_property (unit_d PRECOMPILE_HEADERS "<map>")
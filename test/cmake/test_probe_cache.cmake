@@ -0,0 +1,55 @@
+##############################################################################
+# @file  test_probe_cache.cmake
+# @brief Test basis_get_probe_cache() and basis_set_probe_cache().
+##############################################################################
+
+# ----------------------------------------------------------------------------
+# include modules
+include ("${MODULE_PATH}/CommonTools.cmake")
+include ("${MODULE_PATH}/InterpTools.cmake")
+
+# ----------------------------------------------------------------------------
+# settings
+set (ROOT                  "${OUTPUT_DIR}/test_probe_cache/tree")
+set (BASIS_PROBE_CACHE_DIR "${ROOT}/cache")
+set (EXECUTABLE            "${ROOT}/bin/tool")
+
+file (REMOVE_RECURSE "${ROOT}")
+file (WRITE "${EXECUTABLE}" "version 1\n")
+
+# ----------------------------------------------------------------------------
+# cache result of probe
+basis_get_probe_cache (VALUE tool_version "${EXECUTABLE}")
+if (NOT VALUE STREQUAL "")
+  message (FATAL_ERROR "Unexpected cached value before first probe: ${VALUE}")
+endif ()
+basis_set_probe_cache (tool_version "${EXECUTABLE}" "1.0")
+basis_get_probe_cache (VALUE tool_version "${EXECUTABLE}")
+if (NOT VALUE STREQUAL "1.0")
+  message (FATAL_ERROR "Expected cached value 1.0, got: ${VALUE}")
+endif ()
+basis_get_probe_cache (VALUE other_probe "${EXECUTABLE}")
+if (NOT VALUE STREQUAL "")
+  message (FATAL_ERROR "Unexpected cached value of other probe: ${VALUE}")
+endif ()
+
+# ----------------------------------------------------------------------------
+# cached result is ignored after the executable was modified
+if (CMAKE_VERSION VERSION_LESS 3.14)
+  execute_process (COMMAND "${CMAKE_COMMAND}" -E sleep 1.1)
+endif ()
+file (WRITE "${EXECUTABLE}" "version 2.0\n")
+basis_get_probe_cache (VALUE tool_version "${EXECUTABLE}")
+if (NOT VALUE STREQUAL "")
+  message (FATAL_ERROR "Cached value not invalidated by modification of executable: ${VALUE}")
+endif ()
+
+# ----------------------------------------------------------------------------
+# interpreter version is read from cache instead of executing interpreter
+set (PERL_EXECUTABLE "${EXECUTABLE}")
+basis_set_probe_cache (perl_version "${PERL_EXECUTABLE}" "5.36.1")
+basis_get_perl_version ()
+if (NOT PERL_VERSION_STRING STREQUAL "5.36.1" OR NOT PERL_VERSION_MAJOR EQUAL 5
+    OR NOT PERL_VERSION_MINOR EQUAL 36 OR NOT PERL_VERSION_PATCH EQUAL 1)
+  message (FATAL_ERROR "Perl version not read from cache: ${PERL_VERSION_STRING}")
+endif ()
@@ -0,0 +1,58 @@
+##############################################################################
+# @file  test_profile.cmake
+# @brief Test functions of ProfileTools.cmake module.
+##############################################################################
+
+# ----------------------------------------------------------------------------
+# include modules
+set (BASIS_PROFILE_CONFIGURE ON)
+include ("${MODULE_PATH}/ProfileTools.cmake")
+if (NOT BASIS_PROFILE_CONFIGURE)
+  return () # CMake version too old
+endif ()
+
+set (CMAKE_BINARY_DIR "${OUTPUT_DIR}/test_profile/tree")
+file (REMOVE_RECURSE "${CMAKE_BINARY_DIR}")
+
+# ----------------------------------------------------------------------------
+# record nested calls
+basis_profile_begin (outer "a;b")
+basis_profile_begin (inner)
+execute_process (
+  COMMAND "${CMAKE_COMMAND}" -E echo "\\\"x\\\" y"
+  RESULT_VARIABLE RETVAL
+  OUTPUT_VARIABLE OUTPUT
+  OUTPUT_STRIP_TRAILING_WHITESPACE
+)
+basis_profile_end (inner "\"quoted\"")
+basis_profile_end (outer)
+
+if (NOT RETVAL EQUAL 0 OR NOT OUTPUT STREQUAL "\\\"x\\\" y")
+  message (FATAL_ERROR "execute_process(): RETVAL=${RETVAL}, OUTPUT=${OUTPUT}")
+endif ()
+
+# ----------------------------------------------------------------------------
+# write report
+basis_profile_report ()
+
+foreach (EXT IN ITEMS json txt)
+  if (NOT EXISTS "${CMAKE_BINARY_DIR}/BasisConfigureProfile.${EXT}")
+    message (FATAL_ERROR "Missing BasisConfigureProfile.${EXT}")
+  endif ()
+endforeach ()
+file (READ "${CMAKE_BINARY_DIR}/BasisConfigureProfile.json" JSON)
+foreach (EXPECTED IN ITEMS
+    "\"name\": \"outer\""
+    "\"detail\": \"a b\""
+    "\"name\": \"inner\""
+    "\"detail\": \"\\\"quoted\\\"\""
+)
+  string (FIND "${JSON}" "${EXPECTED}" IDX)
+  if (IDX EQUAL -1)
+    message (FATAL_ERROR "Trace does not contain ${EXPECTED}:\n${JSON}")
+  endif ()
+endforeach ()
+string (FIND "${JSON}" "\"name\": \"execute_process\"" IDX)
+if (IDX EQUAL -1)
+  message (FATAL_ERROR "Trace does not contain execute_process() call:\n${JSON}")
+endif ()
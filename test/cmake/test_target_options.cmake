@@ -0,0 +1,34 @@
+##############################################################################
+# @file  test_target_options.cmake
+# @brief Test removal of C++ only options of basis_add_executable/library().
+##############################################################################
+
+# ----------------------------------------------------------------------------
+# include modules
+include ("${MODULE_PATH}/CommonTools.cmake")
+include ("${MODULE_PATH}/TargetTools.cmake")
+
+# ----------------------------------------------------------------------------
+# options are removed by position, not by value
+set (ARGN_PRECOMPILE_HEADERS     "common.h;util.h")
+set (ARGN_UNITY_BUILD_BATCH_SIZE 4)
+_basis_target_remove_pch_and_unity_build_options (
+  ARGS
+    util.h main.py 4
+    PRECOMPILE_HEADERS common.h util.h
+    UNITY_BUILD_BATCH_SIZE 4
+    NO_UNITY_BUILD
+    LANGUAGE PYTHON
+)
+set (EXPECTED "util.h;main.py;4;LANGUAGE;PYTHON")
+if (NOT "${ARGS}" STREQUAL "${EXPECTED}")
+  message (FATAL_ERROR "Expected remaining arguments ${EXPECTED}, got: ${ARGS}")
+endif ()
+
+# arguments without these options are unchanged
+set (ARGN_PRECOMPILE_HEADERS)
+set (ARGN_UNITY_BUILD_BATCH_SIZE)
+_basis_target_remove_pch_and_unity_build_options (ARGS main.sh LIBEXEC)
+if (NOT "${ARGS}" STREQUAL "main.sh;LIBEXEC")
+  message (FATAL_ERROR "Expected remaining arguments main.sh;LIBEXEC, got: ${ARGS}")
+endif ()
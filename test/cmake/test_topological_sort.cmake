@@ -0,0 +1,54 @@
+##############################################################################
+# @file  test_topological_sort.cmake
+# @brief Test functions of TopologicalSort.cmake module.
+##############################################################################
+
+# ----------------------------------------------------------------------------
+# include modules
+include ("${MODULE_PATH}/TopologicalSort.cmake")
+
+# ----------------------------------------------------------------------------
+# auxiliary functions
+function (assert_list_equal NAME ACTUAL EXPECTED)
+  if (NOT "^${ACTUAL}$" STREQUAL "^${EXPECTED}$")
+    message (FATAL_ERROR "${NAME}:\n\texpected: [${EXPECTED}]\n\tactual:   [${ACTUAL}]")
+  endif ()
+endfunction ()
+
+# ----------------------------------------------------------------------------
+# example of documentation
+set (MY_a_EDGES b)
+set (MY_b_EDGES)
+set (MY_c_EDGES a b)
+
+set (L a b c)
+topological_sort (L "MY_" "_EDGES")
+assert_list_equal ("topological_sort" "${L}" "b;a;c")
+
+set (L a b c)
+topological_levels (L "MY_" "_EDGES" LEVELS)
+assert_list_equal ("topological_levels" "${L}" "b;a;c")
+assert_list_equal ("number of levels" "${LEVELS}" "3")
+assert_list_equal ("level 0" "${LEVELS_0}" "b")
+assert_list_equal ("level 1" "${LEVELS_1}" "a")
+assert_list_equal ("level 2" "${LEVELS_2}" "c")
+
+# ----------------------------------------------------------------------------
+# independent elements share a level, elements not in list are skipped
+#
+#   d -> x -> e, f -> e, g
+set (MY_d_EDGES x)
+set (MY_x_EDGES e)
+set (MY_f_EDGES e)
+
+set (L d e f g)
+topological_levels (L "MY_" "_EDGES" LEVELS)
+assert_list_equal ("number of levels" "${LEVELS}" "2")
+assert_list_equal ("level 0" "${LEVELS_0}" "e;g")
+assert_list_equal ("level 1" "${LEVELS_1}" "d;f")
+assert_list_equal ("topological_levels" "${L}" "e;g;d;f")
+
+set (L)
+topological_levels (L "MY_" "_EDGES" LEVELS)
+assert_list_equal ("number of levels" "${LEVELS}" "0")
+assert_list_equal ("empty list" "${L}" "")
@@ -3,9 +3,10 @@
  * @brief Dummy executable used to test Subprocess module.
  */
 
-#include <iostream> // cout, endl
+#include <iostream> // cin, cout, endl
 #include <cstdlib>  // exit, atoi
 #include <cstring>  // strcmp
+#include <string>
 
 #include <basis/config.h>
 
@@ -32,6 +33,11 @@ int main(int argc, char *argv[])
             cout << "Hello, BASIS!" << endl;
         } else if (strcmp(argv[i], "--warn") == 0) {
             cerr << "WARNING: Cannot greet in other languages!" << endl;
+        } else if (strcmp(argv[i], "--warn-bytes") == 0) {
+            const string warning(atoi(argv[++i]), 'W');
+            cerr << warning << flush;
+        } else if (strcmp(argv[i], "--cat") == 0) {
+            cout << cin.rdbuf();
         } else if (strcmp(argv[i], "--exit") == 0) {
             exit(atoi(argv[++i]));
         }
@@ -0,0 +1,34 @@
+/**
+ * @file  print_args.cxx
+ * @brief Executable which prints its arguments parsed by basis::CmdLine.
+ *
+ * Used to test the passing of arguments in a response file by execute().
+ */
+
+#include <iostream>      // cout, cerr, endl
+#include <basis/basis.h> // CmdLine, PositionalArgs
+
+
+using namespace std;
+using namespace basis;
+
+
+int main(int argc, char* argv[])
+{
+    PositionalArgs args("args", "Arguments to print, one per line.", false, "<arg>");
+    try {
+        CmdLine cmd("print_args", PROJECT, "Prints the parsed arguments.", "", RELEASE);
+        cmd.add(args);
+        cmd.parse(argc, argv);
+    } catch (CmdLineException& e) {
+        cerr << e.error() << endl;
+        return 1;
+    }
+    const vector<string>& values = args.getValue();
+    cout << values.size() << '\n';
+    for (vector<string>::const_iterator it = values.begin(); it != values.end(); ++it) {
+        cout << *it << '\n';
+    }
+    cout.flush();
+    return 0;
+}
@@ -0,0 +1,298 @@
+/**
+ * @file  benchmark_utilities.cxx
+ * @brief Benchmarks of the C++ utilities.
+ *
+ * The results are written to the file benchmark_utilities.json in the
+ * testing output directory. A copy of this file can be given as baseline
+ * to detect performance regressions, i.e.,
+ * @code
+ * benchmark_utilities --benchmark_baseline=benchmark_utilities.json
+ * @endcode
+ */
+
+
+#include <cstdio>  // fwrite()
+#include <cstdlib> // atol()
+#include <cstring> // strcmp()
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
+#include <vector>
+
+#include <basis/benchmark.h> // benchmark framework
+#include <basis/os.h>        // benchmarked os functions
+#include <basis/os/path.h>   // benchmarked path functions
+#include <basis/subprocess.h>
+#include <basis/CmdLine.h>
+
+
+using namespace basis;
+using namespace std;
+
+
+// ===========================================================================
+// os::path
+// ===========================================================================
+
+// ---------------------------------------------------------------------------
+/// Synthetic paths with many levels and redundant components.
+class DeepPath : public benchmark::Benchmark
+{
+protected:
+
+    virtual void SetUp()
+    {
+        ostringstream a, b;
+        a << "/root";
+        b << "/root";
+        for (int i = 0; i < 64; i++) {
+            a << "/dir" << i << (i % 4 == 0 ? "/./" : "/") << (i % 8 == 0 ? "tmp/.." : "sub");
+            b << "/dir" << i << "/" << (i < 32 ? "sub" : "other");
+        }
+        path  = a.str();
+        other = os::path::normpath(b.str());
+    }
+
+    string path;
+    string other;
+};
+
+// ---------------------------------------------------------------------------
+BENCHMARK_F (DeepPath, normpath)
+{
+    benchmark::keep(os::path::normpath(path));
+}
+
+// ---------------------------------------------------------------------------
+BENCHMARK_F (DeepPath, relpath)
+{
+    benchmark::keep(os::path::relpath(path, other));
+}
+
+// ---------------------------------------------------------------------------
+/// Existing directory tree with many levels.
+class DeepTree : public benchmark::Benchmark
+{
+protected:
+
+    virtual void SetUp()
+    {
+        root = os::path::join(os::getcwd(), "deeptree");
+        string dir = root;
+        for (int i = 0; i < 32; i++) dir = os::path::join(dir, "d");
+        os::makedirs(dir);
+        path = os::path::join(dir, "../../d/./../../d/d");
+    }
+
+    virtual void TearDown()
+    {
+        os::rmtree(root);
+    }
+
+    string root;
+    string path;
+};
+
+// ---------------------------------------------------------------------------
+BENCHMARK_F (DeepTree, realpath)
+{
+    benchmark::keep(os::path::realpath(path));
+}
+
+// ===========================================================================
+// os::emptydir
+// ===========================================================================
+
+// ---------------------------------------------------------------------------
+/// Directory which is filled by each iteration before it is emptied.
+///
+/// Note that the measured time includes the creation of the files and
+/// directories, which is in the order of the time needed to remove them.
+class Tree : public benchmark::Benchmark
+{
+protected:
+
+    virtual void SetUp()
+    {
+        root = os::path::join(os::getcwd(), "tree");
+        os::makedirs(root);
+    }
+
+    virtual void TearDown()
+    {
+        os::rmtree(root);
+    }
+
+    void CreateFiles(const string& dir, int n)
+    {
+        for (int i = 0; i < n; i++) {
+            ostringstream name;
+            name << "file" << i;
+            ofstream(os::path::join(dir, name.str()).c_str()) << i;
+        }
+    }
+
+    string root;
+};
+
+// ---------------------------------------------------------------------------
+BENCHMARK_F (Tree, emptydir_wide)
+{
+    for (int i = 0; i < 10; i++) {
+        ostringstream name;
+        name << "dir" << i;
+        const string dir = os::path::join(root, name.str());
+        os::mkdir(dir);
+        CreateFiles(dir, 20);
+    }
+    CreateFiles(root, 50);
+    if (!os::emptydir(root)) throw runtime_error("Failed to empty directory " + root);
+}
+
+// ---------------------------------------------------------------------------
+BENCHMARK_F (Tree, emptydir_deep)
+{
+    string dir = root;
+    for (int i = 0; i < 20; i++) {
+        dir = os::path::join(dir, "d");
+        os::mkdir(dir);
+        CreateFiles(dir, 2);
+    }
+    if (!os::emptydir(root)) throw runtime_error("Failed to empty directory " + root);
+}
+
+// ===========================================================================
+// Subprocess
+// ===========================================================================
+
+// ---------------------------------------------------------------------------
+/// Long command-line with quoted arguments.
+class LongCommandLine : public benchmark::Benchmark
+{
+protected:
+
+    virtual void SetUp()
+    {
+        for (int i = 0; i < 1000; i++) {
+            ostringstream arg;
+            switch (i % 4) {
+                case 0: arg << "--option" << i; break;
+                case 1: arg << "/path/with spaces/file" << i << ".txt"; break;
+                case 2: arg << "say \"" << i << "\""; break;
+                case 3: arg << "C:\\dir\\" << i << "\\"; break;
+            }
+            args.push_back(arg.str());
+        }
+        cmd = Subprocess::tostring(args);
+    }
+
+    Subprocess::CommandLine args;
+    string                  cmd;
+};
+
+// ---------------------------------------------------------------------------
+BENCHMARK_F (LongCommandLine, split)
+{
+    benchmark::keep(Subprocess::split(cmd));
+}
+
+// ---------------------------------------------------------------------------
+BENCHMARK_F (LongCommandLine, tostring)
+{
+    benchmark::keep(Subprocess::tostring(args));
+}
+
+// ---------------------------------------------------------------------------
+/// Run this executable as subprocess which writes to its stdout.
+static void communicate(const char* nbytes)
+{
+    Subprocess::CommandLine cmd;
+    cmd.push_back(os::exepath());
+    cmd.push_back("--write");
+    cmd.push_back(nbytes);
+    Subprocess p;
+    if (!p.popen(cmd, Subprocess::RM_NONE, Subprocess::RM_PIPE, Subprocess::RM_NONE)) {
+        throw runtime_error("Failed to run " + Subprocess::tostring(cmd));
+    }
+    ostringstream out;
+    p.communicate(out);
+    if (p.returncode() != 0 || out.str().size() != static_cast<size_t>(atol(nbytes))) {
+        throw runtime_error("Subprocess " + Subprocess::tostring(cmd) + " failed");
+    }
+}
+
+// ---------------------------------------------------------------------------
+BENCHMARK (Subprocess, spawn)
+{
+    communicate("0");
+}
+
+// ---------------------------------------------------------------------------
+BENCHMARK (Subprocess, communicate_4MiB)
+{
+    communicate("4194304");
+}
+
+// ===========================================================================
+// CmdLine
+// ===========================================================================
+
+// ---------------------------------------------------------------------------
+/// Command-line with many options.
+class ManyOptions : public benchmark::Benchmark
+{
+protected:
+
+    virtual void SetUp()
+    {
+        cmd = new CmdLine("benchmark", "", "Benchmark of command-line parsing.", "", "1.0");
+        cmd->setExceptionHandling(false);
+        args.push_back("benchmark");
+        for (int i = 0; i < 100; i++) {
+            ostringstream name, value;
+            name  << "option" << i;
+            value << i;
+            options.push_back(new IntArg("", name.str(), "Option.", false, 0, "<int>"));
+            cmd->add(options.back());
+            args.push_back("--" + name.str());
+            args.push_back(value.str());
+        }
+    }
+
+    virtual void TearDown()
+    {
+        delete cmd;
+        for (size_t i = 0; i < options.size(); i++) delete options[i];
+    }
+
+    CmdLine*         cmd;
+    vector<IntArg*>  options;
+    vector<string>   args;
+};
+
+// ---------------------------------------------------------------------------
+BENCHMARK_F (ManyOptions, parse)
+{
+    vector<string> argv(args);
+    cmd->reset();
+    cmd->parse(argv);
+}
+
+// ===========================================================================
+// main
+// ===========================================================================
+
+// ---------------------------------------------------------------------------
+int main(int argc, char* argv[])
+{
+    // subprocess of Subprocess benchmarks which writes the given number of bytes
+    if (argc == 3 && strcmp(argv[1], "--write") == 0) {
+        const vector<char> buffer(65536, 'x');
+        for (long n = atol(argv[2]); n > 0; n -= static_cast<long>(buffer.size())) {
+            const size_t m = (n < static_cast<long>(buffer.size()) ? static_cast<size_t>(n) : buffer.size());
+            if (fwrite(&buffer[0], 1, m, stdout) != m) return 1;
+        }
+        return 0;
+    }
+    return benchmark::run(argc, argv);
+}
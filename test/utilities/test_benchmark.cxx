@@ -0,0 +1,42 @@
+/**
+ * @file  test_benchmark.cxx
+ * @brief Test of benchmark.cxx module.
+ */
+
+
+#include <numeric>
+#include <vector>
+
+#include <basis/benchmark.h> // testee
+
+
+using namespace std;
+
+
+// ---------------------------------------------------------------------------
+BENCHMARK (Benchmark, loop)
+{
+    int sum = 0;
+    for (int i = 0; i < 100; i++) sum += i;
+    basis::benchmark::keep(sum);
+}
+
+// ---------------------------------------------------------------------------
+class Vector : public basis::benchmark::Benchmark
+{
+protected:
+
+    virtual void SetUp()
+    {
+        values.resize(1000);
+        for (size_t i = 0; i < values.size(); i++) values[i] = static_cast<double>(i);
+    }
+
+    vector<double> values;
+};
+
+// ---------------------------------------------------------------------------
+BENCHMARK_F (Vector, accumulate)
+{
+    basis::benchmark::keep(accumulate(values.begin(), values.end(), 0.0));
+}
@@ -0,0 +1,290 @@
+/**
+ * @file  test_cmdline.cxx
+ * @brief Test of CmdLine.cxx module.
+ */
+
+
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <sstream>
+#include <limits>
+
+#include <basis/test.h>    // unit testing framework
+#include <basis/CmdLine.h> // testee
+
+
+using namespace basis;
+using namespace std;
+
+
+// ===========================================================================
+// helpers
+// ===========================================================================
+
+// ---------------------------------------------------------------------------
+// Extract value using operator>> as done before numbers were parsed directly.
+template <typename T>
+string legacy_extract(T& value, const string& str)
+{
+    istringstream is(str);
+    int n = 0;
+    while (is.good()) {
+        if (is.peek() != EOF) is >> value;
+        else break;
+        n++;
+    }
+    if (is.fail()) return "Couldn't read argument value from string '" + str + "'";
+    if (n > 1)     return "More than one valid value parsed from string '" + str + "'";
+    return "";
+}
+
+// ---------------------------------------------------------------------------
+template <typename T>
+string extract(T& value, const string& str)
+{
+    try {
+        TCLAP::ExtractValue(value, str, TCLAP::ValueLike());
+    } catch (TCLAP::ArgParseException& e) {
+        return e.error();
+    }
+    return "";
+}
+
+// ---------------------------------------------------------------------------
+template <typename T>
+void expect_same_as_legacy(const string& str)
+{
+    T expected = T(7), actual = T(7);
+    string expected_error = legacy_extract(expected, str);
+    string actual_error   = extract(actual, str);
+    EXPECT_EQ(expected_error, actual_error) << "String: '" << str << "'";
+    if (expected_error.empty()) {
+        EXPECT_EQ(expected, actual) << "String: '" << str << "'";
+    }
+}
+
+// ---------------------------------------------------------------------------
+static const char* numbers[] = {
+    "0", "1", "-1", "+1", "42", "007", "-0", "+", "-", "", " ", " 1", "1 ", "1 2",
+    "1x", "x1", "0x10", "1.", ".5", "-.5", "1.5", "1.5.3", "1e3", "1E-3", "1e",
+    "1e+", "-1.25e+2", "e3", ".", "inf", "nan", "-inf", "0x1p3", "1,5",
+    "32767", "32768", "-32768", "-32769", "65535", "65536",
+    "2147483647", "2147483648", "-2147483648", "-2147483649", "4294967295", "4294967296",
+    "9223372036854775807", "9223372036854775808", "-9223372036854775808",
+    "18446744073709551615", "18446744073709551616",
+    "1e38", "1e39", "1e308", "1e309", "-1e309", "1e-320", "1e-400",
+    "3.4028235e38", "0.1", "0.30000000000000004", "123456789012345678901234567890"
+};
+
+// ---------------------------------------------------------------------------
+// Write response file to current working directory.
+static void write_rspfile(const char* fname, const char* contents)
+{
+    ofstream ofs(fname, ios::out | ios::binary | ios::trunc);
+    ofs << contents;
+}
+
+// ===========================================================================
+// tests
+// ===========================================================================
+
+// ---------------------------------------------------------------------------
+TEST(ExtractValue, SameAsOperatorIn)
+{
+    for (size_t i = 0; i < sizeof(numbers) / sizeof(numbers[0]); i++) {
+        expect_same_as_legacy<short>         (numbers[i]);
+        expect_same_as_legacy<int>           (numbers[i]);
+        expect_same_as_legacy<long>          (numbers[i]);
+        expect_same_as_legacy<unsigned short>(numbers[i]);
+        expect_same_as_legacy<unsigned int>  (numbers[i]);
+        expect_same_as_legacy<unsigned long> (numbers[i]);
+        expect_same_as_legacy<float>         (numbers[i]);
+        expect_same_as_legacy<double>        (numbers[i]);
+    }
+}
+
+// ---------------------------------------------------------------------------
+TEST(ExtractValue, RandomDoubles)
+{
+    srand(42);
+    for (int i = 0; i < 10000; i++) {
+        ostringstream oss;
+        oss.precision(1 + rand() % 17);
+        if (rand() % 2) oss << scientific;
+        oss << (rand() - RAND_MAX / 2) / static_cast<double>(1 + rand() % 1000);
+        expect_same_as_legacy<double>(oss.str());
+        expect_same_as_legacy<float> (oss.str());
+    }
+}
+
+// ---------------------------------------------------------------------------
+TEST(CmdLine, DelimitedValue)
+{
+    CmdLine cmd("test", "", "Test of argument value delimiter.", "", "");
+    DoubleArg    value("v", "value",  "Value.", false, 0.0, "<float>");
+    MultiIntArg  values("", "values", "Values.", false, "<int>");
+    cmd.add(value);
+    cmd.add(values);
+    vector<string> args;
+    args.push_back("test");
+    args.push_back("--value 1.5");
+    args.push_back("--values");
+    args.push_back("1");
+    args.push_back("--values 2");
+    cmd.parse(args);
+    EXPECT_EQ(1.5, value.getValue());
+    ASSERT_EQ(2u, values.getValue().size());
+    EXPECT_EQ(1, values.getValue()[0]);
+    EXPECT_EQ(2, values.getValue()[1]);
+}
+
+// ---------------------------------------------------------------------------
+TEST(CmdLine, ListArg)
+{
+    CmdLine cmd("test", "", "Test of list argument.", "", "");
+    ListDoubleArg points("p", "points", "Points.", false, "<x,y,z>", 3, 6);
+    ListIntArg    labels("", "labels", "Labels.", false, "<int>");
+    cmd.add(points);
+    cmd.add(labels);
+    vector<string> args;
+    args.push_back("test");
+    args.push_back("--points");
+    args.push_back("1,2.5,-3");
+    args.push_back("-p");
+    args.push_back(" 4 , 5  6 ");
+    args.push_back("--labels");
+    args.push_back("");
+    cmd.parse(args);
+    EXPECT_TRUE(labels.getValue().empty());
+    vector<double> values;
+    values.push_back(42.0);
+    points.moveValue(values);
+    EXPECT_TRUE(points.getValue().empty());
+    ASSERT_EQ(6u, values.size());
+    EXPECT_EQ( 1.0, values[0]);
+    EXPECT_EQ( 2.5, values[1]);
+    EXPECT_EQ(-3.0, values[2]);
+    EXPECT_EQ( 4.0, values[3]);
+    EXPECT_EQ( 5.0, values[4]);
+    EXPECT_EQ( 6.0, values[5]);
+}
+
+// ---------------------------------------------------------------------------
+TEST(CmdLine, ListArgErrors)
+{
+    const char* lists[] = { "1,2", "1,2,3,4", "1,,2,3", "1,2,3,", ",1,2,3", "1,x,3" };
+    for (size_t i = 0; i < sizeof(lists) / sizeof(lists[0]); i++) {
+        CmdLine cmd("test", "", "Test of list argument.", "", "");
+        cmd.setExceptionHandling(false);
+        ListDoubleArg points("p", "points", "Points.", false, "<x,y,z>", 3);
+        cmd.add(points);
+        vector<string> args;
+        args.push_back("test");
+        args.push_back("--points");
+        args.push_back(lists[i]);
+        EXPECT_THROW(cmd.parse(args), TCLAP::ArgException) << "List: '" << lists[i] << "'";
+    }
+}
+
+// ---------------------------------------------------------------------------
+TEST(CmdLine, Serialize)
+{
+    CmdLine cmd("test", "proj", "Test of \"schema\" export.", "", "1.0");
+    DoubleArg      value ("v", "value", "Value <v>.", true, 0.0, "<float>");
+    SwitchArg      flag  ("f", "flag",  "Flag.", false);
+    PositionalArg  input ("input", "Input & file.", true, "", "<file>");
+    cmd.add(value);
+    cmd.add(flag);
+    cmd.add(input);
+    ostringstream xml;
+    cmd.serialize(xml, CmdLine::SCHEMA_XML);
+    EXPECT_NE(string::npos, xml.str().find("<name>test</name>"));
+    EXPECT_NE(string::npos, xml.str().find("name=\"value\""));
+    EXPECT_NE(string::npos, xml.str().find("Value &lt;v&gt;."));
+    EXPECT_NE(string::npos, xml.str().find("Input &amp; file."));
+    ostringstream json;
+    cmd.serialize(json, CmdLine::SCHEMA_JSON);
+    EXPECT_NE(string::npos, json.str().find("\"description\": \"Test of \\\"schema\\\" export.\""));
+    EXPECT_NE(string::npos, json.str().find("\"name\": \"flag\""));
+    EXPECT_NE(string::npos, json.str().find("\"kind\": \"positional\""));
+    // no exit and arguments can still be parsed afterwards
+    vector<string> args;
+    args.push_back("test");
+    args.push_back("-v");
+    args.push_back("2");
+    args.push_back("in.nii");
+    cmd.parse(args);
+    EXPECT_EQ(2.0, value.getValue());
+    EXPECT_EQ("in.nii", input.getValue());
+}
+
+// ---------------------------------------------------------------------------
+TEST(CmdLine, NestedResponseFiles)
+{
+    write_rspfile("test_cmdline-outer.rsp", "--value 1.5\n@test_cmdline-inner.rsp last\n");
+    write_rspfile("test_cmdline-inner.rsp", "first\n--flag\n");
+    CmdLine cmd("test", "", "Test of nested response files.", "", "");
+    DoubleArg      value("v", "value", "Value.", false, 0.0, "<float>");
+    SwitchArg      flag ("f", "flag",  "Flag.", false);
+    PositionalArgs input("input", "Inputs.", false, "<file>");
+    cmd.add(value);
+    cmd.add(flag);
+    cmd.add(input);
+    vector<string> args;
+    args.push_back("test");
+    args.push_back("@test_cmdline-outer.rsp");
+    cmd.parse(args);
+    remove("test_cmdline-outer.rsp");
+    remove("test_cmdline-inner.rsp");
+    EXPECT_EQ(1.5, value.getValue());
+    EXPECT_TRUE(flag.getValue());
+    ASSERT_EQ(2u, input.getValue().size());
+    EXPECT_EQ("first", input.getValue()[0]);
+    EXPECT_EQ("last",  input.getValue()[1]);
+}
+
+// ---------------------------------------------------------------------------
+TEST(CmdLine, ResponseFileIgnoreRest)
+{
+    write_rspfile("test_cmdline-rest.rsp", "a -- @b\n");
+    CmdLine cmd("test", "", "Test of response files followed by \"--\".", "", "");
+    PositionalArgs input("input", "Inputs.", false, "<arg>");
+    cmd.add(input);
+    vector<string> args;
+    args.push_back("test");
+    args.push_back("@test_cmdline-rest.rsp");
+    args.push_back("@test_cmdline-rest.rsp");
+    args.push_back("--");
+    args.push_back("@c");
+    cmd.parse(args);
+    remove("test_cmdline-rest.rsp");
+    // arguments following "--" in the file or on the command-line are kept
+    ASSERT_EQ(5u, input.getValue().size());
+    EXPECT_EQ("a",                       input.getValue()[0]);
+    EXPECT_EQ("@b",                      input.getValue()[1]);
+    EXPECT_EQ("@test_cmdline-rest.rsp",  input.getValue()[2]);
+    EXPECT_EQ("--",                      input.getValue()[3]);
+    EXPECT_EQ("@c",                      input.getValue()[4]);
+}
+
+// ---------------------------------------------------------------------------
+TEST(CmdLine, ResponseFileQuoting)
+{
+    write_rspfile("test_cmdline-quoting.rsp",
+                  "\"with space\" C:\\dir\\file \"C:\\dir\\\\\" \"say \\\"hi\\\"\"\r\n\"\"\n");
+    CmdLine cmd("test", "", "Test of quoting in response files.", "", "");
+    PositionalArgs input("input", "Inputs.", false, "<arg>");
+    cmd.add(input);
+    vector<string> args;
+    args.push_back("test");
+    args.push_back("@test_cmdline-quoting.rsp");
+    cmd.parse(args);
+    remove("test_cmdline-quoting.rsp");
+    ASSERT_EQ(5u, input.getValue().size());
+    EXPECT_EQ("with space",      input.getValue()[0]);
+    EXPECT_EQ("C:\\dir\\file",   input.getValue()[1]);
+    EXPECT_EQ("C:\\dir\\",       input.getValue()[2]);
+    EXPECT_EQ("say \"hi\"",      input.getValue()[3]);
+    EXPECT_EQ("",                input.getValue()[4]);
+}
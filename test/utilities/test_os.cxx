@@ -37,6 +37,18 @@ TEST (os, getcwd)
     EXPECT_NE('/', wd[wd.size() - 1]) << "Working directory must not have trailing slash (/)";
 }
 
+// ---------------------------------------------------------------------------
+TEST (os, chdir)
+{
+    const string wd = os::getcwd();
+    ASSERT_TRUE(os::chdir(os::path::dirname(wd)));
+    EXPECT_EQ(os::path::dirname(wd), os::getcwd());
+    ASSERT_TRUE(os::chdir(wd));
+    EXPECT_EQ(wd, os::getcwd());
+    EXPECT_FALSE(os::chdir(wd + "/basis-os-test-nonexistent"));
+    EXPECT_EQ(wd, os::getcwd());
+}
+
 // ---------------------------------------------------------------------------
 TEST (os, exepath)
 {
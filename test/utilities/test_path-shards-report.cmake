@@ -0,0 +1,40 @@
+##############################################################################
+# @file  test_path-shards-report.cmake
+# @brief Compare XML report of test shards to the one of a serial test run.
+##############################################################################
+
+# ----------------------------------------------------------------------------
+# number of tests and of tests that were run listed in XML report
+function (get_test_counts TOTAL RUN XML_FILE)
+  file (READ "${XML_FILE}" XML)
+  if (NOT XML MATCHES "<testsuites tests=\"([0-9]+)\"")
+    message (FATAL_ERROR "Invalid test report ${XML_FILE}")
+  endif ()
+  set (${TOTAL} "${CMAKE_MATCH_1}" PARENT_SCOPE)
+  string (REGEX MATCHALL "<testcase [^>]*status=\"run\"" TESTCASES "${XML}")
+  list (LENGTH TESTCASES N)
+  set (${RUN} "${N}" PARENT_SCOPE)
+endfunction ()
+
+# ----------------------------------------------------------------------------
+# run tests serially and in parallel shards
+foreach (JOBS IN ITEMS 1 3)
+  set (XML_FILE "${OUTPUT_DIR}/test_path-shards-report-${JOBS}.xml")
+  file (REMOVE "${XML_FILE}")
+  execute_process (
+    COMMAND         "${EXECUTABLE}" "--basis_test_jobs=${JOBS}" "--gtest_output=xml:${XML_FILE}"
+    RESULT_VARIABLE RETVAL
+    OUTPUT_QUIET
+  )
+  if (NOT RETVAL EQUAL 0)
+    message (FATAL_ERROR "Test run with ${JOBS} job(s) failed with exit code ${RETVAL}")
+  endif ()
+  get_test_counts (TOTAL_${JOBS} RUN_${JOBS} "${XML_FILE}")
+endforeach ()
+
+# ----------------------------------------------------------------------------
+# compare test counts
+if (NOT TOTAL_3 EQUAL TOTAL_1 OR NOT RUN_3 EQUAL RUN_1 OR RUN_1 EQUAL 0)
+  message (FATAL_ERROR "Merged report of test shards lists ${TOTAL_3} tests of which ${RUN_3} were run,"
+                       " but serial report lists ${TOTAL_1} tests of which ${RUN_1} were run")
+endif ()
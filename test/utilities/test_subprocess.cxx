@@ -10,6 +10,14 @@
 
 #include <basis/basis.h>
 
+#include <cstdlib> // rand, srand
+#include <cstring> // strlen
+
+#if UNIX
+#  include <cstdio>   // tmpfile
+#  include <unistd.h> // sysconf, rmdir
+#endif
+
 
 using namespace std;
 using namespace basis;
@@ -17,6 +25,126 @@ using namespace basis;
 
 const string cCmd = exepath("basis.dummy_command");
 
+// ---------------------------------------------------------------------------
+// Previous implementation of Subprocess::split() used to test equivalence of
+// the current implementation. The out-of-range access when counting the
+// backslashes preceding a space at the start of the string is fixed.
+static Subprocess::CommandLine legacy_split(const string& cmd)
+{
+    const char whitespace[] = " \f\n\r\t\v";
+    static const char* olds[] = {"\\\\", "\\\"", "\xFF"};
+    static const char* news[] = {"\xFF", "\"",   "\\"};
+
+    Subprocess::CommandLine args;
+    string::size_type j;
+    string::size_type k;
+    unsigned int      n;
+
+    for (string::size_type i = 0; i < cmd.size(); i++) {
+        if (cmd[i] == '\"') {
+            j = i;
+            do {
+                j = cmd.find('\"', ++j);
+                if (j == string::npos) break;
+                k = j;
+                n = 0;
+                while (cmd[--k] == '\\') n++;
+            } while (n % 2);
+            if (j == string::npos) {
+                args.push_back(cmd.substr(i));
+                break;
+            } else {
+                args.push_back(cmd.substr(i + 1, j - i - 1));
+                i = j;
+            }
+        } else if (isspace(cmd[i])) {
+            j = cmd.find_first_not_of(whitespace, i);
+            i = j - 1;
+        } else {
+            j = i;
+            do {
+                j = cmd.find_first_of(whitespace, ++j);
+                if (j == string::npos) break;
+                k = j;
+                n = 0;
+                if (cmd[j] == ' ') {
+                    while (k > 0 && cmd[--k] == '\\') n++;
+                }
+            } while (n % 2);
+            if (j == string::npos) {
+                args.push_back(cmd.substr(i));
+                break;
+            } else {
+                args.push_back(cmd.substr(i, j - i));
+                i = j - 1;
+            }
+        }
+    }
+    for (size_t a = 0; a < args.size(); ++a) {
+        for (unsigned int m = 0; m < 3; m++) {
+            while ((j = args[a].find(olds[m])) != string::npos) {
+                args[a].replace(j, strlen(olds[m]), news[m]);
+            }
+        }
+    }
+    return args;
+}
+
+// ---------------------------------------------------------------------------
+// Previous implementation of Subprocess::tostring().
+static string legacy_tostring(const Subprocess::CommandLine& args)
+{
+    const char whitespace[] = " \f\n\r\t\v";
+
+    string cmd;
+    string arg;
+    string::size_type j;
+
+    for (Subprocess::CommandLine::const_iterator i = args.begin(); i != args.end(); ++i) {
+        if (!cmd.empty()) cmd.push_back(' ');
+        if (i->find_first_of(whitespace) != string::npos) {
+            arg = *i;
+            j = arg.find_first_of("\\\"");
+            while (j != string::npos) {
+                arg.insert(j, 1, '\\');
+                j = arg.find_first_of("\\\"", j + 2);
+            }
+            if (cmd.empty() || arg.find_first_of("' \t") != string::npos) {
+                cmd.push_back('\"');
+                cmd.append(arg);
+                cmd.push_back('\"');
+            }
+        } else {
+            cmd.append(*i);
+        }
+    }
+    return cmd;
+}
+
+// ---------------------------------------------------------------------------
+// Whether the previous implementation of Subprocess::tostring() converted
+// the given argument such that legacy_split() would return it unmodified.
+static bool legacy_roundtrips(const string& arg)
+{
+    if (arg.empty() || arg[0] == '\"') return false;
+    if (arg.find_first_of(" \t") != string::npos) return true;
+    if (arg.find_first_of("\f\n\r\v") != string::npos) return false;
+    return arg[arg.size() - 1] != '\\' && arg.find("\\\\") == string::npos
+                                       && arg.find("\\\"") == string::npos;
+}
+
+// ---------------------------------------------------------------------------
+// Random string of characters relevant to splitting a command-line.
+static string random_string(size_t maxlen)
+{
+    static const char chars[] = "ab '\"\\\\\t\n";
+    string str(static_cast<size_t>(rand()) % (maxlen + 1), ' ');
+    for (size_t i = 0; i < str.size(); ++i) {
+        str[i] = chars[rand() % (sizeof(chars) - 1)];
+    }
+    return str;
+}
+
 // ---------------------------------------------------------------------------
 TEST(Subprocess, Split)
 {
@@ -115,6 +243,66 @@ TEST(Subprocess, ToString)
 
 }
 
+// ---------------------------------------------------------------------------
+TEST(Subprocess, SplitEquivalence)
+{
+    srand(42);
+    for (int i = 0; i < 20000; ++i) {
+        const string cmd = random_string(40);
+        Subprocess::CommandLine expected = legacy_split(cmd);
+        Subprocess::CommandLine actual   = Subprocess::split(cmd);
+        ASSERT_EQ(expected.size(), actual.size()) << "Command: " << cmd;
+        for (size_t j = 0; j < expected.size(); ++j) {
+            ASSERT_EQ(expected[j], actual[j]) << "Command: " << cmd;
+        }
+    }
+}
+
+// ---------------------------------------------------------------------------
+TEST(Subprocess, ToStringEquivalence)
+{
+    srand(42);
+    for (int i = 0; i < 20000; ++i) {
+        Subprocess::CommandLine args(static_cast<size_t>(rand() % 5));
+        for (size_t j = 0; j < args.size(); ++j) {
+            do {
+                args[j] = random_string(10);
+            } while (!legacy_roundtrips(args[j]));
+        }
+        ASSERT_EQ(legacy_tostring(args), Subprocess::tostring(args));
+    }
+}
+
+// ---------------------------------------------------------------------------
+TEST(Subprocess, RoundTrip)
+{
+    srand(42);
+    for (int i = 0; i < 20000; ++i) {
+        Subprocess::CommandLine args(static_cast<size_t>(rand() % 5));
+        for (size_t j = 0; j < args.size(); ++j) {
+            args[j] = random_string(10);
+            if (rand() % 10 == 0) args[j] += "\xFF";
+        }
+        const string cmd = Subprocess::tostring(args);
+        Subprocess::CommandLine actual = Subprocess::split(cmd);
+        ASSERT_EQ(args.size(), actual.size()) << "Command: " << cmd;
+        for (size_t j = 0; j < args.size(); ++j) {
+            ASSERT_EQ(args[j], actual[j]) << "Command: " << cmd;
+        }
+    }
+    // arguments which were not preserved by the previous implementation
+    Subprocess::CommandLine args;
+    args.push_back("");
+    args.push_back("\"quoted\"");
+    args.push_back("trailing\\");
+    args.push_back("new\nline");
+    args.push_back("C:\\\\server\\share");
+    EXPECT_STREQ("\"\" \"\\\"quoted\\\"\" \"trailing\\\\\" \"new\nline\" \"C:\\\\\\\\server\\\\share\"",
+                 Subprocess::tostring(args).c_str());
+    Subprocess::CommandLine actual = Subprocess::split(Subprocess::tostring(args));
+    EXPECT_TRUE(args == actual);
+}
+
 // ---------------------------------------------------------------------------
 TEST(Subprocess, Popen)
 {
@@ -182,3 +370,251 @@ TEST(Subprocess, Call)
 {
     EXPECT_EQ(0, Subprocess::call(cCmd));
 }
+
+// ---------------------------------------------------------------------------
+TEST(Pipeline, Communicate)
+{
+    Pipeline p;
+    p | (cCmd + " --greet") | (cCmd + " --cat") | (cCmd + " --cat");
+    ASSERT_EQ(3u, p.size());
+    ostringstream out;
+    EXPECT_TRUE(p.popen(Subprocess::RM_NONE, Subprocess::RM_PIPE));
+    EXPECT_TRUE(p.communicate(out));
+    EXPECT_TRUE(p.poll());
+    EXPECT_EQ(0, p.returncode());
+    EXPECT_STREQ("Hello, BASIS!\n", out.str().c_str());
+}
+
+// ---------------------------------------------------------------------------
+// An intermediate stage writing more to stderr than fits into a pipe must not
+// block the pipeline while stdout of the last stage is read.
+TEST(Pipeline, CommunicateStderr)
+{
+    const size_t n = 1024 * 1024;
+    ostringstream warn;
+    warn << cCmd << " --warn-bytes " << n << " --greet";
+    Pipeline p;
+    p | warn.str() | (cCmd + " --cat");
+    ostringstream out, err;
+    EXPECT_TRUE(p.popen(Subprocess::RM_NONE, Subprocess::RM_PIPE, Subprocess::RM_PIPE));
+    EXPECT_TRUE(p.communicate(out, err));
+    EXPECT_EQ(0, p[0].returncode());
+    EXPECT_EQ(0, p.returncode());
+    EXPECT_STREQ("Hello, BASIS!\n", out.str().c_str());
+    EXPECT_EQ(n, err.str().size());
+    // stderr is discarded when only stdout is requested
+    out.str("");
+    EXPECT_TRUE(p.popen(Subprocess::RM_NONE, Subprocess::RM_PIPE, Subprocess::RM_PIPE));
+    EXPECT_TRUE(p.communicate(out));
+    EXPECT_EQ(0, p[0].returncode());
+    EXPECT_STREQ("Hello, BASIS!\n", out.str().c_str());
+}
+
+// ---------------------------------------------------------------------------
+TEST(Pipeline, ReturnCode)
+{
+    Pipeline p;
+    p | (cCmd + " --greet") | (cCmd + " --exit 42");
+    EXPECT_TRUE(p.popen());
+    EXPECT_TRUE(p.wait());
+    EXPECT_EQ(0,  p[0].returncode());
+    EXPECT_EQ(42, p.returncode());
+}
+
+#if UNIX
+// ---------------------------------------------------------------------------
+TEST(Pipeline, Splice)
+{
+    FILE* file = tmpfile();
+    ASSERT_TRUE(file != NULL);
+    Pipeline p;
+    p | (cCmd + " --greet") | (cCmd + " --cat");
+    EXPECT_TRUE(p.popen(Subprocess::RM_NONE, Subprocess::RM_PIPE));
+    EXPECT_TRUE(p.back().splice(fileno(file)));
+    EXPECT_TRUE(p.wait());
+    char buf[32] = {0};
+    rewind(file);
+    EXPECT_EQ(14u, fread(buf, 1, sizeof(buf) - 1, file));
+    EXPECT_STREQ("Hello, BASIS!\n", buf);
+    fclose(file);
+}
+
+// ---------------------------------------------------------------------------
+TEST(Pipeline, Tee)
+{
+    FILE* file = tmpfile();
+    ASSERT_TRUE(file != NULL);
+    int fds[2];
+    ASSERT_EQ(0, pipe(fds));
+    Subprocess p;
+    EXPECT_TRUE(p.popen(cCmd + " --greet", Subprocess::RM_NONE, Subprocess::RM_PIPE));
+    EXPECT_TRUE(p.tee(fds[1], fileno(file)));
+    EXPECT_TRUE(p.wait());
+    close(fds[1]);
+    char buf[32] = {0};
+    EXPECT_EQ(14, ::read(fds[0], buf, sizeof(buf) - 1));
+    EXPECT_STREQ("Hello, BASIS!\n", buf);
+    close(fds[0]);
+    memset(buf, 0, sizeof(buf));
+    rewind(file);
+    EXPECT_EQ(14u, fread(buf, 1, sizeof(buf) - 1, file));
+    EXPECT_STREQ("Hello, BASIS!\n", buf);
+    fclose(file);
+}
+#endif
+
+// ---------------------------------------------------------------------------
+// records output passed on by SubprocessMonitor
+struct OutputRecorder : public SubprocessMonitor::Handler
+{
+    vector<string> out;
+    vector<string> err;
+    int            finished_count;
+
+    OutputRecorder() : finished_count(0) {}
+
+    void output(Subprocess&, const char* data, size_t n, bool stderr_data)
+    {
+        (stderr_data ? err : out).push_back(string(data, n));
+    }
+
+    void finished(Subprocess& p)
+    {
+        EXPECT_FALSE(p.signaled());
+        finished_count++;
+    }
+};
+
+// ---------------------------------------------------------------------------
+TEST(SubprocessMonitor, Lines)
+{
+    Subprocess p1, p2;
+    EXPECT_TRUE(p1.popen(cCmd + " --greet --greet", Subprocess::RM_NONE, Subprocess::RM_PIPE, Subprocess::RM_PIPE));
+    EXPECT_TRUE(p2.popen(cCmd + " --warn --exit 3",  Subprocess::RM_NONE, Subprocess::RM_PIPE, Subprocess::RM_PIPE));
+    OutputRecorder r1, r2;
+    SubprocessMonitor monitor;
+    monitor.add(p1, r1);
+    monitor.add(p2, r2);
+    EXPECT_EQ(2u, monitor.size());
+    monitor.run();
+    EXPECT_EQ(0u, monitor.size());
+    ASSERT_EQ(2u, r1.out.size());
+    EXPECT_STREQ("Hello, BASIS!\n", r1.out[0].c_str());
+    EXPECT_STREQ("Hello, BASIS!\n", r1.out[1].c_str());
+    EXPECT_EQ(0u, r1.err.size());
+    EXPECT_EQ(0u, r2.out.size());
+    ASSERT_EQ(1u, r2.err.size());
+    EXPECT_STREQ("WARNING: Cannot greet in other languages!\n", r2.err[0].c_str());
+    EXPECT_EQ(1, r1.finished_count);
+    EXPECT_EQ(1, r2.finished_count);
+    EXPECT_EQ(0, p1.returncode());
+    EXPECT_EQ(3, p2.returncode());
+}
+
+// ---------------------------------------------------------------------------
+TEST(SubprocessMonitor, Chunks)
+{
+    Subprocess p;
+    EXPECT_TRUE(p.popen(cCmd + " --greet", Subprocess::RM_NONE, Subprocess::RM_PIPE));
+    OutputRecorder r;
+    SubprocessMonitor monitor;
+    monitor.add(p, r, SubprocessMonitor::CHUNKS);
+    while (monitor.run_once(1000)) {}
+    string out;
+    for (size_t i = 0; i < r.out.size(); ++i) out += r.out[i];
+    EXPECT_STREQ("Hello, BASIS!\n", out.c_str());
+    EXPECT_EQ(1, r.finished_count);
+}
+
+// ---------------------------------------------------------------------------
+TEST(Subprocess, RedirectToFile)
+{
+    const string fname = "test_subprocess_redirect.txt";
+    Subprocess p;
+    p.stdout_file(fname);
+    EXPECT_TRUE(p.popen(cCmd + " --greet", Subprocess::RM_NONE, Subprocess::RM_FILE));
+    EXPECT_TRUE(p.wait());
+    EXPECT_EQ(0, p.returncode());
+    p.stdout_file(fname, true);
+    EXPECT_TRUE(p.popen(cCmd + " --warn", Subprocess::RM_NONE, Subprocess::RM_FILE, Subprocess::RM_STDOUT));
+    EXPECT_TRUE(p.wait());
+    // read file back using it as input of subprocess
+    ostringstream out;
+    p.stdin_file(fname);
+    EXPECT_TRUE(p.popen(cCmd + " --cat", Subprocess::RM_FILE, Subprocess::RM_PIPE));
+    EXPECT_TRUE(p.communicate(out));
+    EXPECT_STREQ("Hello, BASIS!\nWARNING: Cannot greet in other languages!\n", out.str().c_str());
+    remove(fname.c_str());
+    // missing input file
+    p.stdin_file(fname);
+    EXPECT_FALSE(p.popen(cCmd + " --cat", Subprocess::RM_FILE));
+}
+
+// ---------------------------------------------------------------------------
+TEST(Subprocess, RedirectToDevNull)
+{
+    Subprocess p;
+    ostringstream out;
+    EXPECT_TRUE(p.popen(cCmd + " --greet --cat", Subprocess::RM_DEVNULL, Subprocess::RM_PIPE, Subprocess::RM_DEVNULL));
+    EXPECT_TRUE(p.communicate(out));
+    EXPECT_STREQ("Hello, BASIS!\n", out.str().c_str());
+    EXPECT_TRUE(p.popen(cCmd + " --greet --warn", Subprocess::RM_NONE, Subprocess::RM_DEVNULL, Subprocess::RM_PIPE));
+    ostringstream err;
+    EXPECT_TRUE(p.communicate(out, err));
+    EXPECT_STREQ("WARNING: Cannot greet in other languages!\n", err.str().c_str());
+}
+
+// ---------------------------------------------------------------------------
+// Backslashes in arguments reach the child process unmodified, including
+// on Windows where the command-line string is parsed by the C runtime.
+TEST(Subprocess, ExecuteWindowsPaths)
+{
+    Subprocess::CommandLine args;
+    args.push_back("basis.print_args");
+    args.push_back("\\\\server\\share dir");
+    args.push_back("C:\\Program Files\\");
+    args.push_back("\\\\server\\share\\file.txt");
+    args.push_back("a\\\"b c");
+    ostringstream out;
+    EXPECT_EQ(0, execute(args, true, &out));
+    ostringstream expected;
+    expected << (args.size() - 1) << '\n';
+    for (size_t i = 1; i < args.size(); ++i) expected << args[i] << '\n';
+    EXPECT_EQ(expected.str(), out.str());
+}
+
+#if UNIX
+// ---------------------------------------------------------------------------
+TEST(Subprocess, ExecuteResponseFile)
+{
+    // direct response file to new temporary directory to check its removal
+    const char* tmpdir = getenv("TMPDIR");
+    const string oldtmpdir = tmpdir ? tmpdir : "";
+    string tmpl = (oldtmpdir.empty() ? string("/tmp") : oldtmpdir) + "/test_subprocess-XXXXXX";
+    vector<char> dirname(tmpl.begin(), tmpl.end());
+    dirname.push_back('\0');
+    ASSERT_TRUE(mkdtemp(&dirname[0]) != NULL);
+    setenv("TMPDIR", &dirname[0], 1);
+    // one argument exceeding the maximum length of the command-line
+    size_t n = 32 * 4096;
+    long arg_max = sysconf(_SC_ARG_MAX);
+    if (arg_max > 0 && arg_max < (1L << 24) && static_cast<size_t>(arg_max) > n) n = arg_max;
+    Subprocess::CommandLine args;
+    args.push_back("basis.print_args");
+    args.push_back("with space");
+    args.push_back("C:\\dir\\");
+    args.push_back("\"quoted\"");
+    args.push_back(string(n, 'x'));
+    ostringstream out;
+    EXPECT_EQ(0, execute(args, true, &out, false, 0, false, true));
+    // restore environment and check that response file was removed
+    if (oldtmpdir.empty()) unsetenv("TMPDIR");
+    else setenv("TMPDIR", oldtmpdir.c_str(), 1);
+    EXPECT_EQ(0, rmdir(&dirname[0])) << "Response file not removed from " << &dirname[0];
+    // arguments as parsed by the executable
+    ostringstream expected;
+    expected << (args.size() - 1) << '\n';
+    for (size_t i = 1; i < args.size(); ++i) expected << args[i] << '\n';
+    EXPECT_TRUE(expected.str() == out.str()) << "Output: " << out.str().substr(0, 200);
+}
+#endif
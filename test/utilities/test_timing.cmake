@@ -0,0 +1,33 @@
+##############################################################################
+# @file  test_timing.cmake
+# @brief Test comparison of test timings to a baseline by test_main.
+##############################################################################
+
+set (TIMING_FILE "${OUTPUT_DIR}/${TEST_NAME}.json")
+file (REMOVE "${TIMING_FILE}")
+
+execute_process (
+  COMMAND         "${EXECUTABLE}" --basis_test_jobs=2
+                                  "--basis_test_timing=${TIMING_FILE}"
+                                  "--basis_test_baseline=${BASELINE}"
+  RESULT_VARIABLE RETVAL
+  OUTPUT_VARIABLE OUTPUT
+)
+if (NOT RETVAL EQUAL 0)
+  message (FATAL_ERROR "Test run failed with exit code ${RETVAL}:\n${OUTPUT}")
+endif ()
+if (NOT EXISTS "${TIMING_FILE}")
+  message (FATAL_ERROR "Test timings not written to ${TIMING_FILE}")
+endif ()
+if (NOT OUTPUT MATCHES "<DartMeasurement name=\"Peak RSS\" type=\"numeric/integer\">[1-9]")
+  message (FATAL_ERROR "Peak RSS of test shards not reported:\n${OUTPUT}")
+endif ()
+if (NOT OUTPUT MATCHES "<DartMeasurement name=\"Performance Regressions\" type=\"numeric/integer\">([0-9]+)<")
+  message (FATAL_ERROR "Number of performance regressions not reported:\n${OUTPUT}")
+endif ()
+set (REGRESSIONS "${CMAKE_MATCH_1}")
+if (EXPECT_REGRESSION AND REGRESSIONS EQUAL 0)
+  message (FATAL_ERROR "Expected performance regression compared to baseline ${BASELINE}:\n${OUTPUT}")
+elseif (NOT EXPECT_REGRESSION AND NOT REGRESSIONS EQUAL 0)
+  message (FATAL_ERROR "Unexpected performance regression compared to baseline ${BASELINE}:\n${OUTPUT}")
+endif ()
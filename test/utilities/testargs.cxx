@@ -0,0 +1,21 @@
+/**
+ * @file  testargs.cxx
+ * @brief Test of arguments passed on to a test by the test driver.
+ *
+ * The first argument is the number of arguments expected to follow it.
+ */
+
+#include <cstdlib>
+#include <iostream>
+
+
+// ---------------------------------------------------------------------------
+int testargs(int argc, char* argv[])
+{
+    const int n = (argc > 1 ? atoi(argv[1]) + 2 : 1);
+    if (argc != n) {
+        std::cerr << "Expected " << n << " arguments, got " << argc << std::endl;
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,19 @@
+/**
+ * @file  testcwd.cxx
+ * @brief Test of working directory in which test driver runs a test.
+ *
+ * When given an argument, the test fails unless the name of the current
+ * working directory equals this argument.
+ */
+
+#include <basis/os.h>
+#include <basis/os/path.h>
+
+
+// ---------------------------------------------------------------------------
+int testcwd(int argc, char* argv[])
+{
+    const std::string wd = basis::os::getcwd();
+    if (argc > 1 && basis::os::path::basename(wd) != argv[1]) return 1;
+    return 0;
+}